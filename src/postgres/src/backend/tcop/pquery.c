@@ -1256,6 +1256,15 @@ PortalRunMulti(Portal portal,
 		{
 			PlannedStmt *pstmt = linitial_node(PlannedStmt, portal->stmts);
 			is_single_row_modify_txn = YBCIsSingleRowModify(pstmt);
+			/*
+			 * Writes of a multi-row modification executed as a whole transaction
+			 * are kept buffered until the end of the statement and flushed as the
+			 * last writes of the transaction. They may be applied without
+			 * distributed transaction when all of them go to one tablet.
+			 */
+			if (!is_single_row_modify_txn && pstmt->utilityStmt == NULL &&
+				pstmt->commandType != CMD_SELECT)
+				YBCPgHoldBufferedOperationsUntilStatementEnd();
 		}
 	}
 
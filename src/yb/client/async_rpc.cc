@@ -456,6 +456,14 @@ void HandleExtraFields(YBqlReadOp* op, tserver::ReadRequestPB* req) {
   if (op->read_time()) {
     op->read_time().AddToPB(req);
   }
+  if (op->max_staleness() &&
+      op->yb_consistency_level() == YBConsistencyLevel::CONSISTENT_PREFIX) {
+    // Ops batched into one RPC share the most strict bound.
+    auto max_staleness_ms = std::max<uint64_t>(op->max_staleness().ToMilliseconds(), 1);
+    if (!req->max_staleness_ms() || max_staleness_ms < req->max_staleness_ms()) {
+      req->set_max_staleness_ms(max_staleness_ms);
+    }
+  }
 }
 
 template <class OpType, class Req, class Out>
@@ -663,6 +671,9 @@ ReadRpc::ReadRpc(const AsyncRpcData& data, YBConsistencyLevel yb_consistency_lev
       LOG(DFATAL) << "Unsupported table type: " << table()->ToString();
       break;
   }
+  if (req_.max_staleness_ms()) {
+    tablet_invoker_.set_max_staleness(MonoDelta::FromMilliseconds(req_.max_staleness_ms()));
+  }
 
   VLOG(3) << "Created batch for " << data.tablet->tablet_id() << ":\n"
           << req_.ShortDebugString();
@@ -689,11 +700,25 @@ void ReadRpc::CallRemoteMethod() {
   TRACE_TO(trace, "SendRpcToTserver");
   ADOPT_TRACE(trace.get());
 
-  tablet_invoker_.ReadAsync(req_, &resp_, PrepareController(),
-                            std::bind(&ReadRpc::Finished, this, Status::OK()));
+  tablet_invoker_.ReadAsync(req_, &resp_, PrepareController(), [this] {
+    UpdateSafeTimeLag();
+    Finished(Status::OK());
+  });
   TRACE_TO(trace, "RpcDispatched Asynchronously");
 }
 
+void ReadRpc::UpdateSafeTimeLag() {
+  // Safe time is reported also when a follower rejects the read as too stale, so the replica is
+  // not selected for bounded staleness reads until it catches up.
+  if (!resp_.has_safe_time() || !resp_.has_propagated_hybrid_time()) {
+    return;
+  }
+  auto lag_us = HybridTime(resp_.propagated_hybrid_time()).PhysicalDiff(
+      HybridTime(resp_.safe_time()));
+  tablet_invoker_.tablet()->UpdateSafeTimeLag(
+      &tablet_invoker_.current_ts(), MonoDelta::FromMicroseconds(std::max<int64_t>(lag_us, 0)));
+}
+
 void ReadRpc::SwapResponses() {
   int redis_idx = 0;
   int ql_idx = 0;
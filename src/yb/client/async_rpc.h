@@ -189,6 +189,9 @@ class ReadRpc : public AsyncRpcBase<tserver::ReadRequestPB, tserver::ReadRespons
   void SwapResponses() override;
   void CallRemoteMethod() override;
   void NotifyBatcher(const Status& status) override;
+
+  // Remembers safe time lag reported by the replica that handled this read.
+  void UpdateSafeTimeLag();
 };
 
 }  // namespace internal
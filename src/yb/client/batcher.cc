@@ -138,6 +138,9 @@ Batcher::Batcher(YBClient* client,
 }
 
 Batcher::~Batcher() {
+  if (seal_transaction_callback_) {
+    seal_transaction_callback_(STATUS(IllegalState, "Transaction was not sealed"));
+  }
   LOG_IF_WITH_PREFIX(DFATAL, outstanding_rpcs_ != 0)
       << "Destroying batcher with running rpcs: " << outstanding_rpcs_;
   CHECK(
@@ -444,6 +447,13 @@ void Batcher::AllLookupsDone() {
     return lhs.tablet.get() < rhs.tablet.get();
   });
 
+  if (require_single_tablet_ && ops_queue_.front().tablet != ops_queue_.back().tablet) {
+    Abort(STATUS_FORMAT(
+        TryAgain, "Operations required to belong to a single tablet span tablets $0 and $1",
+        ops_queue_.front().tablet->tablet_id(), ops_queue_.back().tablet->tablet_id()));
+    return;
+  }
+
   auto group_start = ops_queue_.begin();
   auto current_group = (*group_start).yb_op->group();
   const auto* current_tablet = (*group_start).tablet.get();
@@ -526,6 +536,16 @@ void Batcher::ExecuteOperations(Initial initial) {
         self, group.begin->tablet.get(), group, allow_local_calls, need_consistent_read));
   }
 
+  if (seal_transaction_callback_ && transaction && error_collector_.CountErrors() == 0) {
+    // All operations were prepared by the transaction, so the seal record will contain every
+    // batch sent below. Operations whose lookup failed would never be reported as flushed to the
+    // transaction, so sealing is not started in this case.
+    VLOG_WITH_PREFIX_AND_FUNC(3) << "Seal transaction " << transaction->id();
+    transaction_sealed_ = true;
+    transaction->Commit(deadline_, SealOnly::kTrue, std::move(seal_transaction_callback_));
+    seal_transaction_callback_ = nullptr;
+  }
+
   outstanding_rpcs_.store(rpcs.size());
   for (const auto& rpc : rpcs) {
     if (transaction) {
@@ -614,7 +634,8 @@ void Batcher::Flushed(
     const InFlightOps& ops, const Status& status, FlushExtraResult flush_extra_result) {
   auto transaction = this->transaction();
   if (transaction) {
-    const auto ops_will_be_retried = !status.ok() && ShouldSessionRetryError(status);
+    const auto ops_will_be_retried =
+        !status.ok() && !transaction_sealed_ && ShouldSessionRetryError(status);
     if (!ops_will_be_retried) {
       // We don't call Transaction::Flushed for ops that will be retried within the same
       // transaction in order to keep transaction running until we finally retry all operations
@@ -212,6 +212,23 @@ class Batcher : public Runnable, public std::enable_shared_from_this<Batcher> {
     force_consistent_read_ = value;
   }
 
+  void SetRequireSingleTablet(RequireSingleTablet value) {
+    require_single_tablet_ = value;
+  }
+
+  // Seal the transaction right after operations of this batch are prepared, so the seal record is
+  // replicated in parallel with them. The callback is invoked exactly once: with the commit status
+  // when the transaction was sealed, or with IllegalState when sealing was not started.
+  void SetSealTransactionCallback(CommitCallback callback) {
+    seal_transaction_callback_ = std::move(callback);
+  }
+
+  // Whether this batch has sealed its transaction. Operations of such a batch are not retried,
+  // since the seal record already lists the batches the transaction consists of.
+  bool transaction_sealed() const {
+    return transaction_sealed_;
+  }
+
   YBTransactionPtr transaction() const;
 
   const InFlightOpsGroupsWithMetadata& in_flight_ops() const { return ops_info_; }
@@ -330,6 +347,12 @@ class Batcher : public Runnable, public std::enable_shared_from_this<Batcher> {
   // Force consistent read on transactional table, even we have only single shard commands.
   ForceConsistentRead force_consistent_read_;
 
+  // Abort the batch instead of sending it when operations belong to more than one tablet.
+  RequireSingleTablet require_single_tablet_ = RequireSingleTablet::kFalse;
+
+  CommitCallback seal_transaction_callback_;
+  bool transaction_sealed_ = false;
+
   RejectionScoreSourcePtr rejection_score_source_;
 
   DISALLOW_COPY_AND_ASSIGN(Batcher);
@@ -100,6 +100,12 @@ DEFINE_test_flag(bool, verify_all_replicas_alive, false,
 DEFINE_int32(retry_failed_replica_ms, 60 * 1000,
              "Time in milliseconds to wait for before retrying a failed replica");
 
+DEFINE_int32(stale_replica_recheck_interval_ms, 1000,
+             "Replica that reported safe time lag exceeding the staleness bound of a read is not "
+             "used for bounded staleness reads during this interval.");
+TAG_FLAG(stale_replica_recheck_interval_ms, advanced);
+TAG_FLAG(stale_replica_recheck_interval_ms, runtime);
+
 DEFINE_int64(meta_cache_lookup_throttling_step_ms, 5,
              "Step to increment delay between calls during lookup throttling.");
 
@@ -616,6 +622,33 @@ void RemoteTablet::MarkTServerAsFollower(const RemoteTabletServer* server) {
                 << server->ToString() << ". Replicas: " << ReplicasAsStringUnlocked();
 }
 
+void RemoteTablet::UpdateSafeTimeLag(const RemoteTabletServer* server, MonoDelta lag) {
+  std::lock_guard<rw_spinlock> lock(mutex_);
+  for (RemoteReplica& replica : replicas_) {
+    if (replica.ts == server) {
+      replica.safe_time_lag = lag;
+      replica.safe_time_lag_update_time = MonoTime::Now();
+      return;
+    }
+  }
+}
+
+std::set<std::string> RemoteTablet::GetReplicasStalerThan(MonoDelta max_staleness) const {
+  std::set<std::string> result;
+  const auto recheck_interval = MonoDelta::FromMilliseconds(
+      GetAtomicFlag(&FLAGS_stale_replica_recheck_interval_ms));
+  const auto now = MonoTime::Now();
+  SharedLock<rw_spinlock> lock(mutex_);
+  for (const RemoteReplica& replica : replicas_) {
+    if (replica.safe_time_lag_update_time.Initialized() &&
+        now - replica.safe_time_lag_update_time < recheck_interval &&
+        replica.safe_time_lag > max_staleness) {
+      result.insert(replica.ts->permanent_uuid());
+    }
+  }
+  return result;
+}
+
 std::string RemoteTablet::ReplicasAsString() const {
   SharedLock<rw_spinlock> lock(mutex_);
   return ReplicasAsStringUnlocked();
@@ -33,6 +33,7 @@
 #ifndef YB_CLIENT_META_CACHE_H
 #define YB_CLIENT_META_CACHE_H
 
+#include <set>
 #include <shared_mutex>
 #include <map>
 #include <string>
@@ -166,6 +167,10 @@ struct RemoteReplica {
   MonoTime last_failed_time = MonoTime::kUninitialized;
   // The state of this replica. Only updated after calling GetTabletStatus.
   tablet::RaftGroupStatePB state = tablet::RaftGroupStatePB::UNKNOWN;
+  // How far safe time of this replica was behind its clock, as reported by the last
+  // CONSISTENT_PREFIX read served by it.
+  MonoDelta safe_time_lag;
+  MonoTime safe_time_lag_update_time;
 
   RemoteReplica(RemoteTabletServer* ts_, PeerRole role_)
       : ts(ts_), role(role_) {}
@@ -325,6 +330,13 @@ class RemoteTablet : public RefCountedThreadSafe<RemoteTablet> {
   // Mark the specified tablet server as a follower in the cache.
   void MarkTServerAsFollower(const RemoteTabletServer* server);
 
+  // Remembers safe time lag reported by the replica hosted by 'server'.
+  void UpdateSafeTimeLag(const RemoteTabletServer* server, MonoDelta lag);
+
+  // Returns uuids of tablet servers hosting replicas that recently reported safe time lag greater
+  // than 'max_staleness', so they should not serve bounded staleness reads.
+  std::set<std::string> GetReplicasStalerThan(MonoDelta max_staleness) const;
+
   // Return stringified representation of the list of replicas for this tablet.
   std::string ReplicasAsString() const;
 
@@ -20,6 +20,7 @@
 
 #include "yb/client/client-test-util.h"
 #include "yb/client/error.h"
+#include "yb/client/meta_cache.h"
 #include "yb/client/ql-dml-test-base.h"
 #include "yb/client/schema.h"
 #include "yb/client/session.h"
@@ -30,6 +31,7 @@
 #include "yb/common/ql_type.h"
 #include "yb/common/ql_value.h"
 #include "yb/common/schema.h"
+#include "yb/common/wire_protocol.h"
 
 #include "yb/consensus/consensus.h"
 #include "yb/consensus/consensus.pb.h"
@@ -55,9 +57,11 @@
 
 #include "yb/server/skewed_clock.h"
 
+#include "yb/tablet/mvcc.h"
 #include "yb/tablet/tablet.h"
 #include "yb/tablet/tablet_bootstrap_if.h"
 #include "yb/tablet/tablet_metadata.h"
+#include "yb/tablet/tablet_metrics.h"
 #include "yb/tablet/tablet_peer.h"
 #include "yb/tablet/tablet_retention_policy.h"
 
@@ -66,11 +70,14 @@
 #include "yb/tserver/ts_tablet_manager.h"
 #include "yb/tserver/tserver_service.proxy.h"
 
+#include "yb/util/async_util.h"
+#include "yb/util/atomic.h"
 #include "yb/util/random_util.h"
 #include "yb/util/range.h"
 #include "yb/util/shared_lock.h"
 #include "yb/util/status_format.h"
 #include "yb/util/stopwatch.h"
+#include "yb/util/test_thread_holder.h"
 #include "yb/util/tsan_util.h"
 
 #include "yb/yql/cql/ql/util/statement_result.h"
@@ -84,6 +91,7 @@ DECLARE_string(time_source);
 DECLARE_int32(TEST_delay_execute_async_ms);
 DECLARE_int32(retryable_request_timeout_secs);
 DECLARE_bool(enable_lease_revocation);
+DECLARE_bool(enable_leader_lease_transfer);
 DECLARE_bool(rocksdb_disable_compactions);
 DECLARE_int32(rocksdb_level0_slowdown_writes_trigger);
 DECLARE_int32(rocksdb_level0_stop_writes_trigger);
@@ -103,10 +111,18 @@ DECLARE_int32(timestamp_history_retention_interval_sec);
 DECLARE_int32(raft_heartbeat_interval_ms);
 DECLARE_int32(history_cutoff_propagation_interval_ms);
 DECLARE_int32(TEST_preparer_batch_inject_latency_ms);
+DECLARE_int32(preparer_batch_coalescing_window_us);
 DECLARE_double(leader_failure_max_missed_heartbeat_periods);
 DECLARE_int32(TEST_backfill_sabotage_frequency);
 DECLARE_string(regular_tablets_data_block_key_value_encoding);
 DECLARE_string(compression_type);
+DECLARE_int32(stale_replica_recheck_interval_ms);
+DECLARE_bool(enable_load_balancing);
+DECLARE_int32(follower_unavailable_considered_failed_sec);
+DECLARE_int32(raft_quiescence_idle_heartbeats);
+
+METRIC_DECLARE_counter(preparer_replicated_batches);
+METRIC_DECLARE_counter(preparer_coalesced_operations);
 
 namespace yb {
 namespace client {
@@ -1558,6 +1574,49 @@ TEST_F(QLTabletTest, SlowPrepare) {
   workload.StopAndJoin();
 }
 
+// Concurrent writes should be coalesced into preparer batches without losing any of them, also
+// across leader changes.
+TEST_F(QLTabletTest, CoalescePreparerBatches) {
+  FLAGS_preparer_batch_coalescing_window_us = 500;
+
+  TestWorkload workload(cluster_.get());
+  workload.set_table_name(kTable1Name);
+  workload.set_write_timeout_millis(30000 * kTimeMultiplier);
+  workload.set_num_tablets(1);
+  workload.set_num_write_threads(8);
+  workload.set_write_batch_size(1);
+  workload.Setup();
+  workload.Start();
+
+  std::this_thread::sleep_for(2s);
+  StepDownAllTablets(cluster_.get());
+  std::this_thread::sleep_for(2s);
+
+  workload.StopAndJoin();
+  ASSERT_GT(workload.rows_inserted(), 0);
+
+  TableHandle table;
+  ASSERT_OK(table.Open(kTable1Name, client_.get()));
+  // Writes that timed out during leader change could still be applied.
+  ASSERT_GE(CountTableRows(table), workload.rows_inserted());
+
+  // Each tablet peer has its own metric entity, so sum over all of them to account for every
+  // leader that the tablet had.
+  int64_t replicated_batches = 0;
+  int64_t coalesced_operations = 0;
+  for (const auto& peer : ListTableTabletPeers(cluster_.get(), table->id())) {
+    const auto& metric_entity = peer->tablet()->GetTabletMetricsEntity();
+    replicated_batches += METRIC_preparer_replicated_batches.Instantiate(metric_entity)->value();
+    coalesced_operations +=
+        METRIC_preparer_coalesced_operations.Instantiate(metric_entity)->value();
+  }
+  LOG(INFO) << "Rows inserted: " << workload.rows_inserted()
+            << ", replicated batches: " << replicated_batches
+            << ", coalesced operations: " << coalesced_operations;
+  ASSERT_GT(coalesced_operations, 0);
+  ASSERT_LT(replicated_batches, workload.rows_inserted());
+}
+
 TEST_F(QLTabletTest, ElectUnsynchronizedFollower) {
   TableHandle table;
   CreateTable(kTable1Name, &table, 1);
@@ -1737,5 +1796,431 @@ TEST_F_EX(QLTabletTest, CompactDeletedColumn, QLTabletRf1Test) {
   ASSERT_LE(new_files_size * 2, files_size);
 }
 
+// Follower, whose safe time lags behind its clock more than requested, rejects bounded staleness
+// read and reports its safe time, so the client could avoid it.
+TEST_F(QLTabletTest, BoundedStalenessFollowerRead) {
+  // Keep followers from electing a new leader, so their safe time does not advance.
+  FLAGS_leader_failure_max_missed_heartbeat_periods = 10000;
+
+  TableHandle table;
+  CreateTable(kTable1Name, &table, 1);
+  auto session = CreateSession();
+  SetValue(session, 1, -1, table);
+
+  auto leader_idx = ASSERT_RESULT(ServerWithLeaders(cluster_.get()));
+  auto* follower = cluster_->mini_tablet_server((leader_idx + 1) % 3);
+  auto peers = follower->server()->tablet_manager()->GetTabletPeers();
+  ASSERT_EQ(peers.size(), 1);
+  const auto tablet_id = peers.front()->tablet_id();
+
+  cluster_->mini_tablet_server(leader_idx)->Shutdown();
+  constexpr auto kStaleness = 500ms;
+  SleepFor(kStaleness * 2);
+
+  auto endpoint = follower->server()->rpc_server()->GetBoundAddresses().front();
+  tserver::TabletServerServiceProxy proxy(
+      &follower->server()->proxy_cache(), HostPort::FromBoundEndpoint(endpoint));
+  auto read = [&](std::chrono::milliseconds max_staleness, tserver::ReadResponsePB* resp) {
+    tserver::ReadRequestPB req;
+    req.set_tablet_id(tablet_id);
+    req.set_consistency_level(YBConsistencyLevel::CONSISTENT_PREFIX);
+    req.set_max_staleness_ms(max_staleness.count());
+    auto op = CreateReadOp(1, table);
+    std::string partition_key;
+    RETURN_NOT_OK(op->GetPartitionKey(&partition_key));
+    auto* ql_batch = req.add_ql_batch();
+    *ql_batch = op->request();
+    const auto hash_code = PartitionSchema::DecodeMultiColumnHashValue(partition_key);
+    ql_batch->set_hash_code(hash_code);
+    ql_batch->set_max_hash_code(hash_code);
+
+    rpc::RpcController controller;
+    controller.set_timeout(10s);
+    return proxy.Read(req, resp, &controller);
+  };
+
+  tserver::ReadResponsePB resp;
+  ASSERT_OK(read(kStaleness, &resp));
+  ASSERT_TRUE(resp.has_error());
+  ASSERT_TRUE(StatusFromPB(resp.error().status()).IsIllegalState())
+      << resp.error().ShortDebugString();
+  ASSERT_EQ(resp.error().code(), tserver::TabletServerErrorPB::STALE_FOLLOWER)
+      << resp.error().ShortDebugString();
+  ASSERT_TRUE(resp.has_safe_time());
+  ASSERT_GE(HybridTime(resp.propagated_hybrid_time()).PhysicalDiff(HybridTime(resp.safe_time())),
+            ToMicroseconds(kStaleness));
+
+  resp.Clear();
+  ASSERT_OK(read(1min, &resp));
+  ASSERT_FALSE(resp.has_error()) << resp.error().ShortDebugString();
+  ASSERT_EQ(resp.ql_batch(0).status(), QLResponsePB::YQL_STATUS_OK);
+  ASSERT_TRUE(resp.has_safe_time());
+
+  ASSERT_OK(cluster_->mini_tablet_server(leader_idx)->Start());
+}
+
+// Bounded staleness reads do not use replicas that reported safe time lag above the bound, and go
+// to the leader when there are no other replicas.
+TEST_F(QLTabletTest, BoundedStalenessReadAvoidsStaleReplicas) {
+  FLAGS_stale_replica_recheck_interval_ms = 60000;
+
+  TableHandle table;
+  CreateTable(kTable1Name, &table, 1);
+  auto session = CreateSession();
+  SetValue(session, 1, -1, table);
+
+  auto tablets = ASSERT_RESULT(client_->LookupAllTabletsFuture(
+      table.table(), CoarseMonoClock::Now() + 10s).get());
+  ASSERT_EQ(tablets.size(), 1);
+  const auto& tablet = tablets.front();
+  auto* leader = tablet->LeaderTServer();
+  ASSERT_NE(leader, nullptr);
+  for (auto* ts : tablet->GetRemoteTabletServers()) {
+    if (ts != leader) {
+      tablet->UpdateSafeTimeLag(ts, 1h);
+    }
+  }
+
+  auto consistent_prefix_reads = [&] {
+    std::map<std::string, int64_t> result;
+    for (size_t i = 0; i != cluster_->num_tablet_servers(); ++i) {
+      auto* server = cluster_->mini_tablet_server(i)->server();
+      for (const auto& peer : server->tablet_manager()->GetTabletPeers()) {
+        if (peer->tablet_id() == tablet->tablet_id()) {
+          result[server->permanent_uuid()] =
+              peer->tablet()->metrics()->consistent_prefix_read_requests->value();
+        }
+      }
+    }
+    return result;
+  };
+
+  constexpr int kNumReads = 20;
+  auto reads_before = consistent_prefix_reads();
+  for (int i = 0; i != kNumReads; ++i) {
+    auto op = CreateReadOp(1, table);
+    op->set_yb_consistency_level(YBConsistencyLevel::CONSISTENT_PREFIX);
+    op->set_max_staleness(1min);
+    ASSERT_OK(session->TEST_ApplyAndFlush(op));
+    auto rowblock = RowsResult(op.get()).GetRowBlock();
+    ASSERT_EQ(rowblock->row_count(), 1);
+    ASSERT_EQ(rowblock->row(0).column(0).int32_value(), -1);
+  }
+  auto reads_after = consistent_prefix_reads();
+
+  ASSERT_EQ(reads_after.size(), 3);
+  for (const auto& p : reads_after) {
+    auto expected = p.first == leader->permanent_uuid() ? kNumReads : 0;
+    ASSERT_EQ(p.second - reads_before[p.first], expected) << p.first;
+  }
+}
+
+// Replaces a follower with a witness and checks that the witness keeps only the log, survives a
+// restart without materializing data, and does not prevent failover to the other data replica.
+TEST_F(QLTabletTest, WitnessFailover) {
+  constexpr int kKeys = 20;
+  FLAGS_enable_load_balancing = false;
+  FLAGS_follower_unavailable_considered_failed_sec = 10;
+
+  TableHandle table;
+  CreateTable(kTable1Name, &table, 1);
+  auto session = CreateSession();
+  session->SetTimeout(60s * kTimeMultiplier);
+  for (int key = 0; key != kKeys / 2; ++key) {
+    SetValue(session, key, -key, table);
+  }
+
+  auto leader_idx = ASSERT_RESULT(ServerWithLeaders(cluster_.get()));
+  auto leader_peers = cluster_->mini_tablet_server(leader_idx)->server()->tablet_manager()
+      ->GetTabletPeers();
+  ASSERT_EQ(leader_peers.size(), 1);
+  auto leader_peer = leader_peers.front();
+  const auto tablet_id = leader_peer->tablet_id();
+  auto* witness_server = cluster_->mini_tablet_server((leader_idx + 1) % 3);
+  const auto witness_uuid = witness_server->server()->permanent_uuid();
+  const auto data_follower_idx = (leader_idx + 2) % 3;
+
+  auto change_config = [&](
+      consensus::ChangeConfigType type, consensus::PeerMemberType member_type) {
+    consensus::ChangeConfigRequestPB req;
+    req.set_tablet_id(tablet_id);
+    req.set_type(type);
+    auto* server = req.mutable_server();
+    server->set_permanent_uuid(witness_uuid);
+    server->set_member_type(member_type);
+    HostPortToPB(
+        HostPort::FromBoundEndpoint(
+            witness_server->server()->rpc_server()->GetBoundAddresses().front()),
+        server->add_last_known_private_addr());
+    Synchronizer synchronizer;
+    boost::optional<tserver::TabletServerErrorPB::Code> error_code;
+    RETURN_NOT_OK(leader_peer->raft_consensus()->ChangeConfig(
+        req, synchronizer.AsStdStatusCallback(), &error_code));
+    return synchronizer.Wait();
+  };
+  auto witness_peer = [&]() -> std::shared_ptr<tablet::TabletPeer> {
+    auto result = witness_server->server()->tablet_manager()->LookupTablet(tablet_id);
+    return result.ok() ? *result : nullptr;
+  };
+
+  // Remove the follower and wait for the master to tombstone it, so the witness is created by
+  // remote bootstrap.
+  ASSERT_OK(change_config(consensus::REMOVE_SERVER, consensus::PeerMemberType::VOTER));
+  ASSERT_OK(WaitFor([&] {
+    auto peer = witness_peer();
+    return !peer || peer->tablet_metadata()->tablet_data_state() !=
+                        tablet::TabletDataState::TABLET_DATA_READY;
+  }, 30s * kTimeMultiplier, "Removed replica tombstoned"));
+  ASSERT_OK(change_config(consensus::ADD_SERVER, consensus::PeerMemberType::WITNESS));
+
+  auto wait_witness_running = [&] {
+    return WaitFor([&] {
+      auto peer = witness_peer();
+      return peer && peer->state() == tablet::RaftGroupStatePB::RUNNING && peer->tablet() &&
+             peer->tablet()->witness();
+    }, 30s * kTimeMultiplier, "Witness running");
+  };
+  ASSERT_OK(wait_witness_running());
+
+  for (int key = kKeys / 2; key != kKeys; ++key) {
+    SetValue(session, key, -key, table);
+  }
+  ASSERT_OK(WaitFor([&] {
+    auto peer = witness_peer();
+    return peer && peer->raft_consensus()->GetLastReceivedOpId().index >=
+                       leader_peer->raft_consensus()->GetLastReceivedOpId().index;
+  }, 30s * kTimeMultiplier, "Witness caught up"));
+
+  auto check_witness_has_no_data = [&] {
+    auto peer = witness_peer();
+    ASSERT_NE(peer, nullptr);
+    ASSERT_EQ(peer->tablet()->TEST_CountRegularDBRecords(), 0);
+    ASSERT_EQ(peer->tablet()->GetCurrentVersionNumSSTFiles(), 0);
+  };
+  ASSERT_NO_FATALS(check_witness_has_no_data());
+
+  // Follower reads that hit the witness are retried on a data replica.
+  for (int i = 0; i != 20; ++i) {
+    auto op = CreateReadOp(kKeys - 1, table);
+    op->set_yb_consistency_level(YBConsistencyLevel::CONSISTENT_PREFIX);
+    ASSERT_OK(session->TEST_ApplyAndFlush(op));
+    auto rowblock = RowsResult(op.get()).GetRowBlock();
+    ASSERT_EQ(rowblock->row_count(), 1);
+    ASSERT_EQ(rowblock->row(0).column(0).int32_value(), -(kKeys - 1));
+  }
+
+  // Bootstrap replays the log in witness mode.
+  witness_server->Shutdown();
+  ASSERT_OK(witness_server->Start());
+  ASSERT_OK(wait_witness_running());
+  ASSERT_NO_FATALS(check_witness_has_no_data());
+
+  // Only the other data replica could become the leader.
+  cluster_->mini_tablet_server(leader_idx)->Shutdown();
+  tserver::MiniTabletServer* new_leader = nullptr;
+  ASSERT_OK(WaitFor([&] {
+    new_leader = FindTabletLeader(cluster_.get(), tablet_id);
+    return new_leader != nullptr;
+  }, 30s * kTimeMultiplier, "New leader elected"));
+  ASSERT_EQ(new_leader, cluster_->mini_tablet_server(data_follower_idx));
+
+  for (int key = 0; key != kKeys; ++key) {
+    ASSERT_EQ(GetValue(session, key, table), -key);
+  }
+  // Writes resume once the shut down replica is evicted from the config.
+  SetValue(session, kKeys, -kKeys, table);
+  ASSERT_EQ(GetValue(session, kKeys, table), -kKeys);
+  ASSERT_NE(FindTabletLeader(cluster_.get(), tablet_id), witness_server);
+  ASSERT_NO_FATALS(check_witness_has_no_data());
+
+  ASSERT_OK(cluster_->mini_tablet_server(leader_idx)->Start());
+}
+
+// Idle tablet stops heartbeats and lets its lease lapse. Followers rely on the liveness of the
+// leader server and do not start elections, and reads renew the lease on the same leader.
+TEST_F(QLTabletTest, QuiescentTabletKeepsLeader) {
+  constexpr int kKeys = 10;
+  FLAGS_raft_quiescence_idle_heartbeats = 3;
+
+  TableHandle table;
+  CreateTable(kTable1Name, &table, 1);
+  auto session = CreateSession();
+  for (int key = 0; key != kKeys; ++key) {
+    SetValue(session, key, -key, table);
+  }
+
+  auto leader_idx = ASSERT_RESULT(ServerWithLeaders(cluster_.get()));
+  auto leader_peers = cluster_->mini_tablet_server(leader_idx)->server()->tablet_manager()
+      ->GetTabletPeers();
+  ASSERT_EQ(leader_peers.size(), 1);
+  auto leader_peer = leader_peers.front();
+  const auto tablet_id = leader_peer->tablet_id();
+  auto get_terms = [&] {
+    std::vector<int64_t> result;
+    for (const auto& peer : ListTabletPeers(cluster_.get(), ListPeersFilter::kAll)) {
+      if (peer->tablet_id() == tablet_id) {
+        result.push_back(peer->raft_consensus()->ConsensusState(
+            consensus::CONSENSUS_CONFIG_COMMITTED).current_term());
+      }
+    }
+    return result;
+  };
+  const auto terms = get_terms();
+  ASSERT_EQ(terms.size(), 3);
+
+  auto* raft = leader_peer->raft_consensus();
+  ASSERT_OK(WaitFor([raft] {
+    return raft->IsQuiescentLeader() &&
+           raft->GetLeaderState().status ==
+               consensus::LeaderStatus::LEADER_BUT_NO_MAJORITY_REPLICATED_LEASE;
+  }, 30s * kTimeMultiplier, "Tablet quiescent and lease lapsed"));
+
+  // Give followers enough time to detect leader failure, if they did not get liveness.
+  SleepFor(MonoDelta::FromMilliseconds(static_cast<int64_t>(
+      FLAGS_raft_heartbeat_interval_ms * FLAGS_leader_failure_max_missed_heartbeat_periods * 5)));
+  ASSERT_TRUE(raft->IsQuiescentLeader());
+  ASSERT_EQ(raft->role(), PeerRole::LEADER);
+  ASSERT_EQ(get_terms(), terms);
+
+  // Read renews the lease of the quiescent leader, write wakes it up.
+  ASSERT_EQ(GetValue(session, 0, table), 0);
+  ASSERT_EQ(raft->GetLeaderState().status, consensus::LeaderStatus::LEADER_AND_READY);
+  SetValue(session, kKeys, -kKeys, table);
+  for (int key = 0; key <= kKeys; ++key) {
+    ASSERT_EQ(GetValue(session, key, table), -key);
+  }
+  ASSERT_EQ(get_terms(), terms);
+}
+
+// On graceful step down the old leader hands off its lease, so the new leader does not wait for it
+// to expire.
+TEST_F(QLTabletTest, GracefulStepDownTransfersLease) {
+  constexpr int kKeys = 10;
+  // Make old leader lease long, and don't let the new leader revoke it via replication, so only
+  // the lease handoff on step down could avoid waiting for it.
+  FLAGS_leader_lease_duration_ms = 20000;
+  FLAGS_enable_lease_revocation = false;
+  FLAGS_enable_leader_lease_transfer = true;
+
+  TableHandle table;
+  CreateTable(kTable1Name, &table, 1);
+  auto session = CreateSession();
+  for (int key = 0; key != kKeys; ++key) {
+    SetValue(session, key, -key, table);
+  }
+
+  auto leaders = ListTabletPeers(cluster_.get(), [&table](const auto& peer) {
+    return peer->tablet_metadata()->table_id() == table->id() && peer->consensus() &&
+           peer->consensus()->GetLeaderState().status == consensus::LeaderStatus::LEADER_AND_READY;
+  });
+  ASSERT_EQ(leaders.size(), 1);
+  const auto old_leader = leaders[0];
+
+  auto start = MonoTime::Now();
+  ASSERT_OK(StepDown(old_leader, std::string(), ForceStepDown::kFalse));
+  ASSERT_OK(WaitFor([this, &table, &old_leader] {
+    auto peers = ListTabletPeers(cluster_.get(), [&table, &old_leader](const auto& peer) {
+      return peer != old_leader && peer->tablet_metadata()->table_id() == table->id() &&
+             peer->consensus() && peer->consensus()->GetLeaderState().status ==
+                 consensus::LeaderStatus::LEADER_AND_READY;
+    });
+    return !peers.empty();
+  }, 30s, "Wait for new leader to be ready"));
+  auto passed = MonoTime::Now() - start;
+  LOG(INFO) << "New leader ready in " << passed;
+  ASSERT_LT(passed, MonoDelta::FromMilliseconds(FLAGS_leader_lease_duration_ms / 2));
+
+  for (int key = 0; key != kKeys; ++key) {
+    ASSERT_EQ(GetValue(session, key, table), -key);
+  }
+}
+
+// Reads that are in progress on the old leader during graceful step down could pick their read
+// time after it. The new leader should still write only above all of them.
+TEST_F(QLTabletTest, GracefulStepDownLeaseTransferRace) {
+  constexpr int kKeys = 10;
+  constexpr int kReaders = 4;
+  FLAGS_enable_lease_revocation = false;
+  FLAGS_enable_leader_lease_transfer = true;
+
+  TableHandle table;
+  CreateTable(kTable1Name, &table, 1);
+  auto session = CreateSession();
+  for (int key = 0; key != kKeys; ++key) {
+    SetValue(session, key, -key, table);
+  }
+
+  auto leader_idx = ASSERT_RESULT(ServerWithLeaders(cluster_.get()));
+  auto* leader_server = cluster_->mini_tablet_server(leader_idx)->server();
+  auto leader_peers = leader_server->tablet_manager()->GetTabletPeers();
+  ASSERT_EQ(leader_peers.size(), 1);
+  const auto old_leader = leader_peers.front();
+  const auto tablet_id = old_leader->tablet_id();
+
+  auto op = CreateReadOp(0, table);
+  std::string partition_key;
+  ASSERT_OK(op->GetPartitionKey(&partition_key));
+  tserver::ReadRequestPB req;
+  req.set_tablet_id(tablet_id);
+  req.set_consistency_level(YBConsistencyLevel::STRONG);
+  auto* ql_batch = req.add_ql_batch();
+  *ql_batch = op->request();
+  const auto hash_code = PartitionSchema::DecodeMultiColumnHashValue(partition_key);
+  ql_batch->set_hash_code(hash_code);
+  ql_batch->set_max_hash_code(hash_code);
+
+  auto endpoint = leader_server->rpc_server()->GetBoundAddresses().front();
+  tserver::TabletServerServiceProxy proxy(
+      &leader_server->proxy_cache(), HostPort::FromBoundEndpoint(endpoint));
+
+  // Max read time of the reads served by the old leader.
+  std::atomic<uint64_t> max_read_ht{0};
+  std::atomic<int> num_reads{0};
+  TestThreadHolder thread_holder;
+  for (int i = 0; i != kReaders; ++i) {
+    thread_holder.AddThreadFunctor([&proxy, &req, &max_read_ht, &num_reads,
+                                    &stop = thread_holder.stop_flag()] {
+      while (!stop.load(std::memory_order_acquire)) {
+        tserver::ReadResponsePB resp;
+        rpc::RpcController controller;
+        controller.set_timeout(5s);
+        if (!proxy.Read(req, &resp, &controller).ok() || resp.has_error()) {
+          continue;
+        }
+        ASSERT_TRUE(resp.has_used_read_time());
+        UpdateAtomicMax<uint64_t>(&max_read_ht, resp.used_read_time().read_ht());
+        ++num_reads;
+      }
+    });
+  }
+
+  ASSERT_OK(WaitFor([&num_reads] {
+    return num_reads.load() >= kReaders * 10;
+  }, 10s * kTimeMultiplier, "Reads started"));
+  ASSERT_OK(StepDown(old_leader, std::string(), ForceStepDown::kFalse));
+  std::shared_ptr<tablet::TabletPeer> new_leader;
+  ASSERT_OK(WaitFor([this, &tablet_id, &old_leader, &new_leader] {
+    auto peers = ListTabletPeers(cluster_.get(), [&tablet_id, &old_leader](const auto& peer) {
+      return peer != old_leader && peer->tablet_id() == tablet_id && peer->consensus() &&
+             peer->consensus()->GetLeaderState().status ==
+                 consensus::LeaderStatus::LEADER_AND_READY;
+    });
+    if (peers.empty()) {
+      return false;
+    }
+    new_leader = peers.front();
+    return true;
+  }, 30s * kTimeMultiplier, "Wait for new leader to be ready"));
+  // Old leader does not serve reads anymore, so the max read time is final after the readers stop.
+  thread_holder.Stop();
+
+  SetValue(session, kKeys, -kKeys, table);
+  ASSERT_GT(new_leader->tablet()->mvcc_manager()->LastReplicatedHybridTime(),
+            HybridTime(max_read_ht.load()));
+  for (int key = 0; key <= kKeys; ++key) {
+    ASSERT_EQ(GetValue(session, key, table), -key);
+  }
+}
+
 } // namespace client
 } // namespace yb
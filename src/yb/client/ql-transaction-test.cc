@@ -36,6 +36,8 @@
 #include "yb/tablet/tablet_bootstrap_if.h"
 #include "yb/tablet/tablet_peer.h"
 #include "yb/tablet/transaction_coordinator.h"
+#include "yb/tablet/transaction_participant.h"
+#include "yb/tablet/wait_queue.h"
 
 #include "yb/tserver/mini_tablet_server.h"
 #include "yb/tserver/tablet_server.h"
@@ -62,6 +64,8 @@ DECLARE_bool(TEST_fail_in_apply_if_no_metadata);
 DECLARE_bool(TEST_master_fail_transactional_tablet_lookups);
 DECLARE_bool(TEST_transaction_allow_rerequest_status);
 DECLARE_bool(delete_intents_sst_files);
+DECLARE_bool(enable_wait_queues);
+DECLARE_bool(enable_intent_index);
 DECLARE_bool(enable_load_balancing);
 DECLARE_bool(fail_on_out_of_range_clock_skew);
 DECLARE_bool(flush_rocksdb_on_shutdown);
@@ -74,6 +78,7 @@ DECLARE_uint64(TEST_transaction_delay_status_reply_usec_in_tests);
 DECLARE_uint64(aborted_intent_cleanup_ms);
 DECLARE_uint64(max_clock_skew_usec);
 DECLARE_uint64(transaction_heartbeat_usec);
+DECLARE_uint64(wait_queue_recheck_interval_ms);
 
 namespace yb {
 namespace client {
@@ -97,6 +102,10 @@ class QLTransactionTest : public TransactionTestBase<MiniCluster> {
   // Otherwise second transaction would see pending intents from first one and should not restart.
   void TestReadRestart(bool commit = true);
 
+  void TestConflictResolution();
+
+  void TestSimpleWriteConflict();
+
   void TestWriteConflicts(const WriteConflictsOptions& options);
 
   void TestReadOnlyTablets(IsolationLevel isolation_level,
@@ -117,6 +126,18 @@ class QLTransactionTest : public TransactionTestBase<MiniCluster> {
 typedef TransactionCustomLogSegmentSizeTest<0, QLTransactionTest>
     QLTransactionBigLogSegmentSizeTest;
 
+// Resolves conflicts against the in-memory intent index instead of intents DB.
+class QLTransactionIntentIndexTest : public QLTransactionTest {
+ protected:
+  void SetUp() override {
+    FLAGS_enable_intent_index = true;
+    QLTransactionTest::SetUp();
+  }
+};
+
+typedef TransactionCustomLogSegmentSizeTest<0, QLTransactionIntentIndexTest>
+    QLTransactionIntentIndexBigLogSegmentSizeTest;
+
 TEST_F(QLTransactionTest, Simple) {
   ASSERT_NO_FATALS(WriteData());
   ASSERT_NO_FATALS(VerifyData());
@@ -511,7 +532,7 @@ TEST_F(QLTransactionTest, ResendApplying) {
   AssertNoRunningTransactions();
 }
 
-TEST_F(QLTransactionTest, ConflictResolution) {
+void QLTransactionTest::TestConflictResolution() {
   constexpr int kTotalTransactions = 5;
   constexpr int kNumRows = 10;
   std::vector<YBTransactionPtr> transactions;
@@ -576,7 +597,15 @@ TEST_F(QLTransactionTest, ConflictResolution) {
   }
 }
 
-TEST_F(QLTransactionTest, SimpleWriteConflict) {
+TEST_F(QLTransactionTest, ConflictResolution) {
+  TestConflictResolution();
+}
+
+TEST_F_EX(QLTransactionTest, ConflictResolutionWithIntentIndex, QLTransactionIntentIndexTest) {
+  TestConflictResolution();
+}
+
+void QLTransactionTest::TestSimpleWriteConflict() {
   auto transaction = CreateTransaction();
   ASSERT_OK(WriteRows(CreateSession(transaction)));
   ASSERT_OK(WriteRows(CreateSession()));
@@ -584,6 +613,159 @@ TEST_F(QLTransactionTest, SimpleWriteConflict) {
   ASSERT_NOK(transaction->CommitFuture().get());
 }
 
+TEST_F(QLTransactionTest, SimpleWriteConflict) {
+  TestSimpleWriteConflict();
+}
+
+TEST_F_EX(QLTransactionTest, SimpleWriteConflictWithIntentIndex, QLTransactionIntentIndexTest) {
+  TestSimpleWriteConflict();
+}
+
+class QLTransactionWaitQueueTest : public QLTransactionTest {
+ protected:
+  void SetUp() override {
+    FLAGS_enable_wait_queues = true;
+    // Waiters should only be woken by resolution of their blockers or by the deadline.
+    FLAGS_wait_queue_recheck_interval_ms = 600000;
+    QLTransactionTest::SetUp();
+  }
+
+  // Creates transactions with the same priority, so neither of them could abort the other and
+  // a conflicting write of either one waits for the other.
+  YBTransactionPtr CreateTransactionWithPriority() {
+    auto txn = CreateTransaction();
+    txn->SetPriority(kPriority);
+    return txn;
+  }
+
+  size_t NumWaiters() {
+    size_t result = 0;
+    for (const auto& peer : ListTabletPeers(cluster_.get(), ListPeersFilter::kLeaders)) {
+      auto* participant = peer->tablet()->transaction_participant();
+      if (participant) {
+        result += participant->wait_queue().TEST_NumWaiters();
+      }
+    }
+    return result;
+  }
+
+  // Starts write of key by txn, and checks that it waits for conflicting transactions.
+  std::future<FlushStatus> StartBlockedWrite(
+      const YBTransactionPtr& txn, int32_t key, int32_t value, MonoDelta timeout) {
+    auto session = CreateSession(txn);
+    session->SetTimeout(timeout);
+    EXPECT_OK(WriteRow(session, key, value, WriteOpType::INSERT, Flush::kFalse));
+    auto result = session->FlushFuture();
+    EXPECT_OK(WaitFor([this] { return NumWaiters() != 0; }, 10s, "Write parked"));
+    return result;
+  }
+
+  void TestWakeUp(bool commit);
+
+  static constexpr uint64_t kPriority = 1ULL << 40;
+};
+
+void QLTransactionWaitQueueTest::TestWakeUp(bool commit) {
+  auto blocker = CreateTransactionWithPriority();
+  ASSERT_OK(WriteRow(CreateSession(blocker), /* key= */ 1, /* value= */ 1));
+
+  auto waiter = CreateTransactionWithPriority();
+  auto flush_future = StartBlockedWrite(waiter, /* key= */ 1, /* value= */ 2, 60s);
+  ASSERT_EQ(flush_future.wait_for(1s), std::future_status::timeout);
+
+  if (commit) {
+    ASSERT_OK(blocker->CommitFuture().get());
+  } else {
+    blocker->Abort();
+  }
+
+  // Recheck interval is much longer than that, so the waiter is woken by the resolution.
+  ASSERT_EQ(flush_future.wait_for(15s * kTimeMultiplier), std::future_status::ready);
+  auto flush_status = flush_future.get();
+  ASSERT_EQ(NumWaiters(), 0);
+  if (commit) {
+    // Depending on the read time picked for the waiter, it could either overwrite the committed
+    // value or fail with a conflict, but never wait till the deadline.
+    if (!flush_status.status.ok()) {
+      ASSERT_FALSE(flush_status.status.IsTimedOut()) << flush_status.status;
+      waiter->Abort();
+      ASSERT_EQ(ASSERT_RESULT(SelectRow(CreateSession(), 1)), 1);
+      return;
+    }
+  } else {
+    ASSERT_OK(flush_status.status);
+  }
+  ASSERT_OK(waiter->CommitFuture().get());
+  ASSERT_EQ(ASSERT_RESULT(SelectRow(CreateSession(), 1)), 2);
+}
+
+TEST_F(QLTransactionWaitQueueTest, WakeUpOnCommit) {
+  TestWakeUp(/* commit= */ true);
+}
+
+TEST_F(QLTransactionWaitQueueTest, WakeUpOnAbort) {
+  TestWakeUp(/* commit= */ false);
+}
+
+TEST_F(QLTransactionWaitQueueTest, Deadline) {
+  const auto kTimeout = 3s;
+
+  auto blocker = CreateTransactionWithPriority();
+  ASSERT_OK(WriteRow(CreateSession(blocker), /* key= */ 1, /* value= */ 1));
+
+  auto waiter = CreateTransactionWithPriority();
+  auto start = CoarseMonoClock::now();
+  auto flush_future = StartBlockedWrite(waiter, /* key= */ 1, /* value= */ 2, kTimeout);
+  auto flush_status = flush_future.get();
+  auto elapsed = CoarseMonoClock::now() - start;
+  LOG(INFO) << "Waiter finished in " << MonoDelta(elapsed) << ": " << flush_status.status;
+
+  ASSERT_NOK(flush_status.status);
+  ASSERT_GE(elapsed, kTimeout);
+  ASSERT_LE(elapsed, kTimeout + 10s * kTimeMultiplier);
+  // The client could give up slightly before the tablet notices the deadline.
+  ASSERT_OK(WaitFor([this] { return NumWaiters() == 0; }, 5s, "Waiter removed"));
+
+  // The blocker is not affected by the waiter that gave up.
+  ASSERT_OK(blocker->CommitFuture().get());
+  waiter->Abort();
+  ASSERT_EQ(ASSERT_RESULT(SelectRow(CreateSession(), 1)), 1);
+}
+
+TEST_F(QLTransactionWaitQueueTest, Deadlock) {
+  auto txn1 = CreateTransactionWithPriority();
+  auto txn2 = CreateTransactionWithPriority();
+  ASSERT_OK(WriteRow(CreateSession(txn1), /* key= */ 1, /* value= */ 1));
+  ASSERT_OK(WriteRow(CreateSession(txn2), /* key= */ 2, /* value= */ 2));
+
+  // txn1 waits for txn2.
+  auto flush_future = StartBlockedWrite(txn1, /* key= */ 2, /* value= */ 1, 60s);
+
+  // txn2 would wait for txn1, closing the cycle, so it should fail right away instead of waiting
+  // till the deadline.
+  auto session = CreateSession(txn2);
+  session->SetTimeout(60s);
+  auto start = CoarseMonoClock::now();
+  ASSERT_OK(WriteRow(session, /* key= */ 1, /* value= */ 2, WriteOpType::INSERT, Flush::kFalse));
+  auto flush_status = session->FlushFuture().get();
+  auto elapsed = CoarseMonoClock::now() - start;
+  LOG(INFO) << "Deadlocked write finished in " << MonoDelta(elapsed) << ": "
+            << flush_status.status;
+  ASSERT_NOK(flush_status.status);
+  ASSERT_FALSE(flush_status.status.IsTimedOut()) << flush_status.status;
+  ASSERT_LE(elapsed, 10s * kTimeMultiplier);
+
+  // Aborting txn2 unblocks txn1.
+  txn2->Abort();
+  ASSERT_EQ(flush_future.wait_for(15s * kTimeMultiplier), std::future_status::ready);
+  ASSERT_OK(flush_future.get().status);
+  ASSERT_OK(txn1->CommitFuture().get());
+
+  auto read_session = CreateSession();
+  ASSERT_EQ(ASSERT_RESULT(SelectRow(read_session, 1)), 1);
+  ASSERT_EQ(ASSERT_RESULT(SelectRow(read_session, 2)), 1);
+}
+
 void QLTransactionTest::TestReadOnlyTablets(IsolationLevel isolation_level,
                                             bool perform_write,
                                             bool written_intents_expected) {
@@ -776,6 +958,35 @@ TEST_F_EX(QLTransactionTest, MixedWriteConflicts, QLTransactionBigLogSegmentSize
   TestWriteConflicts(options);
 }
 
+TEST_F_EX(QLTransactionTest, WriteConflictsWithIntentIndex,
+          QLTransactionIntentIndexBigLogSegmentSizeTest) {
+  WriteConflictsOptions options = {
+    .do_restarts = false,
+  };
+  TestWriteConflicts(options);
+}
+
+// Restarted tablets load intents from the intents DB, so the index is bypassed until those
+// transactions are resolved.
+TEST_F_EX(QLTransactionTest, WriteConflictsWithRestartsWithIntentIndex,
+          QLTransactionIntentIndexBigLogSegmentSizeTest) {
+  WriteConflictsOptions options = {
+    .do_restarts = true,
+  };
+  TestWriteConflicts(options);
+}
+
+TEST_F_EX(QLTransactionTest, MixedWriteConflictsWithIntentIndex,
+          QLTransactionIntentIndexBigLogSegmentSizeTest) {
+  WriteConflictsOptions options = {
+    .do_restarts = false,
+    .active_transactions = 3,
+    .total_keys = 1,
+    .non_txn_writes = true,
+  };
+  TestWriteConflicts(options);
+}
+
 TEST_F(QLTransactionTest, ResolveIntentsWriteReadUpdateRead) {
   DisableApplyingIntents();
 
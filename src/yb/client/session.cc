@@ -22,6 +22,7 @@
 #include "yb/client/yb_op.h"
 
 #include "yb/common/consistent_read_point.h"
+#include "yb/common/transaction_error.h"
 
 #include "yb/consensus/consensus_error.h"
 
@@ -133,6 +134,7 @@ internal::BatcherPtr CreateBatcher(const YBSession::BatcherConfig& config) {
   auto batcher = std::make_shared<internal::Batcher>(
       config.client, config.session.lock(), config.transaction, config.read_point(),
       config.force_consistent_read);
+  batcher->SetRequireSingleTablet(RequireSingleTablet(config.require_single_tablet));
   batcher->SetRejectionScoreSource(config.rejection_score_source);
   return batcher;
 }
@@ -176,6 +178,21 @@ void BatcherFlushDone(
     return;
   }
 
+  if (done_batcher->transaction_sealed()) {
+    // Ops of a batch that sealed its transaction could not be retried within it, since the seal
+    // record lists the batches of the transaction, so it will be aborted. Report them as
+    // conflicting, so the whole transaction is restarted and sealed again.
+    VLOG_WITH_FUNC(3) << "Restart sealed transaction of batcher " << done_batcher->LogPrefix()
+                      << " due to: " << errors[0]->status();
+    for (auto& error : errors) {
+      error = std::make_unique<YBError>(
+          error->shared_failed_op(),
+          error->status().CloneAndAddErrorCode(TransactionError(TransactionErrorCode::kConflict)));
+    }
+    MoveErrorsAndRunCallback(done_batcher, std::move(errors), std::move(callback), s);
+    return;
+  }
+
   VLOG_WITH_FUNC(3) << "Retrying " << errors.size() << " operations from batcher "
                     << done_batcher->LogPrefix() << " due to: " << s
                     << ": (first op error: " << errors[0]->status() << ")";
@@ -377,6 +394,17 @@ void YBSession::SetForceConsistentRead(ForceConsistentRead value) {
   }
 }
 
+void YBSession::SetRequireSingleTablet(RequireSingleTablet value) {
+  batcher_config_.require_single_tablet = value;
+  if (batcher_) {
+    batcher_->SetRequireSingleTablet(value);
+  }
+}
+
+void YBSession::SealTransactionOnFlush(CommitCallback callback) {
+  Batcher().SetSealTransactionCallback(std::move(callback));
+}
+
 bool ShouldSessionRetryError(const Status& status) {
   return IsRetryableClientError(status) ||
          tserver::TabletServerError(status) == tserver::TabletServerErrorPB::TABLET_SPLIT ||
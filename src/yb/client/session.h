@@ -218,6 +218,15 @@ class YBSession : public std::enable_shared_from_this<YBSession> {
   // It is useful when whole statement is executed using multiple flushes.
   void SetForceConsistentRead(ForceConsistentRead value);
 
+  // Sets require single tablet mode, if true then flush fails without sending anything when
+  // operations belong to more than one tablet.
+  // It is useful when operations are applied without transaction but should be atomic.
+  void SetRequireSingleTablet(RequireSingleTablet value);
+
+  // Seal the transaction as soon as operations of the next flush are prepared, so the seal record
+  // is replicated in parallel with them. See Batcher::SetSealTransactionCallback for details.
+  void SealTransactionOnFlush(CommitCallback callback);
+
   const internal::AsyncRpcMetricsPtr& async_rpc_metrics() const {
     return async_rpc_metrics_;
   }
@@ -237,6 +246,7 @@ class YBSession : public std::enable_shared_from_this<YBSession> {
     std::shared_ptr<ConsistentReadPoint> non_transactional_read_point;
     bool allow_local_calls_in_curr_thread = true;
     bool force_consistent_read = false;
+    bool require_single_tablet = false;
     RejectionScoreSourcePtr rejection_score_source;
 
     ConsistentReadPoint* read_point() const;
@@ -21,6 +21,10 @@
 #include "yb/util/test_util.h"
 #include "yb/util/trace.h"
 
+using namespace std::literals;
+
+DECLARE_int32(stale_replica_recheck_interval_ms);
+
 namespace yb {
 namespace client {
 namespace internal {
@@ -112,6 +116,54 @@ TEST_F(TabletRpcTest, TabletInvokerSelectTabletServerRace) {
   replicas_refresher.join();
 }
 
+TEST_F(TabletRpcTest, StaleReplicas) {
+  master::TabletLocationsPB tablet_locations;
+  tablet_locations.set_tablet_id(kTestTablet);
+  tablet_locations.set_stale(false);
+
+  TabletServerMap ts_map;
+  for (int i = 1; i <= 3; ++i) {
+    auto* replica = tablet_locations.add_replicas();
+    FillTsInfo(Format("n$0-uuid", i), Format("n$0", i), Format("127.0.0.$0", i),
+               replica->mutable_ts_info());
+    replica->set_role(i == 1 ? PeerRole::LEADER : PeerRole::FOLLOWER);
+    replica->set_member_type(consensus::PeerMemberType::VOTER);
+
+    const auto& uuid = replica->ts_info().permanent_uuid();
+    ts_map.emplace(uuid, std::make_unique<RemoteTabletServer>(uuid, nullptr, nullptr));
+  }
+
+  Partition partition;
+  Partition::FromPB(tablet_locations.partition(), &partition);
+  internal::RemoteTabletPtr remote_tablet = new internal::RemoteTablet(
+      tablet_locations.tablet_id(), partition, /* partition_list_version = */ 0,
+      /* split_depth = */ 0, /* split_parent_id = */ "");
+  remote_tablet->Refresh(ts_map, tablet_locations.replicas());
+
+  // Replicas that did not report safe time lag yet are not considered stale.
+  ASSERT_TRUE(remote_tablet->GetReplicasStalerThan(1ms).empty());
+
+  remote_tablet->UpdateSafeTimeLag(ts_map["n1-uuid"].get(), 10ms);
+  remote_tablet->UpdateSafeTimeLag(ts_map["n2-uuid"].get(), 2s);
+  remote_tablet->UpdateSafeTimeLag(ts_map["n3-uuid"].get(), 20s);
+
+  ASSERT_EQ(remote_tablet->GetReplicasStalerThan(5ms),
+            (std::set<std::string>{"n1-uuid", "n2-uuid", "n3-uuid"}));
+  ASSERT_EQ(remote_tablet->GetReplicasStalerThan(1s),
+            (std::set<std::string>{"n2-uuid", "n3-uuid"}));
+  ASSERT_EQ(remote_tablet->GetReplicasStalerThan(10s), std::set<std::string>{"n3-uuid"});
+  ASSERT_TRUE(remote_tablet->GetReplicasStalerThan(1min).empty());
+
+  // Replica catches up.
+  remote_tablet->UpdateSafeTimeLag(ts_map["n3-uuid"].get(), 1ms);
+  ASSERT_EQ(remote_tablet->GetReplicasStalerThan(10ms), std::set<std::string>{"n2-uuid"});
+
+  // Stale report is not taken into account after the recheck interval.
+  FLAGS_stale_replica_recheck_interval_ms = 100;
+  SleepFor(200ms);
+  ASSERT_TRUE(remote_tablet->GetReplicasStalerThan(5ms).empty());
+}
+
 } // namespace internal
 } // namespace client
 } // namespace yb
@@ -94,10 +94,20 @@ void TabletInvoker::SelectTabletServerWithConsistentPrefix() {
     }
   }
 
+  std::set<std::string> blacklist;
+  if (max_staleness_) {
+    blacklist = tablet_->GetReplicasStalerThan(max_staleness_);
+  }
   std::vector<RemoteTabletServer*> candidates;
   current_ts_ = client_->data_->SelectTServer(tablet_.get(),
-                                              YBClient::ReplicaSelection::CLOSEST_REPLICA, {},
-                                              &candidates);
+                                              YBClient::ReplicaSelection::CLOSEST_REPLICA,
+                                              blacklist, &candidates);
+  if (!current_ts_ && !blacklist.empty()) {
+    VLOG(1) << "No replica satisfies staleness bound " << max_staleness_ << ", stale replicas: "
+            << AsString(blacklist) << ", falling back to the leader";
+    SelectTabletServer();
+    return;
+  }
   VLOG(1) << "Using tserver: " << yb::ToString(current_ts_);
 }
 
@@ -108,6 +108,10 @@ class TabletInvoker {
 
   bool is_consistent_prefix() const { return consistent_prefix_; }
 
+  // Bound on staleness of a CONSISTENT_PREFIX read. Replicas that are known to lag further behind
+  // are not selected, and the leader is used if there is no other suitable replica.
+  void set_max_staleness(MonoDelta value) { max_staleness_ = value; }
+
  private:
   friend class TabletRpcTest;
   FRIEND_TEST(TabletRpcTest, TabletInvokerSelectTabletServerRace);
@@ -184,6 +188,8 @@ class TabletInvoker {
 
   const bool consistent_prefix_;
 
+  MonoDelta max_staleness_;
+
   // The TS receiving the write. May change if the write is retried.
   // RemoteTabletServer is taken from YBClient cache, so it is guaranteed that those objects are
   // alive while YBClient is alive. Because we don't delete them, but only add and update.
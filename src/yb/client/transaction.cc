@@ -491,7 +491,11 @@ class YBTransaction::Impl final : public internal::TxnBatcherIf {
       UNIQUE_LOCK(lock, mutex_);
       auto state = state_.load(std::memory_order_acquire);
       if (state != TransactionState::kRunning) {
-        if (state != TransactionState::kAborted) {
+        if (state == TransactionState::kSealed) {
+          // Status of sealed transaction is resolved by the status tablet, depending on whether
+          // all of its batches were replicated.
+          VLOG_WITH_PREFIX(2) << "Abort of sealed transaction ignored";
+        } else if (state != TransactionState::kAborted) {
           LOG_WITH_PREFIX(DFATAL)
               << "Abort of committed transaction: " << AsString(state);
         } else {
@@ -624,6 +628,10 @@ class YBTransaction::Impl final : public internal::TxnBatcherIf {
     return read_point_.IsRestartRequired();
   }
 
+  bool IsSealed() const {
+    return state_.load(std::memory_order_acquire) == TransactionState::kSealed;
+  }
+
   std::shared_future<Result<TransactionMetadata>> GetMetadata(
       CoarseTimePoint deadline) EXCLUDES(mutex_) {
     UNIQUE_LOCK(lock, mutex_);
@@ -1109,6 +1117,8 @@ class YBTransaction::Impl final : public internal::TxnBatcherIf {
         return;
       }
       commit_callback = std::move(commit_callback_);
+      // Sealed transaction is committed only if all of its batches were written.
+      actual_status = status_;
     } else {
       std::lock_guard<std::mutex> lock(mutex_);
       commit_callback = std::move(commit_callback_);
@@ -1931,6 +1941,10 @@ bool YBTransaction::IsRestartRequired() const {
   return impl_->IsRestartRequired();
 }
 
+bool YBTransaction::IsSealed() const {
+  return impl_->IsSealed();
+}
+
 Result<YBTransactionPtr> YBTransaction::CreateRestartedTransaction() {
   auto result = impl_->CreateSimilarTransaction();
   RETURN_NOT_OK(impl_->FillRestartedTransaction(result->impl_.get()));
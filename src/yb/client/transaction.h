@@ -123,6 +123,11 @@ class YBTransaction : public std::enable_shared_from_this<YBTransaction> {
 
   bool IsRestartRequired() const;
 
+  // Returns true if Commit with SealOnly::kTrue was started for this transaction. Outcome of such
+  // transaction is decided by the status tablet, it could not be committed or aborted by the
+  // client.
+  bool IsSealed() const;
+
   // Creates restarted transaction, this transaction should be in the "restart required" state.
   Result<YBTransactionPtr> CreateRestartedTransaction();
 
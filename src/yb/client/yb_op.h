@@ -395,6 +395,15 @@ class YBqlReadOp : public YBqlOp {
     yb_consistency_level_ = yb_consistency_level;
   }
 
+  // Bound on staleness of a CONSISTENT_PREFIX read: the read is served by the closest replica
+  // whose safe time is not known to lag by more than 'value', or by the leader. Ignored for STRONG
+  // reads.
+  void set_max_staleness(MonoDelta value) {
+    max_staleness_ = value;
+  }
+
+  MonoDelta max_staleness() const { return max_staleness_; }
+
   std::vector<ColumnSchema> MakeColumnSchemasFromRequest() const;
   Result<QLRowBlock> MakeRowBlock() const;
 
@@ -411,6 +420,7 @@ class YBqlReadOp : public YBqlOp {
   std::unique_ptr<QLReadRequestPB> ql_read_request_;
   YBConsistencyLevel yb_consistency_level_;
   ReadHybridTime read_time_;
+  MonoDelta max_staleness_;
 };
 
 std::vector<ColumnSchema> MakeColumnSchemasFromColDesc(
@@ -45,7 +45,9 @@ using std::shared_ptr;
 using strings::Substitute;
 
 std::string LeaderElectionData::ToString() const {
-  return YB_STRUCT_TO_STRING(mode, originator_uuid, pending_commit, must_be_committed_opid);
+  return YB_STRUCT_TO_STRING(
+      mode, originator_uuid, pending_commit, must_be_committed_opid, lease_transfer_ht,
+      originator_term);
 }
 
 ConsensusBootstrapInfo::ConsensusBootstrapInfo()
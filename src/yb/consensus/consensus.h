@@ -40,6 +40,7 @@
 #include <boost/optional/optional_fwd.hpp>
 
 #include "yb/common/entity_ids_types.h"
+#include "yb/common/hybrid_time.h"
 
 #include "yb/consensus/consensus_fwd.h"
 #include "yb/consensus/consensus_types.pb.h"
@@ -131,6 +132,15 @@ struct LeaderElectionData {
 
   bool initial_election = false;
 
+  // lease_transfer_ht - if the old leader that initiated this election handed off its leases,
+  //    the hybrid time after which it does not serve reads. See RunLeaderElectionRequestPB.
+  HybridTime lease_transfer_ht = HybridTime::kInvalid;
+
+  // originator_term - term in which the old leader that initiated this election stepped down.
+  //    The election is not started if we are already past this term, and the leases are taken over
+  //    only if it is won for the next term.
+  int64_t originator_term = OpId::kUnknownTerm;
+
   std::string ToString() const;
 };
 
@@ -268,6 +278,10 @@ class Consensus {
   LeaderStatus GetLeaderStatus(bool allow_stale = false) const;
   int64_t LeaderTerm() const;
 
+  // A leader that stopped heartbeating an idle tablet lets its lease lapse. In this case resumes
+  // heartbeats in background, so the lease gets renewed, and returns true.
+  virtual bool WakeIfQuiescent() = 0;
+
   // Returns the uuid of this peer.
   virtual std::string peer_uuid() const = 0;
 
@@ -83,6 +83,8 @@ typedef std::vector<ReplicateMsgPtr> ReplicateMsgs;
 
 YB_STRONGLY_TYPED_BOOL(TEST_SuppressVoteRequest);
 YB_STRONGLY_TYPED_BOOL(PreElection);
+// Whether a request is sent to a peer while another request to this peer is still in flight.
+YB_STRONGLY_TYPED_BOOL(Pipelined);
 
 } // namespace consensus
 
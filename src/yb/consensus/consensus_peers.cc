@@ -84,9 +84,19 @@ DEFINE_int32(max_wait_for_processresponse_before_closing_ms,
 TAG_FLAG(max_wait_for_processresponse_before_closing_ms, advanced);
 
 DECLARE_int32(raft_heartbeat_interval_ms);
+DECLARE_int32(consensus_max_inflight_update_requests);
 
 DECLARE_bool(enable_multi_raft_heartbeat_batcher);
 
+DEFINE_int32(raft_quiescence_idle_heartbeats, 0,
+             "Number of consecutive heartbeats without new operations after which the leader "
+             "stops heartbeating an idle tablet. Followers then rely on node level liveness sent "
+             "by the multi-Raft heartbeat batcher. The tablet resumes heartbeats on the next "
+             "write, when the leader lease is needed, or when liveness could not be delivered. "
+             "Zero disables quiescence.");
+TAG_FLAG(raft_quiescence_idle_heartbeats, advanced);
+TAG_FLAG(raft_quiescence_idle_heartbeats, runtime);
+
 DEFINE_test_flag(double, fault_crash_on_leader_request_fraction, 0.0,
                  "Fraction of the time when the leader will crash just before sending an "
                  "UpdateConsensus RPC.");
@@ -144,6 +154,9 @@ Status Peer::Init() {
       messenger_,
       [weak_peer]() {
         if (auto p = weak_peer.lock()) {
+          if (p->quiescent()) {
+            return;
+          }
           Status s = p->SignalRequest(RequestTriggerMode::kAlwaysSend);
         }
       },
@@ -154,10 +167,13 @@ Status Peer::Init() {
 }
 
 Status Peer::SignalRequest(RequestTriggerMode trigger_mode) {
-  // If the peer is currently sending, return Status::OK().
-  // If there are new requests in the queue we'll get them on ProcessResponse().
+  // If the peer is currently sending, new operations could be pipelined after the request in
+  // flight. Otherwise we'll get them on ProcessResponse().
   auto performing_update_lock = LockPerformingUpdate(std::try_to_lock);
   if (!performing_update_lock.owns_lock()) {
+    if (trigger_mode == RequestTriggerMode::kNonEmptyOnly) {
+      return MaybeSendPipelinedRequest();
+    }
     return Status::OK();
   }
 
@@ -319,6 +335,21 @@ void Peer::SendNextRequest(RequestTriggerMode trigger_mode) {
   // If we're actually sending ops there's no need to heartbeat for a while, reset the heartbeater.
   if (!req_is_heartbeat) {
     heartbeater_->Snooze();
+    idle_heartbeats_ = 0;
+    ExitQuiescenceUnlocked();
+  }
+
+  const bool use_batcher = req_is_heartbeat && multi_raft_batcher_ &&
+                           FLAGS_enable_multi_raft_heartbeat_batcher;
+  const auto quiescence_heartbeats = GetAtomicFlag(&FLAGS_raft_quiescence_idle_heartbeats);
+  quiescence_requested_ = use_batcher && quiescence_heartbeats > 0 &&
+                          idle_heartbeats_ >= quiescence_heartbeats;
+  if (quiescence_requested_) {
+    update_request_.set_quiescent(true);
+    update_request_.set_liveness_epoch(multi_raft_batcher_->liveness_epoch());
+  } else {
+    update_request_.clear_quiescent();
+    update_request_.clear_liveness_epoch();
   }
 
   MAYBE_FAULT(FLAGS_TEST_fault_crash_on_leader_request_fraction);
@@ -331,8 +362,7 @@ void Peer::SendNextRequest(RequestTriggerMode trigger_mode) {
   // Heartbeat batching allows for network layer savings by reducing CPU cycles
   // spent on computing state, context switching (sending/receiving RPC's)
   // and serializing/deserializing protobufs.
-  if (req_is_heartbeat && multi_raft_batcher_
-      && FLAGS_enable_multi_raft_heartbeat_batcher) {
+  if (use_batcher) {
     auto performing_heartbeat_lock = LockPerformingHeartbeat(std::try_to_lock);
     if (!performing_heartbeat_lock.owns_lock()) {
       // Outstanding heartbeat already in flight so don't schedule another.
@@ -365,6 +395,100 @@ void Peer::SendNextRequest(RequestTriggerMode trigger_mode) {
                       std::bind(&Peer::ProcessResponse, retain_self));
 }
 
+Status Peer::MaybeSendPipelinedRequest() {
+  const auto max_requests_in_flight =
+      GetAtomicFlag(&FLAGS_consensus_max_inflight_update_requests);
+  {
+    auto processing_lock = StartProcessingUnlocked();
+    if (!processing_lock.owns_lock()) {
+      return STATUS(IllegalState, "Peer was closed.");
+    }
+
+    // The regular request always occupies one of the slots.
+    if (state_ != kPeerRunning || failed_attempts_ > 0 ||
+        pipelined_requests_in_flight_.load(std::memory_order_acquire) + 1 >=
+            max_requests_in_flight) {
+      return Status::OK();
+    }
+
+    pipelined_requests_in_flight_.fetch_add(1, std::memory_order_acq_rel);
+    using_thread_pool_.fetch_add(1, std::memory_order_acq_rel);
+  }
+  auto status = raft_pool_token_->SubmitFunc(
+      std::bind(&Peer::SendPipelinedRequest, shared_from_this()));
+  using_thread_pool_.fetch_sub(1, std::memory_order_acq_rel);
+  if (!status.ok()) {
+    pipelined_requests_in_flight_.fetch_sub(1, std::memory_order_acq_rel);
+  }
+  return status;
+}
+
+void Peer::SendPipelinedRequest() {
+  auto retain_self = shared_from_this();
+  auto pipelined_request = std::make_shared<PipelinedRequest>();
+
+  auto processing_lock = StartProcessingUnlocked();
+  if (!processing_lock.owns_lock()) {
+    pipelined_requests_in_flight_.fetch_sub(1, std::memory_order_acq_rel);
+    return;
+  }
+
+  auto& request = pipelined_request->request;
+  bool needs_remote_bootstrap = false;
+  Status s = queue_->RequestForPeer(
+      peer_pb_.permanent_uuid(), &request, &pipelined_request->msgs_holder,
+      &needs_remote_bootstrap, /* member_type= */ nullptr,
+      /* last_exchange_successful= */ nullptr, Pipelined::kTrue);
+  if (!s.ok() || needs_remote_bootstrap || request.ops().empty()) {
+    // Nothing to pipeline, operations will be sent after the response to the regular request.
+    if (!s.ok()) {
+      LOG_WITH_PREFIX(INFO) << "Could not obtain pipelined request from queue for peer: " << s;
+    }
+    pipelined_request->msgs_holder.Reset();
+    pipelined_requests_in_flight_.fetch_sub(1, std::memory_order_acq_rel);
+    return;
+  }
+
+  request.set_tablet_id(tablet_id_);
+  request.set_caller_uuid(leader_uuid_);
+  request.set_dest_uuid(peer_pb_.permanent_uuid());
+  heartbeater_->Snooze();
+
+  MAYBE_FAULT(FLAGS_TEST_fault_crash_on_leader_request_fraction);
+
+  processing_lock.unlock();
+  pipelined_request->controller.set_invoke_callback_mode(
+      rpc::InvokeCallbackMode::kThreadPoolHigh);
+  proxy_->UpdateAsync(&request, RequestTriggerMode::kNonEmptyOnly, &pipelined_request->response,
+                      &pipelined_request->controller,
+                      std::bind(&Peer::ProcessPipelinedResponse, retain_self, pipelined_request));
+}
+
+void Peer::ProcessPipelinedResponse(const PipelinedRequestPtr& pipelined_request) {
+  auto status = pipelined_request->controller.status();
+  if (status.ok()) {
+    status = pipelined_request->controller.thread_pool_failure();
+  }
+  pipelined_request->msgs_holder.Reset();
+
+  bool more_pending = false;
+  {
+    auto processing_lock = StartProcessingUnlocked();
+    if (processing_lock.owns_lock()) {
+      more_pending = ProcessResponseWithStatus(
+          status, &pipelined_request->response, Pipelined::kTrue);
+    }
+  }
+  pipelined_requests_in_flight_.fetch_sub(1, std::memory_order_acq_rel);
+
+  if (more_pending) {
+    auto s = SignalRequest(RequestTriggerMode::kNonEmptyOnly);
+    if (PREDICT_FALSE(!s.ok() && !s.IsIllegalState())) {
+      LOG_WITH_PREFIX(WARNING) << "Unexpected error when trying to send request: " << s;
+    }
+  }
+}
+
 std::unique_lock<simple_spinlock> Peer::StartProcessingUnlocked() {
   std::unique_lock<simple_spinlock> lock(peer_lock_);
 
@@ -376,7 +500,8 @@ std::unique_lock<simple_spinlock> Peer::StartProcessingUnlocked() {
 }
 
 bool Peer::ProcessResponseWithStatus(const Status& status,
-                                     ConsensusResponsePB* response) {
+                                     ConsensusResponsePB* response,
+                                     Pipelined pipelined) {
   if (!status.ok()) {
     if (status.IsRemoteError()) {
       // Most controller errors are caused by network issues or corner cases like shutdown and
@@ -439,8 +564,10 @@ bool Peer::ProcessResponseWithStatus(const Status& status,
     return false;
   }
 
-  failed_attempts_ = 0;
-  return queue_->ResponseFromPeer(peer_pb_.permanent_uuid(), *response);
+  if (!pipelined) {
+    failed_attempts_ = 0;
+  }
+  return queue_->ResponseFromPeer(peer_pb_.permanent_uuid(), *response, pipelined);
 }
 
 void Peer::ProcessResponse() {
@@ -485,6 +612,16 @@ void Peer::ProcessHeartbeatResponse(const Status& status) {
   }
   bool more_pending = ProcessResponseWithStatus(status, &heartbeat_response_);
 
+  if (status.ok() && failed_attempts_ == 0 && !more_pending) {
+    ++idle_heartbeats_;
+    if (quiescence_requested_) {
+      EnterQuiescenceUnlocked();
+    }
+  } else {
+    idle_heartbeats_ = 0;
+  }
+  quiescence_requested_ = false;
+
   if (more_pending) {
     auto performing_update_lock = LockPerformingUpdate(std::try_to_lock);
     if (!performing_update_lock.owns_lock()) {
@@ -497,6 +634,46 @@ void Peer::ProcessHeartbeatResponse(const Status& status) {
   }
 }
 
+void Peer::EnterQuiescenceUnlocked() {
+  if (quiescent_.exchange(true, std::memory_order_acq_rel)) {
+    return;
+  }
+  VLOG_WITH_PREFIX(2) << "Tablet is quiescent, stopping heartbeats";
+  std::weak_ptr<Peer> weak_peer = shared_from_this();
+  multi_raft_batcher_->AddQuiescentPeer(
+      this, leader_uuid_, peer_pb_.permanent_uuid(), tablet_id_, [weak_peer] {
+        if (auto peer = weak_peer.lock()) {
+          peer->WakeFromQuiescence();
+        }
+      });
+}
+
+void Peer::ExitQuiescenceUnlocked() {
+  if (!quiescent_.exchange(false, std::memory_order_acq_rel)) {
+    return;
+  }
+  VLOG_WITH_PREFIX(2) << "Tablet is no longer quiescent";
+  multi_raft_batcher_->RemoveQuiescentPeer(this, /* revoke= */ false);
+}
+
+void Peer::WakeFromQuiescence() {
+  if (!quiescent()) {
+    return;
+  }
+  {
+    auto processing_lock = StartProcessingUnlocked();
+    if (!processing_lock.owns_lock()) {
+      return;
+    }
+    idle_heartbeats_ = 0;
+    ExitQuiescenceUnlocked();
+  }
+  auto status = SignalRequest(RequestTriggerMode::kAlwaysSend);
+  if (PREDICT_FALSE(!status.ok() && !status.IsIllegalState())) {
+    LOG_WITH_PREFIX(WARNING) << "Unexpected error when trying to send request: " << status;
+  }
+}
+
 Status Peer::SendRemoteBootstrapRequest() {
   YB_LOG_WITH_PREFIX_EVERY_N_SECS(INFO, 30) << "Sending request to remotely bootstrap";
   controller_.set_invoke_callback_mode(rpc::InvokeCallbackMode::kThreadPoolNormal);
@@ -538,7 +715,8 @@ void Peer::ProcessRemoteBootstrapResponse() {
 }
 
 void Peer::ProcessResponseError(const Status& status) {
-  DCHECK(performing_update_mutex_.is_locked() || performing_heartbeat_mutex_.is_locked());
+  DCHECK(performing_update_mutex_.is_locked() || performing_heartbeat_mutex_.is_locked() ||
+         pipelined_requests_in_flight_.load(std::memory_order_acquire) > 0);
   failed_attempts_++;
   YB_LOG_WITH_PREFIX_EVERY_N_SECS(WARNING, 5) << "Couldn't send request. "
       << " Status: " << status.ToString() << ". Retrying in the next heartbeat period."
@@ -555,6 +733,11 @@ void Peer::Close() {
   if (heartbeater_) {
     heartbeater_->Stop();
   }
+  // The follower is not going to hear from this peer anymore, so it should not rely on the
+  // liveness of this server for the tablet.
+  if (quiescent_.exchange(false, std::memory_order_acq_rel)) {
+    multi_raft_batcher_->RemoveQuiescentPeer(this, /* revoke= */ true);
+  }
 
   // If the peer is already closed return.
   {
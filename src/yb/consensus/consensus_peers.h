@@ -50,6 +50,7 @@
 #include "yb/consensus/consensus.pb.h"
 #include "yb/consensus/consensus_util.h"
 #include "yb/consensus/metadata.pb.h"
+#include "yb/consensus/replicate_msgs_holder.h"
 
 #include "yb/gutil/integral_types.h"
 
@@ -125,6 +126,10 @@ namespace consensus {
 //        v                               v
 //  SignalRequest()                    return
 //
+// When --consensus_max_inflight_update_requests is greater than 1 and a request is already in
+// flight, SignalRequest() could send additional pipelined requests with the following operations,
+// so the throughput to a remote peer is not limited by one batch per round trip.
+//
 class Peer;
 typedef std::shared_ptr<Peer> PeerPtr;
 
@@ -160,6 +165,13 @@ class Peer : public std::enable_shared_from_this<Peer> {
 
   void SetTermForTest(int term);
 
+  // Resumes heartbeats if the tablet is quiescent, for instance because the leader lease is needed.
+  void WakeFromQuiescence();
+
+  bool quiescent() const {
+    return quiescent_.load(std::memory_order_acquire);
+  }
+
   ~Peer();
 
   // Creates a new remote peer and makes the queue track it.'
@@ -180,8 +192,25 @@ class Peer : public std::enable_shared_from_this<Peer> {
   }
 
  private:
+  // An UpdateConsensus request that is sent while the regular request is still in flight.
+  struct PipelinedRequest {
+    ConsensusRequestPB request;
+    ConsensusResponsePB response;
+    rpc::RpcController controller;
+    ReplicateMsgsHolder msgs_holder;
+  };
+  using PipelinedRequestPtr = std::shared_ptr<PipelinedRequest>;
+
   void SendNextRequest(RequestTriggerMode trigger_mode);
 
+  // Submits sending of a pipelined request if the limit of in flight requests allows it.
+  Status MaybeSendPipelinedRequest();
+
+  void SendPipelinedRequest();
+
+  // Signals that a response to the pipelined request was received from the peer.
+  void ProcessPipelinedResponse(const PipelinedRequestPtr& pipelined_request);
+
   // Signals that a response was received from the peer. This method does response handling that
   // requires IO or may block.
   void ProcessResponse();
@@ -191,7 +220,8 @@ class Peer : public std::enable_shared_from_this<Peer> {
 
   // Returns true if there are more pending ops to process, false otherwise.
   bool ProcessResponseWithStatus(const Status& status,
-                                 ConsensusResponsePB* response);
+                                 ConsensusResponsePB* response,
+                                 Pipelined pipelined = Pipelined::kFalse);
 
   // Fetch the desired remote bootstrap request from the queue and send it to the peer. The callback
   // goes to ProcessRemoteBootstrapResponse().
@@ -222,6 +252,11 @@ class Peer : public std::enable_shared_from_this<Peer> {
   // Simple wrapper to cleanup ops from the request.
   void CleanRequestOps(ConsensusRequestPB* request);
 
+  // Stops periodic heartbeats, relying on the node level liveness sent by the multi-Raft batcher.
+  void EnterQuiescenceUnlocked();
+
+  void ExitQuiescenceUnlocked();
+
   std::string LogPrefix() const;
 
   const std::string& tablet_id() const { return tablet_id_; }
@@ -253,6 +288,13 @@ class Peer : public std::enable_shared_from_this<Peer> {
   // since a more recent op was sent so we won't process it's response.
   int64_t minimum_viable_heartbeat_ = 0;
 
+  // Number of consecutive successful heartbeats sent while there were no new operations.
+  int64_t idle_heartbeats_ = 0;
+  // Whether the last heartbeat told the follower that the tablet becomes quiescent.
+  bool quiescence_requested_ = false;
+  // Whether periodic heartbeats are stopped because the tablet is idle.
+  std::atomic<bool> quiescent_{false};
+
   // The latest remote bootstrap request and response.
   StartRemoteBootstrapRequestPB rb_request_;
   StartRemoteBootstrapResponsePB rb_response_;
@@ -293,6 +335,9 @@ class Peer : public std::enable_shared_from_this<Peer> {
   Consensus* consensus_ = nullptr;
   rpc::Messenger* messenger_ = nullptr;
   std::atomic<int> using_thread_pool_{0};
+
+  // Number of pipelined requests that are being prepared or in flight.
+  std::atomic<int> pipelined_requests_in_flight_{0};
 };
 
 // A proxy to another peer. Usually a thin wrapper around an rpc proxy but can be replaced for
@@ -55,6 +55,7 @@
 
 DECLARE_bool(enable_data_block_fsync);
 DECLARE_uint64(consensus_max_batch_size_bytes);
+DECLARE_int32(consensus_max_inflight_update_requests);
 
 METRIC_DECLARE_entity(tablet);
 
@@ -349,6 +350,131 @@ TEST_F(ConsensusQueueTest, TestGetPagedMessages) {
   ASSERT_FALSE(queue_->ResponseFromPeer(response.responder_uuid(), response));
 }
 
+// Tests that a pipelined request continues after the operations that are still in flight, and that
+// a late response to an earlier request does not move the peer backward.
+TEST_F(ConsensusQueueTest, TestPipelinedRequests) {
+  google::FlagSaver saver;
+  FLAGS_consensus_max_inflight_update_requests = 2;
+
+  queue_->Init(OpId::Min());
+  queue_->SetLeaderMode(
+      OpId::Min(), OpId::Min().term, OpId::Min(), BuildRaftConfigPBForTests(2));
+
+  ConsensusRequestPB request;
+  ConsensusResponsePB response;
+  response.set_responder_uuid(kPeerUuid);
+  ASSERT_TRUE(UpdatePeerWatermarkToOp(&request, &response, MinimumOpId(), MinimumOpId()));
+  AppendReplicateMessagesToQueue(queue_.get(), clock_, 1, kNumMessages);
+
+  // Operations are not pipelined until the peer successfully acks a request.
+  ConsensusRequestPB pipelined_request;
+  ReplicateMsgsHolder pipelined_refs;
+  bool needs_remote_bootstrap;
+  ASSERT_OK(queue_->RequestForPeer(
+      kPeerUuid, &pipelined_request, &pipelined_refs, &needs_remote_bootstrap,
+      /* member_type= */ nullptr, /* last_exchange_successful= */ nullptr, Pipelined::kTrue));
+  ASSERT_EQ(0, pipelined_request.ops_size());
+
+  ReplicateMsgsHolder refs;
+  ASSERT_OK(queue_->RequestForPeer(kPeerUuid, &request, &refs, &needs_remote_bootstrap));
+  ASSERT_EQ(kNumMessages, request.ops_size());
+  SetLastReceivedAndLastCommitted(&response, OpId::FromPB(request.ops(kNumMessages - 1).id()));
+  queue_->ResponseFromPeer(response.responder_uuid(), response);
+
+  AppendReplicateMessagesToQueue(queue_.get(), clock_, kNumMessages + 1, kNumMessages);
+  refs.Reset();
+  ASSERT_OK(queue_->RequestForPeer(kPeerUuid, &request, &refs, &needs_remote_bootstrap));
+  ASSERT_EQ(kNumMessages, request.ops_size());
+  const auto first_request_last_op_id = OpId::FromPB(request.ops(kNumMessages - 1).id());
+
+  // The pipelined request should contain only operations that were not sent yet.
+  AppendReplicateMessagesToQueue(queue_.get(), clock_, 2 * kNumMessages + 1, kNumMessages);
+  pipelined_refs.Reset();
+  ASSERT_OK(queue_->RequestForPeer(
+      kPeerUuid, &pipelined_request, &pipelined_refs, &needs_remote_bootstrap,
+      /* member_type= */ nullptr, /* last_exchange_successful= */ nullptr, Pipelined::kTrue));
+  ASSERT_EQ(kNumMessages, pipelined_request.ops_size());
+  ASSERT_EQ(first_request_last_op_id, OpId::FromPB(pipelined_request.preceding_id()));
+  ASSERT_FALSE(pipelined_request.has_leader_lease_duration_ms());
+  const auto pipelined_request_last_op_id =
+      OpId::FromPB(pipelined_request.ops(kNumMessages - 1).id());
+
+  // Responses arrive out of order.
+  SetLastReceivedAndLastCommitted(&response, pipelined_request_last_op_id);
+  queue_->ResponseFromPeer(response.responder_uuid(), response);
+  SetLastReceivedAndLastCommitted(&response, first_request_last_op_id);
+  queue_->ResponseFromPeer(response.responder_uuid(), response);
+  ASSERT_EQ(pipelined_request_last_op_id,
+            queue_->GetTrackedPeerForTests(kPeerUuid).last_received);
+}
+
+// Tests that a response to a pipelined request does not acknowledge the lease sent in the regular
+// request that is still in flight.
+TEST_F(ConsensusQueueTest, TestPipelinedResponseDoesNotExtendLease) {
+  google::FlagSaver saver;
+  FLAGS_consensus_max_inflight_update_requests = 2;
+
+  queue_->Init(OpId::Min());
+  queue_->SetLeaderMode(
+      OpId::Min(), OpId::Min().term, OpId::Min(), BuildRaftConfigPBForTests(2));
+
+  ConsensusRequestPB request;
+  ConsensusResponsePB response;
+  response.set_responder_uuid(kPeerUuid);
+  ASSERT_TRUE(UpdatePeerWatermarkToOp(&request, &response, MinimumOpId(), MinimumOpId()));
+  AppendReplicateMessagesToQueue(queue_.get(), clock_, 1, kNumMessages);
+
+  ReplicateMsgsHolder refs;
+  bool needs_remote_bootstrap;
+  ASSERT_OK(queue_->RequestForPeer(kPeerUuid, &request, &refs, &needs_remote_bootstrap));
+  SetLastReceivedAndLastCommitted(&response, OpId::FromPB(request.ops(kNumMessages - 1).id()));
+  queue_->ResponseFromPeer(response.responder_uuid(), response);
+  const auto acked_lease =
+      queue_->GetTrackedPeerForTests(kPeerUuid).leader_lease_expiration.last_received;
+  const auto acked_ht_lease =
+      queue_->GetTrackedPeerForTests(kPeerUuid).leader_ht_lease_expiration.last_received;
+
+  // The regular request carries a new lease and stays in flight.
+  AppendReplicateMessagesToQueue(queue_.get(), clock_, kNumMessages + 1, kNumMessages);
+  refs.Reset();
+  SleepFor(MonoDelta::FromMilliseconds(10));
+  ASSERT_OK(queue_->RequestForPeer(kPeerUuid, &request, &refs, &needs_remote_bootstrap));
+  ASSERT_TRUE(request.has_leader_lease_duration_ms());
+  const auto regular_request_last_op_id = OpId::FromPB(request.ops(kNumMessages - 1).id());
+  {
+    auto peer = queue_->GetTrackedPeerForTests(kPeerUuid);
+    ASSERT_GT(peer.leader_lease_expiration.last_sent, acked_lease);
+    ASSERT_GT(peer.leader_ht_lease_expiration.last_sent, acked_ht_lease);
+  }
+
+  AppendReplicateMessagesToQueue(queue_.get(), clock_, 2 * kNumMessages + 1, kNumMessages);
+  ConsensusRequestPB pipelined_request;
+  ReplicateMsgsHolder pipelined_refs;
+  ASSERT_OK(queue_->RequestForPeer(
+      kPeerUuid, &pipelined_request, &pipelined_refs, &needs_remote_bootstrap,
+      /* member_type= */ nullptr, /* last_exchange_successful= */ nullptr, Pipelined::kTrue));
+  ASSERT_EQ(kNumMessages, pipelined_request.ops_size());
+
+  // The pipelined response arrives first, the lease is still the previously acked one.
+  SetLastReceivedAndLastCommitted(
+      &response, OpId::FromPB(pipelined_request.ops(kNumMessages - 1).id()));
+  queue_->ResponseFromPeer(response.responder_uuid(), response, Pipelined::kTrue);
+  {
+    auto peer = queue_->GetTrackedPeerForTests(kPeerUuid);
+    ASSERT_EQ(acked_lease, peer.leader_lease_expiration.last_received);
+    ASSERT_EQ(acked_ht_lease, peer.leader_ht_lease_expiration.last_received);
+  }
+
+  // The response to the regular request acknowledges its lease.
+  SetLastReceivedAndLastCommitted(&response, regular_request_last_op_id);
+  queue_->ResponseFromPeer(response.responder_uuid(), response);
+  auto peer = queue_->GetTrackedPeerForTests(kPeerUuid);
+  ASSERT_EQ(peer.leader_lease_expiration.last_sent, peer.leader_lease_expiration.last_received);
+  ASSERT_EQ(peer.leader_ht_lease_expiration.last_sent,
+            peer.leader_ht_lease_expiration.last_received);
+  ASSERT_GT(peer.leader_lease_expiration.last_received, acked_lease);
+}
+
 TEST_F(ConsensusQueueTest, TestPeersDontAckBeyondWatermarks) {
   queue_->Init(OpId::Min());
   queue_->SetLeaderMode(
@@ -119,6 +119,13 @@ DEFINE_int32(consensus_lagging_follower_threshold, 10,
 TAG_FLAG(consensus_lagging_follower_threshold, advanced);
 TAG_FLAG(consensus_lagging_follower_threshold, runtime);
 
+DEFINE_int32(consensus_max_inflight_update_requests, 1,
+             "Maximum number of UpdateConsensus requests that a leader could have in flight to a "
+             "single follower. Values greater than 1 enable pipelined replication, which helps on "
+             "links with high round trip time.");
+TAG_FLAG(consensus_max_inflight_update_requests, advanced);
+TAG_FLAG(consensus_max_inflight_update_requests, runtime);
+
 DEFINE_test_flag(bool, disallow_lmp_failures, false,
                  "Whether we disallow PRECEDING_ENTRY_DIDNT_MATCH failures for non new peers.");
 
@@ -173,10 +180,10 @@ std::string PeerMessageQueue::TrackedPeer::ToString() const {
   return Format(
       "{ peer: $0 is_new: $1 last_received: $2 next_index: $3 last_known_committed_idx: $4 "
       "is_last_exchange_successful: $5 needs_remote_bootstrap: $6 member_type: $7 "
-      "num_sst_files: $8 last_applied: $9 }",
+      "num_sst_files: $8 last_applied: $9 last_sent_index: $10 }",
       uuid, is_new, last_received, next_index, last_known_committed_idx,
       is_last_exchange_successful, needs_remote_bootstrap, PeerMemberType_Name(member_type),
-      num_sst_files, last_applied);
+      num_sst_files, last_applied, last_sent_index);
 }
 
 void PeerMessageQueue::TrackedPeer::ResetLeaderLeases() {
@@ -434,7 +441,8 @@ Status PeerMessageQueue::RequestForPeer(const string& uuid,
                                         ReplicateMsgsHolder* msgs_holder,
                                         bool* needs_remote_bootstrap,
                                         PeerMemberType* member_type,
-                                        bool* last_exchange_successful) {
+                                        bool* last_exchange_successful,
+                                        Pipelined pipelined) {
   static constexpr uint64_t kSendUnboundedLogOps = std::numeric_limits<uint64_t>::max();
   DCHECK(request->ops().empty()) << request->ShortDebugString();
 
@@ -445,6 +453,13 @@ Status PeerMessageQueue::RequestForPeer(const string& uuid,
   int64_t previously_sent_index;
   uint64_t num_log_ops_to_send;
   HybridTime propagated_safe_time;
+  // A witness only gets operations that some data-bearing follower has already received. So when
+  // the leader fails, there is always a VOTER whose log is at least as up to date as the log of
+  // any witness, and that VOTER could win the election. It also means that an operation could
+  // not be committed by the leader and witnesses alone.
+  int64_t witness_max_index = std::numeric_limits<int64_t>::max();
+  const bool pipelining_enabled =
+      GetAtomicFlag(&FLAGS_consensus_max_inflight_update_requests) > 1;
 
   // Should be before now_ht, i.e. not greater than propagated_hybrid_time.
   if (context_) {
@@ -461,10 +476,22 @@ Status PeerMessageQueue::RequestForPeer(const string& uuid,
       return STATUS(NotFound, "Peer not tracked or queue not in leader mode.");
     }
 
+    // Operations are pipelined only to a healthy peer, whose position in the log is known.
+    if (pipelined && (!pipelining_enabled || peer->is_new || !peer->is_last_exchange_successful ||
+                      peer->needs_remote_bootstrap)) {
+      return Status::OK();
+    }
+
     HybridTime now_ht;
 
     is_new = peer->is_new;
-    if (!is_new) {
+    if (pipelined) {
+      // The lease is not extended by pipelined requests, otherwise a reply to an earlier request
+      // could be mistaken for the acknowledgement of the lease sent in the pipelined one.
+      now_ht = clock_->Now();
+      request->clear_leader_lease_duration_ms();
+      request->clear_ht_lease_expiration();
+    } else if (!is_new) {
       now_ht = clock_->Now();
 
       auto ht_lease_expiration_micros = now_ht.GetPhysicalValueMicros() +
@@ -534,7 +561,11 @@ Status PeerMessageQueue::RequestForPeer(const string& uuid,
     *needs_remote_bootstrap = peer->needs_remote_bootstrap;
 
     previously_sent_index = peer->next_index - 1;
-    if (FLAGS_enable_consensus_exponential_backoff && peer->last_num_messages_sent >= 0) {
+    if (pipelined) {
+      // Continue right after the operations that are already in flight to the peer.
+      previously_sent_index = std::max(previously_sent_index, peer->last_sent_index);
+      num_log_ops_to_send = kSendUnboundedLogOps;
+    } else if (FLAGS_enable_consensus_exponential_backoff && peer->last_num_messages_sent >= 0) {
       // Previous request to peer has not been acked. Reduce number of entries to be sent
       // in this attempt using exponential backoff. Note that to_index is inclusive.
       num_log_ops_to_send = GetNumMessagesToSendWithBackoff(peer->last_num_messages_sent);
@@ -542,13 +573,26 @@ Status PeerMessageQueue::RequestForPeer(const string& uuid,
       // Previous request to peer has been acked or a heartbeat response has been received.
       // Transmit as many entries as allowed.
       num_log_ops_to_send = kSendUnboundedLogOps;
+      if (pipelining_enabled && peer->is_last_exchange_successful) {
+        previously_sent_index = std::max(previously_sent_index, peer->last_sent_index);
+      }
     }
 
-    peer->current_retransmissions++;
+    if (!pipelined) {
+      peer->current_retransmissions++;
+    }
 
-    if (peer->member_type == PeerMemberType::VOTER) {
+    if (IsVotingMemberType(peer->member_type)) {
       is_voter = true;
     }
+
+    if (queue_state_.active_config &&
+        IsRaftConfigWitness(uuid, *queue_state_.active_config)) {
+      witness_max_index = DataFollowersReceivedIndex();
+      request->set_data_replicas_applied_index(DataReplicasAppliedIndex());
+    } else {
+      request->clear_data_replicas_applied_index();
+    }
   }
 
   if (unreachable_time.ToSeconds() > FLAGS_follower_unavailable_considered_failed_sec) {
@@ -578,11 +622,18 @@ Status PeerMessageQueue::RequestForPeer(const string& uuid,
   // status-only request. If the peer has not responded to the point that our to_index == next_index
   // due to exponential backoff of replicated segment size, we also send a status-only request.
   // Otherwise, we grab requests from the log starting at the last_received point.
-  if (!is_new && num_log_ops_to_send > 0) {
+  const bool witness_capped = witness_max_index != std::numeric_limits<int64_t>::max();
+  if (!is_new && num_log_ops_to_send > 0 && (!witness_capped || witness_max_index > 0)) {
     // The batch of messages to send to the peer.
     auto max_batch_size = FLAGS_consensus_max_batch_size_bytes - request->ByteSizeLong();
     auto to_index = num_log_ops_to_send == kSendUnboundedLogOps ?
         0 : previously_sent_index + num_log_ops_to_send;
+    if (witness_capped) {
+      // When the witness already has everything that it could get, only the preceding op is read.
+      to_index = std::max<int64_t>(
+          previously_sent_index,
+          to_index == 0 ? witness_max_index : std::min<int64_t>(to_index, witness_max_index));
+    }
     auto result = ReadFromLogCache(previously_sent_index, to_index, max_batch_size, uuid);
 
     if (PREDICT_FALSE(!result.ok())) {
@@ -610,7 +661,13 @@ Status PeerMessageQueue::RequestForPeer(const string& uuid,
         return STATUS(NotFound, "Peer not tracked.");
       }
 
-      peer->last_num_messages_sent = result->messages.size();
+      if (!pipelined) {
+        peer->last_num_messages_sent = result->messages.size();
+      }
+      if (pipelining_enabled && !result->messages.empty()) {
+        peer->last_sent_index = std::max(
+            peer->last_sent_index, result->messages.back()->id().index());
+      }
     }
 
     ScopedTrackedConsumption consumption;
@@ -622,6 +679,7 @@ Status PeerMessageQueue::RequestForPeer(const string& uuid,
 
     if (propagated_safe_time &&
         !result->have_more_messages &&
+        !witness_capped &&
         num_log_ops_to_send == kSendUnboundedLogOps) {
       // Get the current local safe time on the leader and propagate it to the follower.
       request->set_propagated_safe_time(propagated_safe_time.ToUint64());
@@ -823,6 +881,30 @@ void PeerMessageQueue::UpdateAllAppliedOpId(OpId* result) {
   *result = all_applied_op_id;
 }
 
+int64_t PeerMessageQueue::DataFollowersReceivedIndex() const {
+  bool has_data_followers = false;
+  int64_t result = 0;
+  for (const auto& peer : peers_map_) {
+    if (peer.first == local_peer_uuid_ ||
+        !IsRaftConfigVoter(peer.first, *queue_state_.active_config)) {
+      continue;
+    }
+    has_data_followers = true;
+    result = std::max(result, peer.second->last_received.index);
+  }
+  return has_data_followers ? result : std::numeric_limits<int64_t>::max();
+}
+
+int64_t PeerMessageQueue::DataReplicasAppliedIndex() const {
+  auto result = std::numeric_limits<int64_t>::max();
+  for (const auto& peer : peers_map_) {
+    if (IsRaftConfigVoter(peer.first, *queue_state_.active_config)) {
+      result = std::min(result, peer.second->last_applied.index);
+    }
+  }
+  return result == std::numeric_limits<int64_t>::max() ? 0 : result;
+}
+
 void PeerMessageQueue::UpdateAllNonLaggingReplicatedOpId(int32_t threshold) {
   OpId new_op_id = OpId::Max();
 
@@ -908,8 +990,9 @@ typename Policy::result_type PeerMessageQueue::GetWatermark() {
       // value of the watermark.
       continue;
     }
-    if (!IsRaftConfigVoter(peer.uuid, *queue_state_.active_config)) {
-      // Only votes from VOTERs in the active config should be taken into consideration
+    if (!IsRaftConfigVotingMember(peer.uuid, *queue_state_.active_config)) {
+      // Only votes from VOTERs and WITNESSes in the active config should be taken into
+      // consideration.
       continue;
     }
     if (peer.is_last_exchange_successful) {
@@ -1080,7 +1163,8 @@ void PeerMessageQueue::RequestWasNotSent(const std::string& peer_uuid) {
 
 
 bool PeerMessageQueue::ResponseFromPeer(const std::string& peer_uuid,
-                                        const ConsensusResponsePB& response) {
+                                        const ConsensusResponsePB& response,
+                                        Pipelined pipelined) {
   DCHECK(response.IsInitialized()) << "Error: Uninitialized: "
       << response.InitializationErrorString() << ". Response: " << response.ShortDebugString();
 
@@ -1135,7 +1219,10 @@ bool PeerMessageQueue::ResponseFromPeer(const std::string& peer_uuid,
     peer->is_new = false;
     peer->last_successful_communication_time = MonoTime::Now();
 
-    peer->ResetLastRequest();
+    // The retransmission state belongs to the regular request, which could still be in flight.
+    if (!pipelined) {
+      peer->ResetLastRequest();
+    }
 
     if (response.has_status()) {
       const auto& status = response.status();
@@ -1159,7 +1246,13 @@ bool PeerMessageQueue::ResponseFromPeer(const std::string& peer_uuid,
       bool peer_has_prefix_of_log = IsOpInLog(yb::OpId::FromPB(status.last_received()));
       if (peer_has_prefix_of_log) {
         // If the latest thing in their log is in our log, we are in sync.
-        peer->last_received = OpId::FromPB(status.last_received());
+        // With pipelined requests, responses could arrive out of order, so a response to an older
+        // request should not move the peer backward.
+        auto last_received = OpId::FromPB(status.last_received());
+        if (status.has_error() || last_received > peer->last_received ||
+            GetAtomicFlag(&FLAGS_consensus_max_inflight_update_requests) <= 1) {
+          peer->last_received = last_received;
+        }
         peer->next_index = peer->last_received.index + 1;
 
       } else if (!OpIdEquals(status.last_received_current_leader(), MinimumOpId())) {
@@ -1179,6 +1272,9 @@ bool PeerMessageQueue::ResponseFromPeer(const std::string& peer_uuid,
       }
 
       if (PREDICT_FALSE(status.has_error())) {
+        // Requests that are still in flight will be rejected by the peer, so start over from the
+        // index requested by it.
+        peer->last_sent_index = peer->next_index - 1;
         peer->is_last_exchange_successful = false;
         switch (status.error().code()) {
           case ConsensusErrorPB::PRECEDING_ENTRY_DIDNT_MATCH: {
@@ -1229,7 +1325,11 @@ bool PeerMessageQueue::ResponseFromPeer(const std::string& peer_uuid,
 
     // If our log has the next request for the peer or if the peer's committed index is lower than
     // our own, set 'more_pending' to true.
-    result = log_cache_.HasOpBeenWritten(peer->next_index) ||
+    // A witness could not get operations that no data-bearing follower has received yet.
+    result = (log_cache_.HasOpBeenWritten(peer->next_index) &&
+              (!queue_state_.active_config ||
+               !IsRaftConfigWitness(peer_uuid, *queue_state_.active_config) ||
+               peer->next_index <= DataFollowersReceivedIndex())) ||
         (peer->last_known_committed_idx < queue_state_.committed_op_id.index);
 
     mode_copy = queue_state_.mode;
@@ -1243,8 +1343,11 @@ bool PeerMessageQueue::ResponseFromPeer(const std::string& peer_uuid,
         }
       }
 
-      peer->leader_lease_expiration.OnReplyFromFollower();
-      peer->leader_ht_lease_expiration.OnReplyFromFollower();
+      // Pipelined requests do not carry leases, so their responses do not acknowledge any.
+      if (!pipelined) {
+        peer->leader_lease_expiration.OnReplyFromFollower();
+        peer->leader_ht_lease_expiration.OnReplyFromFollower();
+      }
 
       majority_replicated.op_id = queue_state_.majority_replicated_op_id;
       majority_replicated.leader_lease_expiration = LeaderLeaseExpirationWatermark();
@@ -1549,6 +1652,10 @@ string PeerMessageQueue::GetUpToDatePeer() const {
       if (local_peer_uuid_ == entry.first) {
         continue;
       }
+      // Witness does not have data, so it could not become a leader.
+      if (entry.second->member_type == PeerMemberType::WITNESS) {
+        continue;
+      }
       if (highest_op_id > entry.second->last_received) {
         continue;
       } else if (highest_op_id == entry.second->last_received) {
@@ -44,6 +44,7 @@
 #include "yb/common/entity_ids_types.h"
 #include "yb/common/hybrid_time.h"
 
+#include "yb/consensus/consensus_fwd.h"
 #include "yb/consensus/metadata.pb.h"
 #include "yb/consensus/log_cache.h"
 #include "yb/consensus/opid_util.h"
@@ -105,8 +106,9 @@ struct FollowerWatermark {
 // This also takes care of pushing requests to peers as new operations are added, and notifying
 // RaftConsensus when the commit index advances.
 //
-// TODO Currently this class is able to track one outstanding operation per peer. If we want to have
-// more than one outstanding RPC we need to modify it.
+// When --consensus_max_inflight_update_requests is greater than 1, several requests to the same
+// peer could be in flight. In this case the next request continues right after the last operation
+// that was sent, and responses could be processed out of order.
 class PeerMessageQueue {
  public:
   struct TrackedPeer {
@@ -139,6 +141,10 @@ class PeerMessageQueue {
     // Number of ops starting from next_index_ to retransmit.
     int64_t last_num_messages_sent = -1;
 
+    // Index of the last operation sent to the peer, including operations in requests that were not
+    // acked yet. Used only when requests to the peer are pipelined.
+    int64_t last_sent_index = kInvalidOpIdIndex;
+
     // Number of retransmissions from same next_index_.
     int64_t current_retransmissions = -1;
 
@@ -264,13 +270,17 @@ class PeerMessageQueue {
   // not delete the entries. The simplest way is to pass the same instance of ConsensusRequestPB to
   // RequestForPeer(): the buffer will replace the old entries with new ones without de-allocating
   // the old ones if they are still required.
+  //
+  // A 'pipelined' request continues after the operations that are still in flight to the peer, and
+  // is left empty if the peer is not in a state that allows pipelining.
   virtual Status RequestForPeer(
       const std::string& uuid,
       ConsensusRequestPB* request,
       ReplicateMsgsHolder* msgs_holder,
       bool* needs_remote_bootstrap,
       PeerMemberType* member_type = nullptr,
-      bool* last_exchange_successful = nullptr);
+      bool* last_exchange_successful = nullptr,
+      Pipelined pipelined = Pipelined::kFalse);
 
   // Fill in a StartRemoteBootstrapRequest for the specified peer.  If that peer should not remotely
   // bootstrap, returns a non-OK status.  On success, also internally resets
@@ -286,8 +296,12 @@ class PeerMessageQueue {
 
   // Updates the request queue with the latest response of a peer, returns whether this peer has
   // more requests pending.
+  //
+  // A response to a 'pipelined' request does not extend the leader lease of the peer, since the
+  // lease that was sent last could belong to a regular request the peer has not processed yet.
   virtual bool ResponseFromPeer(const std::string& peer_uuid,
-                                const ConsensusResponsePB& response);
+                                const ConsensusResponsePB& response,
+                                Pipelined pipelined = Pipelined::kFalse);
 
   void RequestWasNotSent(const std::string& peer_uuid);
 
@@ -502,6 +516,13 @@ class PeerMessageQueue {
   // Updates op ID applied on each node.
   void UpdateAllAppliedOpId(OpId* result) REQUIRES(queue_lock_);
 
+  // Returns the highest op index received by a VOTER other than the local peer. Returns max int64
+  // when the leader is the only VOTER in the active config.
+  int64_t DataFollowersReceivedIndex() const REQUIRES(queue_lock_);
+
+  // Returns the lowest op index applied by all VOTERs, including the local peer.
+  int64_t DataReplicasAppliedIndex() const REQUIRES(queue_lock_);
+
   // Updates op id replicated on each non-lagging node.
   void UpdateAllNonLaggingReplicatedOpId(int32_t threshold) REQUIRES(queue_lock_);
 
@@ -57,6 +57,7 @@
 #include "yb/fs/fs_manager.h"
 
 #include "yb/gutil/bind.h"
+#include "yb/gutil/casts.h"
 #include "yb/gutil/map-util.h"
 #include "yb/gutil/ref_counted.h"
 #include "yb/gutil/stl_util.h"
@@ -1693,10 +1694,8 @@ Status LogEntryBatch::Serialize() {
     return Status::OK();
   }
   DCHECK_NE(entry_batch_pb_.mono_time(), 0);
-  total_size_bytes_ = entry_batch_pb_.ByteSize();
-  buffer_.reserve(total_size_bytes_);
-
-  RETURN_NOT_OK(pb_util::AppendToString(entry_batch_pb_, &buffer_));
+  RETURN_NOT_OK(SerializeLogEntryBatch(entry_batch_pb_, &buffer_));
+  total_size_bytes_ = narrow_cast<uint32_t>(buffer_.size());
 
   state_ = kEntrySerialized;
   return Status::OK();
@@ -66,6 +66,7 @@ using std::thread;
 DECLARE_int32(log_cache_size_limit_mb);
 DECLARE_int32(global_log_cache_size_limit_mb);
 DECLARE_int32(global_log_cache_size_limit_percentage);
+DECLARE_int32(log_cache_shared_read_cache_size_mb);
 
 METRIC_DECLARE_entity(tablet);
 
@@ -373,6 +374,57 @@ TEST_F(LogCacheTest, TestReplaceMessages) {
             cache_->ToString());
 }
 
+TEST_F(LogCacheTest, TestSharedReadCache) {
+  const int kPayloadSize = 16_KB;
+  LogReadCache read_cache(256_KB);
+  int owner1 = 0, owner2 = 0;
+
+  ReplicateMsgs msgs;
+  for (int index = 1; index <= 10; ++index) {
+    msgs.push_back(CreateDummyReplicate(1, index, clock_->Now(), kPayloadSize));
+  }
+  read_cache.Insert(&owner1, msgs);
+  read_cache.Insert(&owner2, msgs);
+  ASSERT_GT(read_cache.BytesUsed(), 10 * kPayloadSize);
+  ASSERT_LE(read_cache.BytesUsed(), 256_KB);
+
+  // Entries of owner1 were inserted first, so some of them should have been evicted.
+  ASSERT_LT(read_cache.Get(&owner1, 1, 10).size(), 10);
+  ASSERT_EQ(10, read_cache.Get(&owner2, 1, 10).size());
+  ASSERT_EQ(5, read_cache.Get(&owner2, 3, 7).size());
+
+  // Only a contiguous range starting at the requested index is returned.
+  read_cache.EraseFrom(&owner2, 6);
+  ASSERT_EQ(5, read_cache.Get(&owner2, 1, 10).size());
+  ASSERT_EQ(0, read_cache.Get(&owner2, 6, 10).size());
+
+  read_cache.EraseFrom(&owner1, 0);
+  read_cache.EraseFrom(&owner2, 0);
+  ASSERT_EQ(0, read_cache.BytesUsed());
+}
+
+// Operations read from disk for one reader, together with the readahead, should be served
+// from the shared read cache for subsequent readers.
+TEST_F(LogCacheTest, TestDiskReadsAreShared) {
+  FLAGS_log_cache_shared_read_cache_size_mb = 64;
+  ASSERT_OK(AppendReplicateMessagesToCache(1, kNumMessages));
+  ASSERT_OK(log_->WaitUntilAllFlushed());
+  cache_->EvictThroughOp(kNumMessages);
+  ASSERT_EQ(0, cache_->num_cached_ops());
+
+  auto read_result = ASSERT_RESULT(cache_->ReadOps(0, kMessageIndex1, 8_MB));
+  ASSERT_EQ(kMessageIndex1, read_result.messages.size());
+  // The whole range up to the last appended operation is read ahead.
+  ASSERT_EQ(kNumMessages, cache_->metrics_.disk_reads->value());
+  ASSERT_EQ(0, cache_->metrics_.shared_read_cache_hits->value());
+
+  read_result = ASSERT_RESULT(cache_->ReadOps(kMessageIndex1, 8_MB));
+  ASSERT_EQ(kNumMessages - kMessageIndex1, read_result.messages.size());
+  EXPECT_EQ(OpIdStrForIndex(kMessageIndex1 + 1), OpIdToString(read_result.messages[0]->id()));
+  ASSERT_EQ(kNumMessages, cache_->metrics_.disk_reads->value());
+  ASSERT_EQ(kNumMessages - kMessageIndex1, cache_->metrics_.shared_read_cache_hits->value());
+}
+
 TEST_F(LogCacheTest, TestMTReadAndWrite) {
   atomic<bool> stop { false };
   bool stopped = false;
@@ -54,6 +54,7 @@
 #include "yb/util/metrics.h"
 #include "yb/util/monotime.h"
 #include "yb/util/result.h"
+#include "yb/util/scope_exit.h"
 #include "yb/util/size_literals.h"
 #include "yb/util/status_format.h"
 
@@ -76,6 +77,20 @@ DEFINE_int32(global_log_cache_size_limit_percentage, 5,
              "entries across all tablets. Default is 5.");
 TAG_FLAG(global_log_cache_size_limit_percentage, advanced);
 
+DEFINE_int32(log_cache_shared_read_cache_size_mb, 0,
+             "Server-wide size of the cache for log entries that were read from disk, e.g. for "
+             "lagging followers or CDC. Entries are shared by all readers of a tablet and are "
+             "evicted in LRU order across tablets. 0 disables the cache.");
+TAG_FLAG(log_cache_shared_read_cache_size_mb, advanced);
+TAG_FLAG(log_cache_shared_read_cache_size_mb, runtime);
+
+DEFINE_bool(log_cache_readahead, true,
+            "When log entries have to be read from disk and the shared read cache is enabled, "
+            "also read the entries that follow the requested ones, within the size limit of the "
+            "request, and put them into the shared read cache.");
+TAG_FLAG(log_cache_readahead, advanced);
+TAG_FLAG(log_cache_readahead, runtime);
+
 DEFINE_test_flag(bool, log_cache_skip_eviction, false,
                  "Don't evict log entries in tests.");
 
@@ -90,6 +105,11 @@ METRIC_DEFINE_gauge_int64(tablet, log_cache_size, "Log Cache Memory Usage",
 METRIC_DEFINE_counter(tablet, log_cache_disk_reads, "Log Cache Disk Reads",
                       yb::MetricUnit::kEntries,
                       "Amount of operations read from disk.");
+METRIC_DEFINE_counter(tablet, log_cache_shared_read_cache_hits,
+                      "Log Cache Shared Read Cache Hits",
+                      yb::MetricUnit::kEntries,
+                      "Amount of operations missing in the log cache, that were found in the "
+                      "shared cache of operations read from disk.");
 
 DECLARE_bool(get_changes_honor_deadline);
 
@@ -99,7 +119,123 @@ namespace consensus {
 namespace {
 
 const std::string kParentMemTrackerId = "log_cache"s;
+const std::string kReadCacheMemTrackerId = "log_read_cache"s;
+
+}
+
+LogReadCache::LogReadCache(size_t capacity_bytes)
+    : capacity_bytes_(capacity_bytes),
+      mem_tracker_(MemTracker::FindOrCreateTracker(kReadCacheMemTrackerId)) {
+}
+
+LogReadCache::~LogReadCache() {
+  mem_tracker_->Release(bytes_used_);
+}
+
+LogReadCache& LogReadCache::Instance() {
+  // Intentionally leaked, so it outlives log caches that are destroyed during shutdown.
+  static LogReadCache* instance = new LogReadCache();
+  return *instance;
+}
 
+size_t LogReadCache::CapacityBytes() const {
+  if (capacity_bytes_) {
+    return capacity_bytes_;
+  }
+  return std::max(GetAtomicFlag(&FLAGS_log_cache_shared_read_cache_size_mb), 0) * 1_MB;
+}
+
+ReplicateMsgs LogReadCache::Get(const void* owner, int64_t from_index, int64_t to_index) {
+  ReplicateMsgs result;
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto owner_it = entries_.find(owner);
+  if (owner_it == entries_.end()) {
+    return result;
+  }
+  auto& entries = owner_it->second;
+  for (auto it = entries.find(from_index);
+       it != entries.end() && it->first <= to_index &&
+           it->first == from_index + static_cast<int64_t>(result.size());
+       ++it) {
+    result.push_back(it->second->msg);
+    lru_.splice(lru_.begin(), lru_, it->second);
+  }
+  return result;
+}
+
+void LogReadCache::Insert(const void* owner, const ReplicateMsgs& msgs) {
+  if (msgs.empty() || CapacityBytes() == 0) {
+    return;
+  }
+
+  // SpaceUsedLong is relatively expensive, so calculate it outside the lock.
+  std::vector<size_t> mem_usages;
+  mem_usages.reserve(msgs.size());
+  for (const auto& msg : msgs) {
+    mem_usages.push_back(msg->SpaceUsedLong());
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& entries = entries_[owner];
+  for (size_t i = 0; i != msgs.size(); ++i) {
+    auto index = msgs[i]->id().index();
+    auto it = entries.find(index);
+    if (it != entries.end()) {
+      EraseUnlocked(&entries, it);
+    }
+    lru_.push_front(Entry { owner, msgs[i], mem_usages[i] });
+    entries.emplace(index, lru_.begin());
+    bytes_used_ += mem_usages[i];
+    mem_tracker_->Consume(mem_usages[i]);
+  }
+  EvictUnlocked();
+}
+
+void LogReadCache::EraseFrom(const void* owner, int64_t from_index) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto owner_it = entries_.find(owner);
+  if (owner_it == entries_.end()) {
+    return;
+  }
+  auto& entries = owner_it->second;
+  for (auto it = entries.lower_bound(from_index); it != entries.end();) {
+    it = EraseUnlocked(&entries, it);
+  }
+  if (entries.empty()) {
+    entries_.erase(owner_it);
+  }
+}
+
+bool LogReadCache::enabled() const {
+  return CapacityBytes() != 0;
+}
+
+size_t LogReadCache::BytesUsed() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return bytes_used_;
+}
+
+LogReadCache::OwnerEntries::iterator LogReadCache::EraseUnlocked(
+    OwnerEntries* entries, OwnerEntries::iterator it) {
+  auto lru_it = it->second;
+  bytes_used_ -= lru_it->mem_usage;
+  mem_tracker_->Release(lru_it->mem_usage);
+  lru_.erase(lru_it);
+  return entries->erase(it);
+}
+
+void LogReadCache::EvictUnlocked() {
+  const auto capacity = CapacityBytes();
+  while (bytes_used_ > capacity && !lru_.empty()) {
+    auto& entry = lru_.back();
+    auto owner_it = entries_.find(entry.owner);
+    DCHECK(owner_it != entries_.end());
+    auto& entries = owner_it->second;
+    EraseUnlocked(&entries, entries.find(entry.msg->id().index()));
+    if (entries.empty()) {
+      entries_.erase(owner_it);
+    }
+  }
 }
 
 typedef vector<const ReplicateMsg*>::const_iterator MsgIter;
@@ -151,6 +287,7 @@ MemTrackerPtr LogCache::GetServerMemTracker(const MemTrackerPtr& server_tracker)
 }
 
 LogCache::~LogCache() {
+  LogReadCache::Instance().EraseFrom(this, 0);
   tracker_->Release(tracker_->consumption());
   cache_.clear();
 
@@ -187,6 +324,7 @@ LogCache::PrepareAppendResult LogCache::PrepareAppendOperations(const ReplicateM
     CHECK_LE(first_idx_in_batch, next_sequential_op_index_);
 
     // Now remove the overwritten operations.
+    LogReadCache::Instance().EraseFrom(this, first_idx_in_batch);
     for (int64_t i = first_idx_in_batch; i < next_sequential_op_index_; ++i) {
       auto it = cache_.find(i);
       if (it != cache_.end()) {
@@ -337,15 +475,14 @@ Result<ReadOpsResult> LogCache::ReadOps(int64_t after_op_index,
         // Read up to the next entry that's in the cache or to_index whichever is lesser.
         up_to = std::min(iter->first - 1, to_index - 1);
       }
+      int64_t readahead_up_to =
+          iter == cache_.end() ? next_sequential_op_index_ - 1 : iter->first - 1;
 
       l.unlock();
 
-      ReplicateMsgs raw_replicate_ptrs;
-      RETURN_NOT_OK_PREPEND(
-          log_->GetLogReader()->ReadReplicatesInRange(
-              next_index, up_to, remaining_space, &raw_replicate_ptrs, &starting_op_segment_seq_num,
-              &result.header_schema, &(result.header_schema_version), deadline),
-          Substitute("Failed to read ops $0..$1", next_index, up_to));
+      auto raw_replicate_ptrs = VERIFY_RESULT(ReadMissingOps(
+          next_index, up_to, readahead_up_to, remaining_space, deadline,
+          &starting_op_segment_seq_num));
 
       if ((starting_op_segment_seq_num != -1) && !result.header_schema.IsInitialized()) {
         scoped_refptr<log::ReadableLogSegment> segment =
@@ -357,9 +494,6 @@ Result<ReadOpsResult> LogCache::ReadOps(int64_t after_op_index,
         }
       }
 
-      metrics_.disk_reads->IncrementBy(raw_replicate_ptrs.size());
-      LOG_WITH_PREFIX_UNLOCKED(INFO)
-          << "Successfully read " << raw_replicate_ptrs.size() << " ops from disk.";
       l.lock();
 
       for (auto& msg : raw_replicate_ptrs) {
@@ -419,6 +553,85 @@ Result<ReadOpsResult> LogCache::ReadOps(int64_t after_op_index,
   return result;
 }
 
+Result<ReplicateMsgs> LogCache::ReadMissingOps(
+    int64_t from_index, int64_t up_to, int64_t readahead_up_to, int64_t max_size_bytes,
+    CoarseTimePoint deadline, int64_t* starting_op_segment_seq_num) {
+  auto& read_cache = LogReadCache::Instance();
+  auto lookup_cached = [this, &read_cache, from_index, up_to, starting_op_segment_seq_num]()
+      -> Result<ReplicateMsgs> {
+    auto msgs = read_cache.Get(this, from_index, up_to);
+    if (!msgs.empty()) {
+      metrics_.shared_read_cache_hits->IncrementBy(msgs.size());
+      *starting_op_segment_seq_num = VERIFY_RESULT(
+          log_->GetLogReader()->LookupHeader(from_index));
+    }
+    return msgs;
+  };
+
+  ReplicateMsgs msgs;
+  const bool use_read_cache = read_cache.enabled();
+  int64_t read_up_to = up_to;
+  if (use_read_cache) {
+    msgs = VERIFY_RESULT(lookup_cached());
+    if (!msgs.empty()) {
+      return msgs;
+    }
+    if (GetAtomicFlag(&FLAGS_log_cache_readahead)) {
+      read_up_to = std::max(up_to, readahead_up_to);
+    }
+
+    // Wait for a disk read that covers from_index, so its result could be picked up from the
+    // shared read cache, then register our own range. Reads of other ranges are not blocked.
+    std::unique_lock<std::mutex> lock(disk_reads_mutex_);
+    for (;;) {
+      auto it = disk_reads_in_progress_.upper_bound(from_index);
+      if (it == disk_reads_in_progress_.begin() || std::prev(it)->second < from_index) {
+        break;
+      }
+      if (deadline == CoarseTimePoint::max()) {
+        disk_reads_cond_.wait(lock);
+      } else if (disk_reads_cond_.wait_until(lock, deadline) == std::cv_status::timeout) {
+        return STATUS_FORMAT(
+            TimedOut, "Timed out waiting for disk read of ops starting at $0", from_index);
+      }
+      lock.unlock();
+      msgs = VERIFY_RESULT(lookup_cached());
+      if (!msgs.empty()) {
+        return msgs;
+      }
+      lock.lock();
+    }
+    disk_reads_in_progress_.emplace(from_index, read_up_to);
+  }
+  auto se = ScopeExit([this, use_read_cache, from_index] {
+    if (use_read_cache) {
+      {
+        std::lock_guard<std::mutex> lock(disk_reads_mutex_);
+        disk_reads_in_progress_.erase(from_index);
+      }
+      disk_reads_cond_.notify_all();
+    }
+  });
+
+  // The read is limited by the size the caller could take, readahead only uses what is left of it.
+  RETURN_NOT_OK_PREPEND(
+      log_->GetLogReader()->ReadReplicatesInRange(
+          from_index, read_up_to, max_size_bytes, &msgs, starting_op_segment_seq_num,
+          /* modified_schema= */ nullptr, /* modified_schema_version= */ nullptr, deadline),
+      Substitute("Failed to read ops $0..$1", from_index, read_up_to));
+
+  metrics_.disk_reads->IncrementBy(msgs.size());
+  LOG_WITH_PREFIX_UNLOCKED(INFO) << "Successfully read " << msgs.size() << " ops from disk.";
+
+  if (use_read_cache) {
+    read_cache.Insert(this, msgs);
+  }
+  while (!msgs.empty() && msgs.back()->id().index() > up_to) {
+    msgs.pop_back();
+  }
+  return msgs;
+}
+
 size_t LogCache::EvictThroughOp(int64_t index, int64_t bytes_to_evict) {
   std::lock_guard<simple_spinlock> lock(lock_);
   return EvictSomeUnlocked(index, bytes_to_evict);
@@ -615,7 +828,8 @@ int64_t LogCache::num_cached_ops() const {
 LogCache::Metrics::Metrics(const scoped_refptr<MetricEntity>& metric_entity)
   : INSTANTIATE_METRIC(num_ops, 0),
     INSTANTIATE_METRIC(size, 0),
-    INSTANTIATE_METRIC(disk_reads) {
+    INSTANTIATE_METRIC(disk_reads),
+    INSTANTIATE_METRIC(shared_read_cache_hits) {
 }
 #undef INSTANTIATE_METRIC
 
@@ -37,10 +37,12 @@
 
 #include <atomic>
 #include <condition_variable>
+#include <list>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <glog/logging.h>
@@ -83,6 +85,56 @@ struct ReadOpsResult {
   int64_t read_from_disk_size = 0;
 };
 
+// Server-wide cache of operations that log caches had to read from disk, e.g. for a lagging
+// follower or a CDC consumer. Operations are shared by all readers of the same tablet, so a range
+// of the log is read and decoded only once. Entries of all tablets are evicted in LRU order when
+// the cache exceeds its capacity.
+class LogReadCache {
+ public:
+  // When 'capacity_bytes' is 0, capacity is taken from --log_cache_shared_read_cache_size_mb.
+  explicit LogReadCache(size_t capacity_bytes = 0);
+  ~LogReadCache();
+
+  static LogReadCache& Instance();
+
+  // Returns contiguous operations of 'owner' starting at 'from_index', up to 'to_index' inclusive.
+  ReplicateMsgs Get(const void* owner, int64_t from_index, int64_t to_index);
+
+  void Insert(const void* owner, const ReplicateMsgs& msgs);
+
+  // Removes operations of 'owner' with index >= 'from_index'.
+  void EraseFrom(const void* owner, int64_t from_index);
+
+  // Whether the cache has non zero capacity.
+  bool enabled() const;
+
+  size_t BytesUsed() const;
+
+ private:
+  struct Entry {
+    const void* owner;
+    ReplicateMsgPtr msg;
+    size_t mem_usage;
+  };
+  using LruList = std::list<Entry>;
+  using OwnerEntries = std::map<int64_t, LruList::iterator>;
+
+  size_t CapacityBytes() const;
+  OwnerEntries::iterator EraseUnlocked(OwnerEntries* entries, OwnerEntries::iterator it);
+  void EvictUnlocked();
+
+  const size_t capacity_bytes_;
+  const std::shared_ptr<MemTracker> mem_tracker_;
+
+  mutable std::mutex mutex_;
+  // Most recently used entries are at the front.
+  LruList lru_;
+  std::unordered_map<const void*, OwnerEntries> entries_;
+  size_t bytes_used_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(LogReadCache);
+};
+
 // Write-through cache for the log.
 //
 // This stores a set of log messages by their index. New operations can be appended to the end as
@@ -189,6 +241,7 @@ class LogCache {
   FRIEND_TEST(LogCacheTest, TestGlobalMemoryLimitMB);
   FRIEND_TEST(LogCacheTest, TestGlobalMemoryLimitPercentage);
   FRIEND_TEST(LogCacheTest, TestReplaceMessages);
+  FRIEND_TEST(LogCacheTest, TestDiskReadsAreShared);
   friend class LogCacheTest;
 
   // An entry in the cache.
@@ -231,6 +284,14 @@ class LogCache {
 
   PrepareAppendResult PrepareAppendOperations(const ReplicateMsgs& msgs);
 
+  // Reads operations in range [from_index, up_to] that are not present in the cache. Operations
+  // are taken from the shared read cache, or read from disk together with operations up to
+  // 'readahead_up_to' that fit into 'max_size_bytes', so subsequent reads of a lagging reader are
+  // served from memory.
+  Result<ReplicateMsgs> ReadMissingOps(
+      int64_t from_index, int64_t up_to, int64_t readahead_up_to, int64_t max_size_bytes,
+      CoarseTimePoint deadline, int64_t* starting_op_segment_seq_num);
+
   log::LogPtr const log_;
 
   // The UUID of the local peer.
@@ -257,6 +318,13 @@ class LogCache {
   // log.  Protected by lock_.
   int64_t min_pinned_op_index_;
 
+  // Ranges of operations that are being read from disk, from index -> up to index. A reader of an
+  // operation in such a range waits for that read to finish and then picks up its result from the
+  // shared read cache. Readers of other ranges are not blocked.
+  std::mutex disk_reads_mutex_;
+  std::condition_variable disk_reads_cond_;
+  std::map<int64_t, int64_t> disk_reads_in_progress_;
+
   // Pointer to a parent memtracker for all log caches. This exists to compute server-wide cache
   // size and enforce a server-wide memory limit.  When the first instance of a log cache is
   // created, a new entry is added to MemTracker's static map; subsequent entries merely increment
@@ -277,6 +345,8 @@ class LogCache {
     scoped_refptr<AtomicGauge<int64_t>> size;
 
     scoped_refptr<Counter> disk_reads;
+
+    scoped_refptr<Counter> shared_read_cache_hits;
   };
   Metrics metrics_;
 
@@ -38,6 +38,8 @@
 #include <utility>
 
 #include <glog/logging.h>
+#include <lz4.h>
+#include <snappy.h>
 
 #include "yb/common/hybrid_time.h"
 
@@ -50,11 +52,14 @@
 #include "yb/gutil/strings/split.h"
 #include "yb/gutil/strings/util.h"
 
+#include "yb/util/cast.h"
 #include "yb/util/coding-inl.h"
 #include "yb/util/coding.h"
 #include "yb/util/crc.h"
 #include "yb/util/debug/trace_event.h"
+#include "yb/util/enums.h"
 #include "yb/util/env_util.h"
+#include "yb/util/faststring.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/pb_util.h"
 #include "yb/util/result.h"
@@ -105,6 +110,32 @@ DEFINE_bool(require_durable_wal_write, false, "Whether durable WAL write is requ
     "the system will soft downgrade the durable_wal_write flag.");
 TAG_FLAG(require_durable_wal_write, stable);
 
+DEFINE_int32(log_entry_batch_compression, 0,
+             "Compression applied to WAL entry batches before they are written to log segments. "
+             "0 - no compression, 1 - snappy, 2 - lz4.");
+TAG_FLAG(log_entry_batch_compression, advanced);
+TAG_FLAG(log_entry_batch_compression, runtime);
+
+DEFINE_uint64(log_min_entry_batch_size_to_compress, 512,
+              "WAL entry batches smaller than this number of bytes are never compressed.");
+TAG_FLAG(log_min_entry_batch_size_to_compress, advanced);
+TAG_FLAG(log_min_entry_batch_size_to_compress, runtime);
+
+namespace {
+
+bool ValidateLogEntryBatchCompression(const char* flagname, int32_t value) {
+  if (yb::log::LogEntryBatchCompressionPB_IsValid(value)) {
+    return true;
+  }
+  LOG(ERROR) << "Invalid value for " << flagname << ": " << value;
+  return false;
+}
+
+} // namespace
+
+__attribute__((unused))
+DEFINE_validator(log_entry_batch_compression, &ValidateLogEntryBatchCompression);
+
 namespace yb {
 namespace log {
 
@@ -134,6 +165,109 @@ const size_t kEntryHeaderSize = 12;
 const int kLogMajorVersion = 1;
 const int kLogMinorVersion = 0;
 
+namespace {
+
+// Tries to compress the serialized entry batch stored in 'buffer' using 'compression'.
+// Leaves 'buffer' untouched if compression does not reduce its size.
+Status CompressSerializedBatch(LogEntryBatchCompressionPB compression, faststring* buffer) {
+  const auto* input = buffer->c_str();
+  const auto input_size = buffer->size();
+  std::string compressed;
+  switch (compression) {
+    case LogEntryBatchCompressionPB::NO_LOG_COMPRESSION:
+      return Status::OK();
+    case LogEntryBatchCompressionPB::LOG_COMPRESSION_SNAPPY: {
+      compressed.resize(snappy::MaxCompressedLength(input_size));
+      size_t compressed_size = 0;
+      snappy::RawCompress(input, input_size, &compressed[0], &compressed_size);
+      compressed.resize(compressed_size);
+      break;
+    }
+    case LogEntryBatchCompressionPB::LOG_COMPRESSION_LZ4: {
+      compressed.resize(LZ4_compressBound(narrow_cast<int>(input_size)));
+      auto compressed_size = LZ4_compress_default(
+          input, &compressed[0], narrow_cast<int>(input_size), narrow_cast<int>(compressed.size()));
+      if (compressed_size <= 0) {
+        return STATUS_FORMAT(RuntimeError, "LZ4 failed to compress $0 bytes", input_size);
+      }
+      compressed.resize(compressed_size);
+      break;
+    }
+    default:
+      FATAL_INVALID_ENUM_VALUE(LogEntryBatchCompressionPB, compression);
+  }
+
+  LogEntryBatchPB envelope;
+  envelope.add_entry()->set_type(LogEntryTypePB::COMPRESSED_BATCH);
+  envelope.set_compression(compression);
+  envelope.set_uncompressed_size(narrow_cast<uint32_t>(input_size));
+  envelope.mutable_compressed_batch()->swap(compressed);
+  if (implicit_cast<size_t>(envelope.ByteSize()) >= input_size) {
+    return Status::OK();
+  }
+
+  buffer->clear();
+  return pb_util::AppendToString(envelope, buffer);
+}
+
+Status DecompressEntryBatch(LogEntryBatchPB* batch) {
+  const auto& compressed = batch->compressed_batch();
+  const auto uncompressed_size = batch->uncompressed_size();
+  faststring uncompressed;
+  uncompressed.resize(uncompressed_size);
+  auto* output = pointer_cast<char*>(uncompressed.data());
+  switch (batch->compression()) {
+    case LogEntryBatchCompressionPB::NO_LOG_COMPRESSION:
+      return Status::OK();
+    case LogEntryBatchCompressionPB::LOG_COMPRESSION_SNAPPY: {
+      size_t length = 0;
+      if (!snappy::GetUncompressedLength(compressed.data(), compressed.size(), &length) ||
+          length != uncompressed_size ||
+          !snappy::RawUncompress(compressed.data(), compressed.size(), output)) {
+        return STATUS_FORMAT(
+            Corruption, "Failed to decompress snappy entry batch of $0 bytes", compressed.size());
+      }
+      break;
+    }
+    case LogEntryBatchCompressionPB::LOG_COMPRESSION_LZ4: {
+      auto length = LZ4_decompress_safe(
+          compressed.data(), output, narrow_cast<int>(compressed.size()),
+          narrow_cast<int>(uncompressed_size));
+      if (length < 0 || implicit_cast<size_t>(length) != uncompressed_size) {
+        return STATUS_FORMAT(
+            Corruption, "Failed to decompress LZ4 entry batch of $0 bytes, result: $1",
+            compressed.size(), length);
+      }
+      break;
+    }
+    default:
+      return STATUS_FORMAT(
+          Corruption, "Unknown entry batch compression: $0",
+          static_cast<int>(batch->compression()));
+  }
+
+  LogEntryBatchPB result;
+  RETURN_NOT_OK(pb_util::ParseFromArray(&result, uncompressed.data(), uncompressed.size()));
+  batch->Swap(&result);
+  return Status::OK();
+}
+
+} // namespace
+
+Status SerializeLogEntryBatch(const LogEntryBatchPB& batch, faststring* buffer) {
+  buffer->clear();
+  buffer->reserve(batch.ByteSize());
+  RETURN_NOT_OK(pb_util::AppendToString(batch, buffer));
+
+  auto compression = static_cast<LogEntryBatchCompressionPB>(
+      FLAGS_log_entry_batch_compression);
+  if (compression == LogEntryBatchCompressionPB::NO_LOG_COMPRESSION ||
+      buffer->size() < FLAGS_log_min_entry_batch_size_to_compress) {
+    return Status::OK();
+  }
+  return CompressSerializedBatch(compression, buffer);
+}
+
 // Maximum log segment header/footer size, in bytes (8 MB).
 const uint32_t kLogSegmentMaxHeaderOrFooterSize = 8 * 1024 * 1024;
 
@@ -343,9 +477,7 @@ Status ReadableLogSegment::CopyTo(
       RETURN_NOT_OK(log_index_to_rebuild->AddEntry(index_entry));
     }
 
-    write_buf.clear();
-    write_buf.reserve(current_batch.ByteSize());
-    RETURN_NOT_OK(pb_util::AppendToString(current_batch, &write_buf));
+    RETURN_NOT_OK(SerializeLogEntryBatch(current_batch, &write_buf));
     RETURN_NOT_OK(dest_segment->WriteEntryBatch(write_buf));
 
     num_entries += current_batch.entry().size();
@@ -867,6 +999,15 @@ Status ReadableLogSegment::ReadEntryBatch(int64_t *offset,
         header.msg_length, s);
   }
 
+  if (read_entry_batch.has_compression()) {
+    s = DecompressEntryBatch(&read_entry_batch);
+    if (!s.ok()) {
+      return s.CloneAndPrepend(Format(
+          "Failed to decompress entry batch at offset: $0, length: $1", *offset,
+          header.msg_length));
+    }
+  }
+
   *offset += entry_batch_slice.size();
   entry_batch->Swap(&read_entry_batch);
   return Status::OK();
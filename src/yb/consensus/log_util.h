@@ -478,6 +478,11 @@ using consensus::ReplicateMsgs;
 // in some hot paths.
 LogEntryBatchPB CreateBatchFromAllocatedOperations(const ReplicateMsgs& msgs);
 
+// Serializes 'batch' to 'buffer', replacing its previous content. When WAL compression is enabled
+// via --log_entry_batch_compression, the result is a compressed envelope, that is transparently
+// unwrapped by ReadableLogSegment while reading.
+Status SerializeLogEntryBatch(const LogEntryBatchPB& batch, faststring* buffer);
+
 // Checks if 'fname' is a correctly formatted name of log segment file.
 bool IsLogFileName(const std::string& fname);
 
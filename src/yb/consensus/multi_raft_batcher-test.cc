@@ -0,0 +1,53 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <gtest/gtest.h>
+
+#include "yb/consensus/multi_raft_batcher.h"
+
+#include "yb/util/test_util.h"
+#include "yb/util/tsan_util.h"
+
+using namespace std::literals;
+
+namespace yb {
+namespace consensus {
+
+class RaftLivenessTrackerTest : public YBTest {
+};
+
+TEST_F(RaftLivenessTrackerTest, EpochAndWindow) {
+  constexpr uint64_t kEpoch = 42;
+  const auto kWindow = 500ms * kTimeMultiplier;
+  RaftLivenessTracker tracker;
+
+  ASSERT_FALSE(tracker.IsAlive("receiver", "sender", kEpoch, kWindow));
+
+  tracker.Record("receiver", "sender", kEpoch);
+  ASSERT_TRUE(tracker.IsAlive("receiver", "sender", kEpoch, kWindow));
+  // Restarted sender reports another epoch.
+  ASSERT_FALSE(tracker.IsAlive("receiver", "sender", kEpoch + 1, kWindow));
+  // Liveness is tracked per pair of servers.
+  ASSERT_FALSE(tracker.IsAlive("receiver", "other_sender", kEpoch, kWindow));
+  ASSERT_FALSE(tracker.IsAlive("other_receiver", "sender", kEpoch, kWindow));
+
+  tracker.Record("receiver", "sender", kEpoch + 1);
+  ASSERT_FALSE(tracker.IsAlive("receiver", "sender", kEpoch, kWindow));
+  ASSERT_TRUE(tracker.IsAlive("receiver", "sender", kEpoch + 1, kWindow));
+
+  SleepFor(kWindow);
+  ASSERT_FALSE(tracker.IsAlive("receiver", "sender", kEpoch + 1, kWindow));
+}
+
+} // namespace consensus
+} // namespace yb
@@ -19,9 +19,12 @@
 #include "yb/consensus/consensus_meta.h"
 #include "yb/consensus/consensus.proxy.h"
 
+#include "yb/gutil/casts.h"
+
 #include "yb/rpc/periodic.h"
 
 #include "yb/util/flag_tags.h"
+#include "yb/util/random_util.h"
 
 using namespace std::literals;
 using namespace std::placeholders;
@@ -65,11 +68,13 @@ MultiRaftHeartbeatBatcher::MultiRaftHeartbeatBatcher(
     const HostPort& hostport,
     rpc::ProxyCache* proxy_cache,
     rpc::Messenger* messenger,
-    std::atomic<int>* running_calls)
+    std::atomic<int>* running_calls,
+    uint64_t liveness_epoch)
     : messenger_(messenger),
       consensus_proxy_(std::make_unique<ConsensusServiceProxy>(proxy_cache, hostport)),
       current_batch_(std::make_shared<MultiRaftConsensusData>()),
-      running_calls_(running_calls) {}
+      running_calls_(running_calls),
+      liveness_epoch_(liveness_epoch) {}
 
 void MultiRaftHeartbeatBatcher::Start() {
   std::weak_ptr<MultiRaftHeartbeatBatcher> weak_self = shared_from_this();
@@ -121,9 +126,25 @@ void MultiRaftHeartbeatBatcher::PrepareAndSendBatchRequest() {
 
 std::shared_ptr<MultiRaftHeartbeatBatcher::MultiRaftConsensusData>
     MultiRaftHeartbeatBatcher::PrepareNextBatchRequest() {
-  if (!current_batch_ || current_batch_->batch_req.consensus_request_size() == 0) {
+  if (!current_batch_ ||
+      (current_batch_->batch_req.consensus_request_size() == 0 && quiescent_peers_.empty() &&
+       revoked_tablet_ids_.empty())) {
     return nullptr;
   }
+  if (!quiescent_peers_.empty() || !revoked_tablet_ids_.empty()) {
+    auto& batch_req = current_batch_->batch_req;
+    batch_req.set_liveness_caller_uuid(liveness_caller_uuid_);
+    batch_req.set_liveness_dest_uuid(liveness_dest_uuid_);
+    if (!quiescent_peers_.empty()) {
+      batch_req.set_liveness_epoch(liveness_epoch_);
+    }
+    auto* tablet_ids = batch_req.mutable_liveness_revoked_tablet_ids();
+    tablet_ids->Reserve(narrow_cast<int>(revoked_tablet_ids_.size()));
+    for (auto& tablet_id : revoked_tablet_ids_) {
+      tablet_ids->Add()->swap(tablet_id);
+    }
+    revoked_tablet_ids_.clear();
+  }
   batch_sender_->Snooze();
   auto data = std::make_shared<MultiRaftConsensusData>();
   current_batch_.swap(data);
@@ -139,10 +160,17 @@ void MultiRaftHeartbeatBatcher::SendBatchRequest(std::shared_ptr<MultiRaftConsen
 
   data->controller.Reset();
   data->controller.set_timeout(MonoDelta::FromMilliseconds(
-      FLAGS_consensus_rpc_timeout_ms * data->batch_req.consensus_request_size()));
-  auto callback = [data, running_calls = running_calls_]() {
+      FLAGS_consensus_rpc_timeout_ms * std::max(data->batch_req.consensus_request_size(), 1)));
+  std::weak_ptr<MultiRaftHeartbeatBatcher> weak_self = shared_from_this();
+  auto callback = [data, running_calls = running_calls_, weak_self]() {
     --*running_calls;
     auto status = data->controller.status();
+    if (!status.ok() && data->batch_req.has_liveness_caller_uuid()) {
+      if (auto self = weak_self.lock()) {
+        self->RequeueRevokedTablets(data->batch_req.liveness_revoked_tablet_ids());
+        self->WakeQuiescentPeers();
+      }
+    }
     for (int i = 0; i < data->batch_req.consensus_request_size(); i++) {
       auto callback_data = data->response_callback_data[i];
       if (status.ok()) {
@@ -155,12 +183,64 @@ void MultiRaftHeartbeatBatcher::SendBatchRequest(std::shared_ptr<MultiRaftConsen
       data->batch_req, &data->batch_res, &data->controller, callback);
 }
 
+void MultiRaftHeartbeatBatcher::AddQuiescentPeer(
+    const void* key, const std::string& caller_uuid, const std::string& dest_uuid,
+    const TabletId& tablet_id, std::function<void()> wake) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  liveness_caller_uuid_ = caller_uuid;
+  liveness_dest_uuid_ = dest_uuid;
+  quiescent_peers_[key] = QuiescentPeer {
+    .tablet_id = tablet_id,
+    .wake = std::move(wake),
+  };
+}
+
+void MultiRaftHeartbeatBatcher::RemoveQuiescentPeer(const void* key, bool revoke) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = quiescent_peers_.find(key);
+  if (it == quiescent_peers_.end()) {
+    return;
+  }
+  if (revoke) {
+    revoked_tablet_ids_.push_back(std::move(it->second.tablet_id));
+  }
+  quiescent_peers_.erase(it);
+}
+
+void MultiRaftHeartbeatBatcher::RequeueRevokedTablets(
+    const google::protobuf::RepeatedPtrField<std::string>& tablet_ids) {
+  if (tablet_ids.empty()) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  revoked_tablet_ids_.insert(revoked_tablet_ids_.end(), tablet_ids.begin(), tablet_ids.end());
+}
+
+void MultiRaftHeartbeatBatcher::WakeQuiescentPeers() {
+  decltype(quiescent_peers_) peers;
+  std::string dest_uuid;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    peers.swap(quiescent_peers_);
+    dest_uuid = liveness_dest_uuid_;
+  }
+  if (!peers.empty()) {
+    LOG(INFO) << "Failed to deliver liveness to " << dest_uuid << ", waking "
+              << peers.size() << " quiescent peers";
+  }
+  for (const auto& key_and_peer : peers) {
+    key_and_peer.second.wake();
+  }
+}
+
 void MultiRaftHeartbeatBatcher::Shutdown() {
   decltype(current_batch_) batch;
   batch_sender_->Stop();
   {
     std::lock_guard<std::mutex> lock(mutex_);
     batch.swap(current_batch_);
+    quiescent_peers_.clear();
+    revoked_tablet_ids_.clear();
   }
   static const Status status = STATUS(Aborted, "MultiRaft shutdown");
   for (const auto& callback : batch->response_callback_data) {
@@ -168,11 +248,52 @@ void MultiRaftHeartbeatBatcher::Shutdown() {
   }
 }
 
+RaftLivenessTracker& RaftLivenessTracker::Instance() {
+  static RaftLivenessTracker* instance = new RaftLivenessTracker();
+  return *instance;
+}
+
+std::string RaftLivenessTracker::MakeKey(
+    const std::string& receiver_uuid, const std::string& sender_uuid) {
+  std::string result;
+  result.reserve(receiver_uuid.size() + sender_uuid.size() + 1);
+  result += receiver_uuid;
+  result += '/';
+  result += sender_uuid;
+  return result;
+}
+
+RaftLivenessTracker::Shard& RaftLivenessTracker::ShardFor(const std::string& key) const {
+  return shards_[std::hash<std::string>()(key) % kNumShards];
+}
+
+void RaftLivenessTracker::Record(
+    const std::string& receiver_uuid, const std::string& sender_uuid, uint64_t epoch) {
+  auto key = MakeKey(receiver_uuid, sender_uuid);
+  auto& shard = ShardFor(key);
+  auto now = CoarseMonoClock::now();
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  auto& last_seen = shard.last_seen[key];
+  last_seen.epoch = epoch;
+  last_seen.time = now;
+}
+
+bool RaftLivenessTracker::IsAlive(const std::string& receiver_uuid, const std::string& sender_uuid,
+                                  uint64_t epoch, MonoDelta window) const {
+  auto key = MakeKey(receiver_uuid, sender_uuid);
+  auto& shard = ShardFor(key);
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  auto it = shard.last_seen.find(key);
+  return it != shard.last_seen.end() && it->second.epoch == epoch &&
+         CoarseMonoClock::now() < it->second.time + window;
+}
+
 MultiRaftManager::MultiRaftManager(rpc::Messenger* messenger,
                                    rpc::ProxyCache* proxy_cache,
                                    CloudInfoPB local_peer_cloud_info_pb)
     : messenger_(messenger), proxy_cache_(proxy_cache),
-      local_peer_cloud_info_pb_(std::move(local_peer_cloud_info_pb)) {}
+      local_peer_cloud_info_pb_(std::move(local_peer_cloud_info_pb)),
+      liveness_epoch_(RandomUniformInt<uint64_t>()) {}
 
 MultiRaftHeartbeatBatcherPtr MultiRaftManager::AddOrGetBatcher(const RaftPeerPB& remote_peer_pb) {
   if (!FLAGS_enable_multi_raft_heartbeat_batcher) {
@@ -194,7 +315,7 @@ MultiRaftHeartbeatBatcherPtr MultiRaftManager::AddOrGetBatcher(const RaftPeerPB&
     return batcher;
   }
   batcher = std::make_shared<MultiRaftHeartbeatBatcher>(
-      hostport, proxy_cache_, messenger_, &running_calls_);
+      hostport, proxy_cache_, messenger_, &running_calls_, liveness_epoch_);
   batchers_[hostport] = batcher;
   batcher->Start();
   return batcher;
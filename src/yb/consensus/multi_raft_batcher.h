@@ -13,14 +13,21 @@
 #ifndef YB_CONSENSUS_MULTI_RAFT_BATCHER_H_
 #define YB_CONSENSUS_MULTI_RAFT_BATCHER_H_
 
+#include <array>
 #include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <google/protobuf/repeated_field.h>
 
 #include "yb/common/common_net.pb.h"
+#include "yb/common/entity_ids_types.h"
 
 #include "yb/consensus/consensus_fwd.h"
 
 #include "yb/rpc/rpc_controller.h"
 
+#include "yb/util/monotime.h"
 #include "yb/util/net/net_util.h"
 
 namespace yb {
@@ -43,12 +50,19 @@ using HeartbeatResponseCallback = std::function<void(const Status&)>;
 //   FLAGS_multi_raft_batch_size
 // - To improve efficency multiple batches may be processed concurrently
 //   but only a single batch is being built at any given time
+// - Peers of quiescent tablets stop sending heartbeats and register with the batcher instead.
+//   While there are such peers, every batch carries the liveness epoch of the local server, and
+//   batches are sent even when they don't contain any heartbeats. So the cost of liveness does not
+//   depend on the number of quiescent tablets. A quiescent peer that is closed without telling the
+//   follower, e.g. on step down, is listed in the next batch as revoked. If a batch fails,
+//   quiescent peers are woken up, so regular heartbeats take over failure detection.
 class MultiRaftHeartbeatBatcher : public std::enable_shared_from_this<MultiRaftHeartbeatBatcher> {
  public:
   MultiRaftHeartbeatBatcher(const HostPort& hostport,
                             rpc::ProxyCache* proxy_cache,
                             rpc::Messenger* messenger,
-                            std::atomic<int>* running_calls);
+                            std::atomic<int>* running_calls,
+                            uint64_t liveness_epoch);
 
   ~MultiRaftHeartbeatBatcher();
 
@@ -63,6 +77,22 @@ class MultiRaftHeartbeatBatcher : public std::enable_shared_from_this<MultiRaftH
                          ConsensusResponsePB* response,
                          HeartbeatResponseCallback callback);
 
+  // Registers a peer of a quiescent tablet, 'wake' is invoked if liveness could not be delivered
+  // to the remote server.
+  void AddQuiescentPeer(const void* key, const std::string& caller_uuid,
+                        const std::string& dest_uuid, const TabletId& tablet_id,
+                        std::function<void()> wake);
+
+  // Unregisters a peer of a quiescent tablet. If 'revoke' is true, the peer stops leading the
+  // tablet without telling the follower, so the follower is told in the next batch.
+  void RemoveQuiescentPeer(const void* key, bool revoke);
+
+  // Epoch sent with the liveness of the local server. Followers of quiescent tablets remember it
+  // and stop relying on liveness when it changes.
+  uint64_t liveness_epoch() const {
+    return liveness_epoch_;
+  }
+
   void Shutdown();
 
  private:
@@ -80,6 +110,11 @@ class MultiRaftHeartbeatBatcher : public std::enable_shared_from_this<MultiRaftH
 
   void MultiRaftUpdateHeartbeatResponseCallback(std::shared_ptr<MultiRaftConsensusData> data);
 
+  void WakeQuiescentPeers();
+
+  // Puts back revoked tablets of a batch that could not be delivered.
+  void RequeueRevokedTablets(const google::protobuf::RepeatedPtrField<std::string>& tablet_ids);
+
   rpc::Messenger* messenger_;
 
   ConsensusServiceProxyPtr consensus_proxy_;
@@ -90,7 +125,54 @@ class MultiRaftHeartbeatBatcher : public std::enable_shared_from_this<MultiRaftH
 
   std::shared_ptr<MultiRaftConsensusData> current_batch_ GUARDED_BY(mutex_);
 
+  struct QuiescentPeer {
+    TabletId tablet_id;
+    std::function<void()> wake;
+  };
+
+  std::unordered_map<const void*, QuiescentPeer> quiescent_peers_ GUARDED_BY(mutex_);
+  std::string liveness_caller_uuid_ GUARDED_BY(mutex_);
+  std::string liveness_dest_uuid_ GUARDED_BY(mutex_);
+  std::vector<TabletId> revoked_tablet_ids_ GUARDED_BY(mutex_);
+
   std::atomic<int>* running_calls_;
+  const uint64_t liveness_epoch_;
+};
+
+// Keeps the epoch and the time of the last liveness message from each server. Followers of
+// quiescent tablets use it instead of tablet heartbeats to detect leader failure. Keyed by both
+// receiver and sender uuid, since several servers could share a process in tests. There is a
+// single entry per pair of servers, so recording liveness does not depend on the number of
+// tablets. Entries are spread over shards, so followers checking liveness do not contend on a
+// single mutex.
+class RaftLivenessTracker {
+ public:
+  static RaftLivenessTracker& Instance();
+
+  void Record(const std::string& receiver_uuid, const std::string& sender_uuid, uint64_t epoch);
+
+  // Returns true if the sender reported liveness with the specified epoch during the last 'window'.
+  bool IsAlive(const std::string& receiver_uuid, const std::string& sender_uuid, uint64_t epoch,
+               MonoDelta window) const;
+
+ private:
+  static constexpr size_t kNumShards = 16;
+
+  struct LastSeen {
+    uint64_t epoch = 0;
+    CoarseTimePoint time;
+  };
+
+  struct Shard {
+    std::mutex mutex;
+    std::unordered_map<std::string, LastSeen> last_seen;
+  };
+
+  static std::string MakeKey(const std::string& receiver_uuid, const std::string& sender_uuid);
+
+  Shard& ShardFor(const std::string& key) const;
+
+  mutable std::array<Shard, kNumShards> shards_;
 };
 
 // MultiRaftManager is responsible for managing all MultiRaftHeartbeatBatchers
@@ -129,6 +211,10 @@ class MultiRaftManager: public std::enable_shared_from_this<MultiRaftManager> {
 
   bool shutdown_ = false;
   std::atomic<int> running_calls_{0};
+
+  // Changes each time the server starts, so followers of tablets that became quiescent before a
+  // restart stop relying on the liveness of the restarted server.
+  const uint64_t liveness_epoch_;
 };
 
 }   // namespace consensus
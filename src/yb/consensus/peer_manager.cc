@@ -120,6 +120,23 @@ void PeerManager::SignalRequest(RequestTriggerMode trigger_mode) {
   }
 }
 
+void PeerManager::WakeQuiescentPeers() {
+  std::lock_guard<simple_spinlock> lock(lock_);
+  for (const auto& entry : peers_) {
+    entry.second->WakeFromQuiescence();
+  }
+}
+
+bool PeerManager::HasQuiescentPeers() const {
+  std::lock_guard<simple_spinlock> lock(lock_);
+  for (const auto& entry : peers_) {
+    if (entry.second->quiescent()) {
+      return true;
+    }
+  }
+  return false;
+}
+
 void PeerManager::Close() {
   std::lock_guard<simple_spinlock> lock(lock_);
   for (const auto& entry : peers_) {
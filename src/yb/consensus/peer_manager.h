@@ -85,6 +85,12 @@ class PeerManager {
   // Signals all peers of the current configuration that there is a new request pending.
   virtual void SignalRequest(RequestTriggerMode trigger_mode);
 
+  // Resumes heartbeats of peers that stopped them because the tablet was idle.
+  virtual void WakeQuiescentPeers();
+
+  // Returns true if some peer stopped heartbeats because the tablet was idle.
+  virtual bool HasQuiescentPeers() const;
+
   // Closes all peers.
   virtual void Close();
 
@@ -74,5 +74,29 @@ TEST(QuorumUtilTest, TestMemberExtraction) {
   ASSERT_EQ("B", peer_pb.permanent_uuid());
 }
 
+TEST(QuorumUtilTest, TestWitness) {
+  RaftConfigPB config;
+  SetPeerInfo("A", PeerMemberType::VOTER, config.add_peers());
+  SetPeerInfo("B", PeerMemberType::VOTER, config.add_peers());
+  SetPeerInfo("C", PeerMemberType::WITNESS, config.add_peers());
+  SetPeerInfo("D", PeerMemberType::OBSERVER, config.add_peers());
+
+  // Witness counts towards the majority, but could not become a leader.
+  ASSERT_EQ(3, CountVoters(config));
+  ASSERT_EQ(2, MajoritySize(CountVoters(config)));
+  ASSERT_TRUE(IsRaftConfigVotingMember("C", config));
+  ASSERT_FALSE(IsRaftConfigVoter("C", config));
+  ASSERT_TRUE(IsRaftConfigWitness("C", config));
+  ASSERT_FALSE(IsRaftConfigWitness("A", config));
+  ASSERT_FALSE(IsRaftConfigVotingMember("D", config));
+
+  ConsensusStatePB cstate;
+  *cstate.mutable_config() = config;
+  cstate.set_leader_uuid("A");
+  ASSERT_EQ(PeerRole::FOLLOWER, GetConsensusRole("C", cstate));
+  cstate.set_leader_uuid("C");
+  ASSERT_EQ(PeerRole::NON_PARTICIPANT, GetConsensusRole("C", cstate));
+}
+
 } // namespace consensus
 } // namespace yb
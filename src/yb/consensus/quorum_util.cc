@@ -70,6 +70,28 @@ bool IsRaftConfigVoter(const std::string& uuid, const RaftConfigPB& config) {
   return false;
 }
 
+bool IsRaftConfigWitness(const std::string& uuid, const RaftConfigPB& config) {
+  for (const RaftPeerPB& peer : config.peers()) {
+    if (peer.permanent_uuid() == uuid) {
+      return peer.member_type() == PeerMemberType::WITNESS;
+    }
+  }
+  return false;
+}
+
+bool IsRaftConfigVotingMember(const std::string& uuid, const RaftConfigPB& config) {
+  for (const RaftPeerPB& peer : config.peers()) {
+    if (peer.permanent_uuid() == uuid) {
+      return IsVotingMemberType(peer.member_type());
+    }
+  }
+  return false;
+}
+
+bool IsVotingMemberType(PeerMemberType member_type) {
+  return member_type == PeerMemberType::VOTER || member_type == PeerMemberType::WITNESS;
+}
+
 Status GetRaftConfigMember(const RaftConfigPB& config,
                            const std::string& uuid,
                            RaftPeerPB* peer_pb) {
@@ -152,7 +174,8 @@ bool RemoveFromRaftConfig(RaftConfigPB* config, const ChangeConfigRequestPB& req
 }
 
 size_t CountVoters(const RaftConfigPB& config) {
-  return CountMemberType(config, PeerMemberType::VOTER);
+  return CountMemberType(config, PeerMemberType::VOTER) +
+         CountMemberType(config, PeerMemberType::WITNESS);
 }
 
 size_t CountVotersInTransition(const RaftConfigPB& config) {
@@ -201,7 +224,9 @@ PeerRole GetConsensusRole(const std::string& permanent_uuid, const ConsensusStat
   for (const RaftPeerPB& peer : cstate.config().peers()) {
     if (peer.permanent_uuid() == permanent_uuid) {
       switch (peer.member_type()) {
+        // WITNESS never becomes a leader, but otherwise participates in Raft as a follower.
         case PeerMemberType::VOTER:
+        case PeerMemberType::WITNESS:
           return PeerRole::FOLLOWER;
 
         // PRE_VOTER, PRE_OBSERVER peers are considered LEARNERs.
@@ -245,6 +270,12 @@ Status VerifyRaftConfig(const RaftConfigPB& config, RaftConfigState type) {
   }
 
   int num_peers = config.peers_size();
+  if (CountMemberType(config, PeerMemberType::WITNESS) != 0 &&
+      CountMemberType(config, PeerMemberType::VOTER) == 0) {
+    return STATUS(IllegalState,
+        Substitute("RaftConfig with witnesses must have at least one VOTER. RaftConfig: $0",
+                   config.ShortDebugString()));
+  }
   for (const RaftPeerPB& peer : config.peers()) {
     if (!peer.has_permanent_uuid() || peer.permanent_uuid() == "") {
       return STATUS(IllegalState, Substitute("One peer didn't have an uuid or had the empty"
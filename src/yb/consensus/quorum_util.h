@@ -54,8 +54,17 @@ enum RaftConfigState {
 };
 
 bool IsRaftConfigMember(const std::string& uuid, const RaftConfigPB& config);
+// Returns true if the peer is a VOTER, i.e. a replica with data that could become a leader.
 bool IsRaftConfigVoter(const std::string& uuid, const RaftConfigPB& config);
 
+bool IsRaftConfigWitness(const std::string& uuid, const RaftConfigPB& config);
+
+// Returns true if the peer votes in elections and counts towards the commit majority, i.e. it is
+// either a VOTER or a WITNESS.
+bool IsRaftConfigVotingMember(const std::string& uuid, const RaftConfigPB& config);
+
+bool IsVotingMemberType(PeerMemberType member_type);
+
 // Get the specified member of the config.
 // Returns Status::NotFound if a member with the specified uuid could not be
 // found in the config.
@@ -90,7 +99,7 @@ size_t CountMemberType(const RaftConfigPB& config,
                        const PeerMemberType member_type,
                        const std::string& ignore_uuid = "");
 
-// Counts the number of voters in the configuration.
+// Counts the number of voting members (VOTERs and WITNESSes) in the configuration.
 size_t CountVoters(const RaftConfigPB& config);
 
 // Counts the number of servers that are in transition (being bootstrapped) to become voters.
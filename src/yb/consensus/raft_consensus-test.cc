@@ -112,14 +112,16 @@ class MockQueue : public PeerMessageQueue {
                                             RestartSafeCoarseTimePoint time));
   MOCK_METHOD1(TrackPeer, void(const string&));
   MOCK_METHOD1(UntrackPeer, void(const string&));
-  MOCK_METHOD6(RequestForPeer, Status(const std::string& uuid,
+  MOCK_METHOD7(RequestForPeer, Status(const std::string& uuid,
                                       ConsensusRequestPB* request,
                                       ReplicateMsgsHolder* msgs_holder,
                                       bool* needs_remote_bootstrap,
                                       PeerMemberType* member_type,
-                                      bool* last_exchange_successful));
-  MOCK_METHOD2(ResponseFromPeer, bool(const std::string& peer_uuid,
-                                      const ConsensusResponsePB& response));
+                                      bool* last_exchange_successful,
+                                      Pipelined pipelined));
+  MOCK_METHOD3(ResponseFromPeer, bool(const std::string& peer_uuid,
+                                      const ConsensusResponsePB& response,
+                                      Pipelined pipelined));
   MOCK_METHOD0(Close, void());
 };
 
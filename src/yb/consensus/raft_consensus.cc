@@ -47,6 +47,7 @@
 #include "yb/consensus/consensus_round.h"
 #include "yb/consensus/leader_election.h"
 #include "yb/consensus/log.h"
+#include "yb/consensus/multi_raft_batcher.h"
 #include "yb/consensus/peer_manager.h"
 #include "yb/consensus/quorum_util.h"
 #include "yb/consensus/replica_state.h"
@@ -215,6 +216,12 @@ DEFINE_test_flag(int32, log_change_config_every_n, 1,
 
 DEFINE_bool(enable_lease_revocation, true, "Enables lease revocation mechanism");
 
+DEFINE_bool(enable_leader_lease_transfer, true,
+            "On graceful step down the old leader hands off its leases to the protege, so the "
+            "new leader does not have to wait for them to expire.");
+TAG_FLAG(enable_leader_lease_transfer, advanced);
+TAG_FLAG(enable_leader_lease_transfer, runtime);
+
 DEFINE_bool(quick_leader_election_on_create, false,
             "Do we trigger quick leader elections on table creation.");
 TAG_FLAG(quick_leader_election_on_create, advanced);
@@ -571,6 +578,14 @@ Status RaftConsensus::DoStartElection(const LeaderElectionData& data, PreElected
       return Status::OK();
     }
 
+    if (data.originator_term != OpId::kUnknownTerm &&
+        state_->GetCurrentTermUnlocked() > data.originator_term) {
+      LOG_WITH_PREFIX(INFO) << "Not starting " << election_name << " requested by "
+                            << data.originator_uuid << " in term " << data.originator_term
+                            << " -- current term is " << state_->GetCurrentTermUnlocked();
+      return Status::OK();
+    }
+
     PeerRole active_role = state_->GetActiveRoleUnlocked();
     if (active_role == PeerRole::LEADER) {
       LOG_WITH_PREFIX(INFO) << "Not starting " << election_name << " -- already leader";
@@ -582,6 +597,11 @@ Status RaftConsensus::DoStartElection(const LeaderElectionData& data, PreElected
                             << ", active_role=" << active_role;
       return Status::OK();
     }
+    if (IsRaftConfigWitness(state_->GetPeerUuid(), state_->GetActiveConfigUnlocked())) {
+      VLOG_WITH_PREFIX(1) << "Not starting " << election_name << " -- witness";
+      SnoozeFailureDetector(DO_NOT_LOG);
+      return Status::OK();
+    }
     if (PREDICT_FALSE(active_role == PeerRole::NON_PARTICIPANT)) {
       VLOG_WITH_PREFIX(1) << "Not starting " << election_name << " -- non participant";
       // Avoid excessive election noise while in this state.
@@ -743,15 +763,43 @@ Status RaftConsensus::StartStepDownUnlocked(const RaftPeerPB& peer, bool gracefu
   election_state->req.set_dest_uuid(peer.permanent_uuid());
   election_state->req.set_tablet_id(state_->GetOptions().tablet_id);
   election_state->rpc.set_invoke_callback_mode(rpc::InvokeCallbackMode::kThreadPoolHigh);
+
+  election_state->req.set_originator_term(state_->GetCurrentTermUnlocked());
+
+  // Reads in progress could have checked leadership before we step down and pick their read time
+  // afterwards. But a leader never serves reads above its majority replicated hybrid time lease.
+  // So capture the lease while holding the replica state lock, before BecomeReplicaUnlocked stops
+  // new reads and resets it. No read was or will be served by us above the transfer hybrid time.
+  HybridTime lease_transfer_ht;
+  if (GetAtomicFlag(&FLAGS_enable_leader_lease_transfer)) {
+    lease_transfer_ht = LeaseTransferHybridTimeUnlocked();
+  }
+
+  LOG_WITH_PREFIX(INFO) << "Transferring leadership to " << peer.permanent_uuid();
+
+  auto status = BecomeReplicaUnlocked(
+      graceful ? std::string() : peer.permanent_uuid(), MonoDelta());
+
+  if (status.ok() && lease_transfer_ht.is_valid()) {
+    election_state->req.set_leader_lease_transfer_ht(lease_transfer_ht.ToUint64());
+  }
+
   election_state->proxy->RunLeaderElectionAsync(
       &election_state->req, &election_state->resp, &election_state->rpc,
       std::bind(&RaftConsensus::RunLeaderElectionResponseRpcCallback, this,
           election_state));
 
-  LOG_WITH_PREFIX(INFO) << "Transferring leadership to " << peer.permanent_uuid();
+  return status;
+}
 
-  return BecomeReplicaUnlocked(
-      graceful ? std::string() : peer.permanent_uuid(), MonoDelta());
+HybridTime RaftConsensus::LeaseTransferHybridTimeUnlocked() {
+  auto ht_lease = state_->MajorityReplicatedHtLeaseExpiration(
+      /* min_allowed= */ 0, CoarseTimePoint::max());
+  if (!ht_lease.ok() || *ht_lease >= kMaxHybridTimePhysicalMicros) {
+    // Hybrid time leases are disabled, so reads are not bounded and leases could not be handed off.
+    return HybridTime::kInvalid;
+  }
+  return std::max(clock_->Now(), HybridTime(*ht_lease, /* logical= */ 0));
 }
 
 void RaftConsensus::CheckDelayedStepDown(const Status& status) {
@@ -985,6 +1033,34 @@ void RaftConsensus::ReportFailureDetectedTask() {
     outstanding_report_failure_task_.store(false, std::memory_order_release);
   });
 
+  // The leader of a quiescent tablet does not send heartbeats, but the leader server still sends
+  // liveness. It is valid while the term did not change and the leader server did not restart.
+  // If the leader stops leading the tablet while it is alive, it revokes the liveness of the tablet
+  // explicitly, see EndFollowerQuiescence.
+  if (follower_quiescent_.load(std::memory_order_acquire)) {
+    std::string leader_uuid;
+    bool same_term;
+    {
+      auto lock = state_->LockForRead();
+      leader_uuid = state_->GetLeaderUuidUnlocked();
+      same_term = state_->GetCurrentTermUnlocked() ==
+                  follower_quiescent_term_.load(std::memory_order_acquire);
+    }
+    auto election_timeout = MinimumElectionTimeout();
+    if (!leader_uuid.empty() && same_term &&
+        RaftLivenessTracker::Instance().IsAlive(
+            peer_uuid(), leader_uuid,
+            follower_quiescent_liveness_epoch_.load(std::memory_order_acquire),
+            election_timeout)) {
+      SnoozeFailureDetector(DO_NOT_LOG);
+      UpdateAtomicMax(&withhold_votes_until_, MonoTime::Now() + election_timeout);
+      return;
+    }
+    LOG_WITH_PREFIX(INFO) << "No liveness from leader " << leader_uuid
+                          << " of quiescent tablet";
+    follower_quiescent_.store(false, std::memory_order_release);
+  }
+
   MonoTime now;
   for (;;) {
     // Do not start election for an extended period of time if we were recently stepped down.
@@ -1044,6 +1120,7 @@ Status RaftConsensus::BecomeLeaderUnlocked() {
 
   // Disable FD while we are leader.
   DisableFailureDetector();
+  follower_quiescent_.store(false, std::memory_order_release);
 
   // Don't vote for anyone if we're a leader.
   withhold_votes_until_.store(MonoTime::Max(), std::memory_order_release);
@@ -1944,6 +2021,16 @@ Result<RaftConsensus::UpdateReplicaResult> RaftConsensus::UpdateReplica(
   // We are guaranteed to be acting as a FOLLOWER at this point by the above
   // sanity check.
   SnoozeFailureDetector(DO_NOT_LOG);
+  if (request->quiescent()) {
+    follower_quiescent_term_.store(request->caller_term(), std::memory_order_release);
+    follower_quiescent_liveness_epoch_.store(
+        request->liveness_epoch(), std::memory_order_release);
+  }
+  follower_quiescent_.store(request->quiescent(), std::memory_order_release);
+  if (request->has_data_replicas_applied_index()) {
+    data_replicas_applied_index_.store(
+        request->data_replicas_applied_index(), std::memory_order_release);
+  }
 
   auto now = MonoTime::Now();
 
@@ -2488,11 +2575,13 @@ Status RaftConsensus::ChangeConfig(const ChangeConfigRequestPB& req,
                         Substitute("Server must have member_type specified. Request: $0",
                                    req.ShortDebugString()));
         }
+        // WITNESS is added with its final member type, remote bootstrap only copies the log to it.
         if (server.member_type() != PeerMemberType::PRE_VOTER &&
-            server.member_type() != PeerMemberType::PRE_OBSERVER) {
+            server.member_type() != PeerMemberType::PRE_OBSERVER &&
+            server.member_type() != PeerMemberType::WITNESS) {
           return STATUS(InvalidArgument,
-              Substitute("Server with UUID $0 must be of member_type PRE_VOTER or PRE_OBSERVER. "
-                         "member_type received: $1", server_uuid,
+              Substitute("Server with UUID $0 must be of member_type PRE_VOTER, PRE_OBSERVER or "
+                         "WITNESS. member_type received: $1", server_uuid,
                          PeerMemberType_Name(server.member_type())));
         }
         if (server.last_known_private_addr().empty()) {
@@ -3036,6 +3125,42 @@ LeaderState RaftConsensus::GetLeaderState(bool allow_stale) const {
   return state_->GetLeaderState(allow_stale);
 }
 
+bool RaftConsensus::IsQuiescentLeader() const {
+  return peer_manager_->HasQuiescentPeers();
+}
+
+void RaftConsensus::EndFollowerQuiescence(const std::string& leader_uuid) {
+  if (!follower_quiescent_.load(std::memory_order_acquire)) {
+    return;
+  }
+  {
+    auto lock = state_->LockForRead();
+    if (state_->GetLeaderUuidUnlocked() != leader_uuid) {
+      return;
+    }
+  }
+  LOG_WITH_PREFIX(INFO) << "Leader " << leader_uuid << " no longer leads quiescent tablet";
+  follower_quiescent_.store(false, std::memory_order_release);
+}
+
+bool RaftConsensus::WakeIfQuiescent() {
+  if (!IsQuiescentLeader()) {
+    return false;
+  }
+  if (wake_quiescent_peers_scheduled_.exchange(true, std::memory_order_acq_rel)) {
+    return true;
+  }
+  auto status = raft_pool_token_->SubmitFunc([consensus = shared_from_this()] {
+    consensus->wake_quiescent_peers_scheduled_.store(false, std::memory_order_release);
+    consensus->peer_manager_->WakeQuiescentPeers();
+  });
+  if (!status.ok()) {
+    wake_quiescent_peers_scheduled_.store(false, std::memory_order_release);
+    LOG_WITH_PREFIX(WARNING) << "Failed to schedule waking quiescent peers: " << status;
+  }
+  return true;
+}
+
 std::string RaftConsensus::LogPrefix() {
   return state_->LogPrefix();
 }
@@ -3307,8 +3432,26 @@ void RaftConsensus::DoElectionCallback(const LeaderElectionData& data,
   LOG_WITH_PREFIX(INFO) << "Leader " << election_name << " won for term " << result.election_term;
 
   // Apply lease updates that were possible received from voters.
+  auto old_leader_lease = result.old_leader_lease;
+  auto old_leader_ht_lease = result.old_leader_ht_lease;
+  if (data.lease_transfer_ht.is_valid() && !data.originator_uuid.empty() &&
+      data.originator_term != OpId::kUnknownTerm &&
+      result.election_term == data.originator_term + 1) {
+    // Old leader handed off its leases. Once our clock is past the hybrid time it had when it
+    // stopped serving reads, we could serve reads and writes without waiting for them to expire.
+    // It holds only if nobody was elected between its term and ours, otherwise the old leader
+    // could have been elected again and served reads after that time.
+    clock_->Update(data.lease_transfer_ht);
+    if (old_leader_lease.holder_uuid == data.originator_uuid) {
+      old_leader_lease.Reset();
+    }
+    if (old_leader_ht_lease.holder_uuid == data.originator_uuid) {
+      old_leader_ht_lease.Reset();
+    }
+    state_->RevokeOldLeaderLeasesUnlocked(data.originator_uuid);
+  }
   state_->UpdateOldLeaderLeaseExpirationOnNonLeaderUnlocked(
-      result.old_leader_lease, result.old_leader_ht_lease);
+      old_leader_lease, old_leader_ht_lease);
 
   state_->SetLeaderNoOpCommittedUnlocked(false);
   // Convert role to LEADER.
@@ -188,6 +188,15 @@ class RaftConsensus : public std::enable_shared_from_this<RaftConsensus>,
 
   LeaderState GetLeaderState(bool allow_stale = false) const override;
 
+  bool WakeIfQuiescent() override;
+
+  // Whether this leader stopped heartbeating the tablet because it is idle.
+  bool IsQuiescentLeader() const;
+
+  // Invoked on a follower when the leader server reports that it stopped leading the quiescent
+  // tablet, so the follower stops relying on the liveness of the leader server.
+  void EndFollowerQuiescence(const std::string& leader_uuid);
+
   std::string peer_uuid() const override;
 
   std::string tablet_id() const override;
@@ -241,6 +250,12 @@ class RaftConsensus : public std::enable_shared_from_this<RaftConsensus>,
 
   yb::OpId MinRetryableRequestOpId();
 
+  // On a witness, the minimal index of an operation applied by all data-bearing replicas, as
+  // reported by the leader. 0 if not known yet.
+  int64_t DataReplicasAppliedIndex() const {
+    return data_replicas_applied_index_.load(std::memory_order_acquire);
+  }
+
   Status StartElection(const LeaderElectionData& data) override {
     return DoStartElection(data, PreElected::kFalse);
   }
@@ -650,6 +665,10 @@ class RaftConsensus : public std::enable_shared_from_this<RaftConsensus>,
   // of protege election failure.
   Status StartStepDownUnlocked(const RaftPeerPB& peer, bool graceful);
 
+  // Hybrid time above which this leader does not serve reads, sent to the protege on step down.
+  // Invalid if it could not be determined.
+  HybridTime LeaseTransferHybridTimeUnlocked();
+
   // Checked whether we should start step down when protege did not synchronize before timeout.
   void CheckDelayedStepDown(const Status& status);
 
@@ -713,6 +732,18 @@ class RaftConsensus : public std::enable_shared_from_this<RaftConsensus>,
 
   std::atomic<bool> outstanding_report_failure_task_{false};
 
+  // Set while a task that resumes heartbeats of a quiescent tablet is scheduled.
+  std::atomic<bool> wake_quiescent_peers_scheduled_{false};
+
+  // Set when the leader told this follower that the tablet is quiescent. While the leader server
+  // keeps sending node level liveness, detected leader failure does not start an election.
+  std::atomic<bool> follower_quiescent_{false};
+  // Term and liveness epoch of the leader when it told this follower that the tablet is quiescent.
+  std::atomic<int64_t> follower_quiescent_term_{0};
+  std::atomic<uint64_t> follower_quiescent_liveness_epoch_{0};
+
+  std::atomic<int64_t> data_replicas_applied_index_{0};
+
   AtomicBool shutdown_;
 
   scoped_refptr<Counter> follower_memory_pressure_rejections_;
@@ -1119,6 +1119,21 @@ Status ReplicaState::CheckOpInSequence(const yb::OpId& previous, const yb::OpId&
   return Status::OK();
 }
 
+void ReplicaState::RevokeOldLeaderLeasesUnlocked(const std::string& holder_uuid) {
+  if (old_leader_lease_ && old_leader_lease_.holder_uuid == holder_uuid) {
+    LOG_WITH_PREFIX(INFO)
+        << "Old leader " << holder_uuid << " handed off lease: "
+        << MonoDelta(old_leader_lease_.expiration - CoarseMonoClock::now());
+    old_leader_lease_.Reset();
+  }
+  if (old_leader_ht_lease_ && old_leader_ht_lease_.holder_uuid == holder_uuid) {
+    LOG_WITH_PREFIX(INFO)
+        << "Old leader " << holder_uuid << " handed off ht lease: "
+        << HybridTime::FromMicros(old_leader_ht_lease_.expiration);
+    old_leader_ht_lease_.Reset();
+  }
+}
+
 void ReplicaState::UpdateOldLeaderLeaseExpirationOnNonLeaderUnlocked(
     const CoarseTimeLease& lease, const PhysicalComponentLease& ht_lease) {
   old_leader_lease_.TryUpdate(lease);
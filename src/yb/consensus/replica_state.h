@@ -369,6 +369,9 @@ class ReplicaState {
   void UpdateOldLeaderLeaseExpirationOnNonLeaderUnlocked(
       const CoarseTimeLease& lease, const PhysicalComponentLease& ht_lease);
 
+  // Forgets the leases of the old leader with the specified uuid, after it handed them off.
+  void RevokeOldLeaderLeasesUnlocked(const std::string& holder_uuid);
+
   void SetMajorityReplicatedLeaseExpirationUnlocked(
       const MajorityReplicatedData& majority_replicated_data,
       EnumBitSet<SetMajorityReplicatedLeaseExpirationFlag> flags);
@@ -25,6 +25,7 @@
 #include "yb/docdb/docdb.pb.h"
 #include "yb/docdb/docdb_rocksdb_util.h"
 #include "yb/docdb/intent.h"
+#include "yb/docdb/intent_index.h"
 #include "yb/docdb/shared_lock_manager.h"
 #include "yb/docdb/transaction_dump.h"
 #include "yb/util/logging.h"
@@ -155,10 +156,11 @@ class ConflictResolver : public std::enable_shared_from_this<ConflictResolver> {
                    TransactionStatusManager* status_manager,
                    PartialRangeKeyIntents partial_range_key_intents,
                    std::unique_ptr<ConflictResolverContext> context,
+                   TransactionIdSet* blockers,
                    ResolutionCallback callback)
       : doc_db_(doc_db), status_manager_(*status_manager), request_scope_(status_manager),
         partial_range_key_intents_(partial_range_key_intents), context_(std::move(context)),
-        callback_(std::move(callback)) {}
+        blockers_(blockers), callback_(std::move(callback)) {}
 
   PartialRangeKeyIntents partial_range_key_intents() {
     return partial_range_key_intents_;
@@ -209,13 +211,30 @@ class ConflictResolver : public std::enable_shared_from_this<ConflictResolver> {
     return STATUS(NotSupported, "Unknown wait policy.");
   }
 
-  // Reads conflicts for specified intent from DB.
+  // Reads conflicts for specified intent from intent index if it is available, otherwise from DB.
   Status ReadIntentConflicts(IntentTypeSet type, KeyBytes* intent_key_prefix,
                                      WaitPolicy wait_policy) {
-    EnsureIntentIteratorCreated();
-
     const auto conflicting_intent_types = kIntentTypeSetConflicts[type.ToUIntPtr()];
 
+    if (doc_db_.intent_index) {
+      boost::container::small_vector<IndexedIntent, 8> intents;
+      if (doc_db_.intent_index->Lookup(intent_key_prefix->AsSlice(), &intents)) {
+        VLOG_WITH_PREFIX_AND_FUNC(4) << "Check conflicts in intent index: "
+                                     << intent_key_prefix->AsSlice().ToDebugHexString()
+                                     << " for type " << ToString(type) << ", found "
+                                     << intents.size();
+        for (const auto& intent : intents) {
+          if ((conflicting_intent_types & kIntentTypeSetMask[intent.types.ToUIntPtr()]) != 0) {
+            RETURN_NOT_OK(AddConflict(
+                intent.transaction_id, intent.subtransaction_id, intent.lock_only, wait_policy));
+          }
+        }
+        return Status::OK();
+      }
+    }
+
+    EnsureIntentIteratorCreated();
+
     KeyBytes upperbound_key(*intent_key_prefix);
     upperbound_key.AppendKeyEntryType(KeyEntryType::kMaxByte);
     intent_key_upperbound_ = upperbound_key.AsSlice();
@@ -263,20 +282,9 @@ class ConflictResolver : public std::enable_shared_from_this<ConflictResolver> {
           HasStrong(existing_intent.types)));
       const auto intent_mask = kIntentTypeSetMask[existing_intent.types.ToUIntPtr()];
       if ((conflicting_intent_types & intent_mask) != 0) {
-        auto transaction_id = decoded_value.transaction_id;
-        bool lock_only = decoded_value.body.starts_with(KeyEntryTypeAsChar::kRowLock);
-
-        if (!context_->IgnoreConflictsWith(transaction_id)) {
-          auto p = conflicts_.emplace(transaction_id,
-                                      TransactionConflictInfo {
-                                        .wait_policy = wait_policy
-                                      });
-          if (!p.second) {
-            p.first->second.wait_policy = VERIFY_RESULT(
-                CombineWaitPolicy(p.first->second.wait_policy, wait_policy));
-          }
-          p.first->second.subtransactions[decoded_value.subtransaction_id] |= !lock_only;
-        }
+        RETURN_NOT_OK(AddConflict(
+            decoded_value.transaction_id, decoded_value.subtransaction_id,
+            decoded_value.body.starts_with(KeyEntryTypeAsChar::kRowLock), wait_policy));
       }
 
       intent_iter_.Next();
@@ -285,6 +293,24 @@ class ConflictResolver : public std::enable_shared_from_this<ConflictResolver> {
     return Status::OK();
   }
 
+  Status AddConflict(
+      const TransactionId& transaction_id, SubTransactionId subtransaction_id, bool lock_only,
+      WaitPolicy wait_policy) {
+    if (context_->IgnoreConflictsWith(transaction_id)) {
+      return Status::OK();
+    }
+    auto p = conflicts_.emplace(transaction_id,
+                                TransactionConflictInfo {
+                                  .wait_policy = wait_policy
+                                });
+    if (!p.second) {
+      p.first->second.wait_policy = VERIFY_RESULT(
+          CombineWaitPolicy(p.first->second.wait_policy, wait_policy));
+    }
+    p.first->second.subtransactions[subtransaction_id] |= !lock_only;
+    return Status::OK();
+  }
+
   void EnsureIntentIteratorCreated() {
     if (!intent_iter_.Initialized()) {
       intent_iter_ = CreateRocksDBIterator(
@@ -367,7 +393,17 @@ class ConflictResolver : public std::enable_shared_from_this<ConflictResolver> {
       return true;
     }
 
-    RETURN_NOT_OK(context_->CheckPriority(this, RemainingTransactions()));
+    auto status = context_->CheckPriority(this, RemainingTransactions());
+    if (!status.ok()) {
+      // Conflicting transactions are still running and have higher priority, so the caller
+      // could wait for them instead of failing.
+      if (blockers_ && TransactionError(status) == TransactionErrorCode::kConflict) {
+        for (const auto& transaction : RemainingTransactions()) {
+          blockers_->insert(transaction.id);
+        }
+      }
+      return status;
+    }
 
     AbortTransactions();
     return false;
@@ -549,6 +585,7 @@ class ConflictResolver : public std::enable_shared_from_this<ConflictResolver> {
   RequestScope request_scope_;
   PartialRangeKeyIntents partial_range_key_intents_;
   std::unique_ptr<ConflictResolverContext> context_;
+  TransactionIdSet* blockers_;
   ResolutionCallback callback_;
 
   BoundedRocksDbIterator intent_iter_;
@@ -896,30 +933,36 @@ class TransactionConflictResolverContext : public ConflictResolverContextBase {
     VLOG_WITH_PREFIX_AND_FUNC(4) << "Check txn's conflicts for following intents: "
                                  << AsString(container);
 
-    StrongConflictChecker checker(
-        *transaction_id_, read_time_, resolver, GetConflictsMetric(), &buffer);
-    // Iterator on intents DB should be created before iterator on regular DB.
+    // Intents should be read before regular DB.
     // This is to prevent the case when we create an iterator on the regular DB where a
-    // provisional record has not yet been applied, and then create an iterator the intents
-    // DB where the provisional record has already been removed.
-    resolver->EnsureIntentIteratorCreated();
-
+    // provisional record has not yet been applied, and then read intents DB (or intent index)
+    // where the provisional record has already been removed.
+    if (!resolver->doc_db().intent_index) {
+      resolver->EnsureIntentIteratorCreated();
+    }
     for (const auto& i : container) {
-      if (read_time_ != HybridTime::kMax) {
-        const Slice intent_key = i.first.AsSlice();
-        bool strong = HasStrong(i.second.types);
-        // For strong intents or weak intents at a full document key level (i.e. excluding intents
-        // that omit some final range components of the document key), check for conflicts with
-        // records in regular RocksDB. We need this because the row might have been deleted
-        // concurrently by a single-shard transaction or a committed and applied transaction.
-        if (strong || i.second.full_doc_key) {
-          RETURN_NOT_OK(checker.Check(intent_key, strong, wait_policy));
-        }
-      }
       buffer.Reset(i.first.AsSlice());
       RETURN_NOT_OK(resolver->ReadIntentConflicts(i.second.types, &buffer, wait_policy));
     }
 
+    if (read_time_ == HybridTime::kMax) {
+      return Status::OK();
+    }
+
+    StrongConflictChecker checker(
+        *transaction_id_, read_time_, resolver, GetConflictsMetric(), &buffer);
+    for (const auto& i : container) {
+      const Slice intent_key = i.first.AsSlice();
+      bool strong = HasStrong(i.second.types);
+      // For strong intents or weak intents at a full document key level (i.e. excluding intents
+      // that omit some final range components of the document key), check for conflicts with
+      // records in regular RocksDB. We need this because the row might have been deleted
+      // concurrently by a single-shard transaction or a committed and applied transaction.
+      if (strong || i.second.full_doc_key) {
+        RETURN_NOT_OK(checker.Check(intent_key, strong, wait_policy));
+      }
+    }
+
     return Status::OK();
   }
 
@@ -1094,13 +1137,15 @@ void ResolveTransactionConflicts(const DocOperations& doc_ops,
                                  PartialRangeKeyIntents partial_range_key_intents,
                                  TransactionStatusManager* status_manager,
                                  Counter* conflicts_metric,
+                                 TransactionIdSet* blockers,
                                  ResolutionCallback callback) {
   DCHECK(hybrid_time.is_valid());
   TRACE("ResolveTransactionConflicts");
   auto context = std::make_unique<TransactionConflictResolverContext>(
       doc_ops, write_batch, hybrid_time, read_time, conflicts_metric);
   auto resolver = std::make_shared<ConflictResolver>(
-      doc_db, status_manager, partial_range_key_intents, std::move(context), std::move(callback));
+      doc_db, status_manager, partial_range_key_intents, std::move(context), blockers,
+      std::move(callback));
   // Resolve takes a self reference to extend lifetime.
   resolver->Resolve();
   TRACE("resolver->Resolve done");
@@ -1117,7 +1162,8 @@ void ResolveOperationConflicts(const DocOperations& doc_ops,
   auto context = std::make_unique<OperationConflictResolverContext>(&doc_ops, resolution_ht,
                                                                     conflicts_metric);
   auto resolver = std::make_shared<ConflictResolver>(
-      doc_db, status_manager, partial_range_key_intents, std::move(context), std::move(callback));
+      doc_db, status_manager, partial_range_key_intents, std::move(context),
+      nullptr /* blockers */, std::move(callback));
   // Resolve takes a self reference to extend lifetime.
   resolver->Resolve();
   TRACE("resolver->Resolve done");
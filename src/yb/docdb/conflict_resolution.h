@@ -48,6 +48,8 @@ using ResolutionCallback = boost::function<void(const Result<HybridTime>&)>;
 // db - db that contains tablet data.
 // status_manager - status manager that should be used during this conflict resolution.
 // conflicts_metric - transaction_conflicts metric to update.
+// blockers - if not null, filled with running transactions that we could not abort, when
+//            resolution fails because of them. So caller could wait for them and retry.
 void ResolveTransactionConflicts(const DocOperations& doc_ops,
                                  const KeyValueWriteBatchPB& write_batch,
                                  HybridTime resolution_ht,
@@ -56,6 +58,7 @@ void ResolveTransactionConflicts(const DocOperations& doc_ops,
                                  PartialRangeKeyIntents partial_range_key_intents,
                                  TransactionStatusManager* status_manager,
                                  Counter* conflicts_metric,
+                                 TransactionIdSet* blockers,
                                  ResolutionCallback callback);
 
 // Resolves conflicts for doc operations.
@@ -732,5 +732,24 @@ TEST_F(DocKeyTest, TestEnumerateIntents) {
   }
 }
 
+TEST_F(DocKeyTest, DecodeEncodedKeyEntryValue) {
+  auto encoded = DocKey(KeyEntryValues("val1", 1000, "val2", 2000)).Encode();
+  DocKeyDecoder decoder(encoded.AsSlice());
+  ASSERT_OK(decoder.DecodeToRangeGroup());
+  auto first = ASSERT_RESULT(decoder.DecodeEncodedKeyEntryValue());
+  auto second = ASSERT_RESULT(decoder.DecodeEncodedKeyEntryValue());
+  ASSERT_EQ(first, KeyEntryValue("val1").ToKeyBytes().AsSlice());
+  ASSERT_EQ(second, KeyEntryValue::Create(1000).ToKeyBytes().AsSlice());
+
+  // Encoded values preserve ordering of decoded ones.
+  auto third = ASSERT_RESULT(decoder.DecodeEncodedKeyEntryValue());
+  ASSERT_LT(first.compare(third), 0);
+
+  KeyEntryValue decoded;
+  ASSERT_OK(KeyEntryValue::DecodeKey(&third, &decoded));
+  ASSERT_EQ(decoded, KeyEntryValue("val2"));
+  ASSERT_TRUE(third.empty());
+}
+
 }  // namespace docdb
 }  // namespace yb
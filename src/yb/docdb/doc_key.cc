@@ -1306,6 +1306,12 @@ Status DocKeyDecoder::DecodeKeyEntryValue(AllowSpecial allow_special) {
   return DecodeKeyEntryValue(nullptr /* out */, allow_special);
 }
 
+Result<Slice> DocKeyDecoder::DecodeEncodedKeyEntryValue(AllowSpecial allow_special) {
+  const auto* start = input_.data();
+  RETURN_NOT_OK(DecodeKeyEntryValue(nullptr /* out */, allow_special));
+  return Slice(start, input_.data());
+}
+
 Status DocKeyDecoder::DecodeKeyEntryValue(KeyEntryValue* out, AllowSpecial allow_special) {
   if (allow_special &&
       !input_.empty() &&
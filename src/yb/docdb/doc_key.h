@@ -410,6 +410,11 @@ class DocKeyDecoder {
 
   Status DecodeKeyEntryValue(AllowSpecial allow_special);
 
+  // Skips next key entry value and returns its encoded representation, without materializing the
+  // value. Encoded values preserve DocDB ordering, so they could be compared with each other
+  // directly, and decoded on demand with KeyEntryValue::DecodeKey.
+  Result<Slice> DecodeEncodedKeyEntryValue(AllowSpecial allow_special = AllowSpecial::kFalse);
+
   Status ConsumeGroupEnd();
 
   bool GroupEnded() const;
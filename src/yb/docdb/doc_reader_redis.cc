@@ -74,6 +74,52 @@ void SeekToLowerBound(const SliceKeyBound& lower_bound, IntentAwareIterator* ite
   }
 }
 
+// Updates exp with the TTL of a value written at write_time at the subdocument key itself, which
+// is inherited by the whole subdocument. Returns true if the value is expired at read_ht.
+bool UpdateExpiration(
+    DocHybridTime write_time, const Value& doc_value, HybridTime read_ht, Expiration* exp) {
+  // We may need to update the TTL in individual columns.
+  if (write_time.hybrid_time() >= exp->write_ht) {
+    // We want to keep the default TTL otherwise.
+    if (doc_value.ttl() != ValueControlFields::kMaxTtl) {
+      exp->write_ht = write_time.hybrid_time();
+      exp->ttl = doc_value.ttl();
+    } else if (exp->ttl.IsNegative()) {
+      exp->ttl = -exp->ttl;
+    }
+  }
+
+  // If the hybrid time is kMin, then we must be using default TTL.
+  if (exp->write_ht == HybridTime::kMin) {
+    exp->write_ht = write_time.hybrid_time();
+  }
+
+  return HasExpiredTTL(exp->write_ht, exp->ttl, read_ht);
+}
+
+// Sets the write time of a primitive value, choosing the user supplied timestamp if present.
+void SetWriteTime(DocHybridTime write_time, Value* doc_value) {
+  const UserTimeMicros user_timestamp = doc_value->user_timestamp();
+  doc_value->mutable_primitive_value()->SetWriteTime(
+      user_timestamp == ValueControlFields::kInvalidUserTimestamp
+      ? write_time.hybrid_time().GetPhysicalValueMicros()
+      : user_timestamp);
+}
+
+// Adds descendant to the object subdocument at the path given by key_suffix, which consists of one
+// or more encoded subkeys.
+Status AddDescendant(Slice key_suffix, SubDocument descendant, SubDocument* current) {
+  for (;;) {
+    KeyEntryValue child;
+    RETURN_NOT_OK(child.DecodeFromKey(&key_suffix));
+    if (key_suffix.empty()) {
+      current->SetChild(child, std::move(descendant));
+      return Status::OK();
+    }
+    current = current->GetOrAddChild(child).first;
+  }
+}
+
 // This function does not assume that object init_markers are present. If no init marker is present,
 // or if a tombstone is found at some level, it still looks for subkeys inside it if they have
 // larger timestamps.
@@ -134,24 +180,8 @@ Status BuildSubDocument(
       if (write_time == DocHybridTime::kMin)
         return STATUS(Corruption, "No hybrid timestamp found on entry");
 
-      // We may need to update the TTL in individual columns.
-      if (write_time.hybrid_time() >= data.exp.write_ht) {
-        // We want to keep the default TTL otherwise.
-        if (doc_value.ttl() != ValueControlFields::kMaxTtl) {
-          data.exp.write_ht = write_time.hybrid_time();
-          data.exp.ttl = doc_value.ttl();
-        } else if (data.exp.ttl.IsNegative()) {
-          data.exp.ttl = -data.exp.ttl;
-        }
-      }
-
-      // If the hybrid time is kMin, then we must be using default TTL.
-      if (data.exp.write_ht == HybridTime::kMin) {
-        data.exp.write_ht = write_time.hybrid_time();
-      }
-
       // Treat an expired value as a tombstone written at the same time as the original value.
-      if (HasExpiredTTL(data.exp.write_ht, data.exp.ttl, iter->read_time().read)) {
+      if (UpdateExpiration(write_time, doc_value, iter->read_time().read, &data.exp)) {
         doc_value = Value::Tombstone();
         value_type = ValueEntryType::kTombstone;
       }
@@ -180,12 +210,7 @@ Status BuildSubDocument(
         }
         continue;
       } else if (IsPrimitiveValueType(value_type)) {
-        // Choose the user supplied timestamp if present.
-        const UserTimeMicros user_timestamp = doc_value.user_timestamp();
-        doc_value.mutable_primitive_value()->SetWriteTime(
-            user_timestamp == ValueControlFields::kInvalidUserTimestamp
-            ? write_time.hybrid_time().GetPhysicalValueMicros()
-            : doc_value.user_timestamp());
+        SetWriteTime(write_time, &doc_value);
         if (!data.high_index->CanInclude(current_values_observed)) {
           iter->SeekOutOfSubDoc(&key_copy);
           return Status::OK();
@@ -259,19 +284,118 @@ Status BuildSubDocument(
     } else {
       Slice temp = key;
       temp.remove_prefix(data.subdocument_key.size());
-      for (;;) {
-        KeyEntryValue child;
-        RETURN_NOT_OK(child.DecodeFromKey(&temp));
-        if (temp.empty()) {
-          current->SetChild(child, std::move(descendant));
-          break;
+      RETURN_NOT_OK(AddDescendant(temp, std::move(descendant), current));
+    }
+  }
+
+  return Status::OK();
+}
+
+// Converts a rank bound counted from the start of a subdocument with num_leaves leaves into a rank
+// bound of the opposite kind counted from its end.
+IndexBound IndexBoundFromEnd(const IndexBound& bound, int64 num_leaves, bool is_lower) {
+  return bound.index() == -1 ? IndexBound() : IndexBound(num_leaves - 1 - bound.index(), is_lower);
+}
+
+// Builds the subdocument at data.subdocument_key out of its leaves, walking them backwards from the
+// last one with the rank bounds in data counted from the end. So reading the last few children of
+// a large subdocument does not need to go through all the ones before them. Leaves are handled in
+// the same way as by BuildSubDocument, but they are visited before their parents. So if an entry
+// that could overwrite some of the leaves is found at an intermediate level of the subdocument,
+// false is returned and the subdocument should be read from the start instead.
+// Converting the rank bounds relies on data.num_leaves being the number of live leaves. It is
+// checked whenever the walk goes through all the leaves, or the bounds include the first leaf, and
+// false is returned if it does not match.
+Result<bool> BuildSubDocumentFromEnd(
+    IntentAwareIterator* iter,
+    const GetRedisSubDocumentData& data,
+    DocHybridTime low_ts) {
+  VLOG(3) << "BuildSubDocumentFromEnd data: " << data << " read_time: " << iter->read_time()
+          << " low_ts: " << low_ts;
+  DCHECK(!*data.low_subkey && !*data.high_subkey && data.limit == 0 && !data.count_only);
+  DCHECK_GE(data.num_leaves, 0);
+  const auto low_index = IndexBoundFromEnd(
+      *data.high_index, data.num_leaves, true /* is_lower */);
+  const auto high_index = IndexBoundFromEnd(
+      *data.low_index, data.num_leaves, false /* is_lower */);
+
+  KeyBytes key_copy(data.subdocument_key);
+  key_copy.AppendKeyEntryType(KeyEntryType::kMaxByte);
+  iter->PrevSubDocKey(key_copy);
+
+  // The previously visited key, used to detect entries at intermediate levels.
+  KeyBytes prev_key;
+  // Once the high bound is reached, the rest of the top level child of the last added leaf is
+  // still checked for intermediate entries.
+  KeyBytes last_added_child;
+  bool high_bound_reached = false;
+  // Whether the walk stopped before going through all the leaves.
+  bool stopped_early = false;
+  int64 num_values_observed = 0;
+  while (iter->valid()) {
+    if (data.deadline_info && data.deadline_info->CheckAndSetDeadlinePassed()) {
+      return STATUS(Expired, "Deadline for query passed.");
+    }
+    auto key_data = VERIFY_RESULT(iter->FetchKey());
+    if (!key_data.key.starts_with(data.subdocument_key) ||
+        key_data.key.size() == data.subdocument_key.size() ||
+        (high_bound_reached && !key_data.key.starts_with(last_added_child.AsSlice()))) {
+      break;
+    }
+    // Key could be invalidated because we move the iterator, so back it up.
+    key_copy.Reset(key_data.key);
+    const auto write_time = key_data.write_time;
+
+    if (low_ts <= write_time) {
+      Value doc_value;
+      RETURN_NOT_OK(doc_value.Decode(iter->value()));
+      if (prev_key.AsSlice().starts_with(key_copy)) {
+        VLOG(3) << "Found intermediate entry: " << SubDocKey::DebugSliceToString(key_copy);
+        return false;
+      }
+      Expiration exp = data.exp;
+      if (!high_bound_reached && IsPrimitiveValueType(doc_value.value_type()) &&
+          !UpdateExpiration(write_time, doc_value, iter->read_time().read, &exp)) {
+        if (!high_index.CanInclude(num_values_observed)) {
+          if (data.low_index->index() == 0) {
+            VLOG(3) << "More than " << data.num_leaves << " leaves found";
+            return false;
+          }
+          stopped_early = true;
+          if (last_added_child.empty() || !key_copy.AsSlice().starts_with(last_added_child)) {
+            break;
+          }
+          high_bound_reached = true;
+        } else {
+          if (low_index.CanInclude(num_values_observed)) {
+            SetWriteTime(write_time, &doc_value);
+            if (!IsObjectType(data.result->value_type())) {
+              *data.result = SubDocument();
+            }
+            Slice temp = key_copy.AsSlice();
+            temp.remove_prefix(data.subdocument_key.size());
+            RETURN_NOT_OK(AddDescendant(
+                temp, SubDocument(doc_value.primitive_value()), data.result));
+            KeyEntryValue child;
+            RETURN_NOT_OK(child.DecodeFromKey(&temp));
+            last_added_child.Reset(Slice(key_copy.AsSlice().data(), temp.data()));
+          }
+          ++num_values_observed;
         }
-        current = current->GetOrAddChild(child).first;
       }
     }
+    prev_key.Reset(key_copy.AsSlice());
+
+    VLOG(4) << "PrevSubDocKey: " << SubDocKey::DebugSliceToString(key_copy);
+    iter->PrevSubDocKey(key_copy);
   }
 
-  return Status::OK();
+  if (!stopped_early && num_values_observed != data.num_leaves) {
+    VLOG(3) << "Found " << num_values_observed << " leaves, while " << data.num_leaves
+            << " expected";
+    return false;
+  }
+  return true;
 }
 
 // If there is a key equal to key_bytes_without_ht + some timestamp, which is later than
@@ -453,8 +577,19 @@ yb::Status GetRedisSubDocument(
     *data.result = SubDocument(ValueEntryType::kInvalid);
     int64 num_values_observed = 0;
     IntentAwareIteratorPrefixScope prefix_scope(key_slice, db_iter);
-    RETURN_NOT_OK(BuildSubDocument(db_iter, data, max_overwrite_ht,
-                                   &num_values_observed));
+    bool built = false;
+    if (data.read_from_end) {
+      built = VERIFY_RESULT(BuildSubDocumentFromEnd(db_iter, data, max_overwrite_ht));
+      if (!built) {
+        // Fall back to reading from the start.
+        *data.result = SubDocument(ValueEntryType::kInvalid);
+        db_iter->Seek(key_slice);
+      }
+    }
+    if (!built) {
+      RETURN_NOT_OK(BuildSubDocument(db_iter, data, max_overwrite_ht,
+                                     &num_values_observed));
+    }
     *data.doc_found = data.result->value_type() != ValueEntryType::kInvalid;
     if (*data.doc_found) {
       if (value_type == ValueEntryType::kRedisSet) {
@@ -94,6 +94,11 @@ class IndexBound {
     return is_lower_bound_ ? index_ <= curr_index : index_ >= curr_index;
   }
 
+  // Returns the bound index, or -1 for an empty bound.
+  int64 index() const {
+    return index_;
+  }
+
   static const IndexBound& Empty();
 
  private:
@@ -133,6 +138,14 @@ struct GetRedisSubDocumentData {
   const IndexBound* high_index = &IndexBound::Empty();
   // Maximum number of children to add for this subdocument (0 means no limit).
   size_t limit = 0;
+  // Read the subdocument starting from its last leaf, so that rank bounds close to the end do not
+  // require going through all the leaves before them. num_leaves should be set to the number of
+  // leaves in the subdocument, e.g. the cardinality of a sorted set. Only rank bounds are
+  // supported in this mode. If there is an entry at an intermediate level of the subdocument, or
+  // the number of leaves found does not match num_leaves, it is read from the start instead.
+  // Reading rank range [low, high] from the end visits O(num_leaves - low) leaves.
+  bool read_from_end = false;
+  int64 num_leaves = -1;
   // Only store a count of the number of records found, but don't store the records themselves.
   bool count_only = false;
   // Stores the count of records found, if count_only option is set.
@@ -149,6 +162,8 @@ struct GetRedisSubDocumentData {
     result.low_index = low_index;
     result.high_index = high_index;
     result.limit = limit;
+    result.read_from_end = read_from_end;
+    result.num_leaves = num_leaves;
     return result;
   }
 
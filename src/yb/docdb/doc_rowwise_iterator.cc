@@ -68,6 +68,50 @@ using std::string;
 namespace yb {
 namespace docdb {
 
+namespace {
+
+// Encoded key entry values preserve DocDB ordering, so scan choices keep their options encoded and
+// compare them with components of encoded keys directly, without decoding those components.
+KeyBytes EncodeKeyEntryValue(const KeyEntryValue& value) {
+  KeyBytes result;
+  value.AppendToKey(&result);
+  return result;
+}
+
+std::vector<KeyBytes> EncodeKeyEntryValues(const std::vector<KeyEntryValue>& values) {
+  std::vector<KeyBytes> result;
+  result.reserve(values.size());
+  for (const auto& value : values) {
+    result.push_back(EncodeKeyEntryValue(value));
+  }
+  return result;
+}
+
+bool EncodedLess(const KeyBytes& lhs, const Slice& rhs) {
+  return lhs.AsSlice().compare(rhs) < 0;
+}
+
+bool EncodedGreater(const KeyBytes& lhs, const Slice& rhs) {
+  return lhs.AsSlice().compare(rhs) > 0;
+}
+
+const KeyBytes& EncodedLowest() {
+  static const KeyBytes result = EncodeKeyEntryValue(KeyEntryValue(KeyEntryType::kLowest));
+  return result;
+}
+
+const KeyBytes& EncodedHighest() {
+  static const KeyBytes result = EncodeKeyEntryValue(KeyEntryValue(KeyEntryType::kHighest));
+  return result;
+}
+
+bool IsEncodedInfinity(const Slice& value) {
+  return value.size() == 1 &&
+         (value[0] == KeyEntryTypeAsChar::kLowest || value[0] == KeyEntryTypeAsChar::kHighest);
+}
+
+} // namespace
+
 class ScanChoices {
  public:
   explicit ScanChoices(bool is_forward_scan) : is_forward_scan_(is_forward_scan) {}
@@ -107,11 +151,7 @@ class DiscreteScanChoices : public ScanChoices {
   DiscreteScanChoices(const DocQLScanSpec& doc_spec, const KeyBytes& lower_doc_key,
                       const KeyBytes& upper_doc_key)
       : ScanChoices(doc_spec.is_forward_scan()) {
-    range_cols_scan_options_ = doc_spec.range_options();
-    current_scan_target_idxs_.resize(range_cols_scan_options_->size());
-    for (size_t i = 0; i < range_cols_scan_options_->size(); i++) {
-      current_scan_target_idxs_[i] = range_cols_scan_options_->at(i).begin();
-    }
+    InitOptions(*doc_spec.range_options());
 
     // Initialize target doc key.
     if (is_forward_scan_) {
@@ -130,11 +170,7 @@ class DiscreteScanChoices : public ScanChoices {
   DiscreteScanChoices(const DocPgsqlScanSpec& doc_spec, const KeyBytes& lower_doc_key,
                       const KeyBytes& upper_doc_key)
       : ScanChoices(doc_spec.is_forward_scan()) {
-    range_cols_scan_options_ = doc_spec.range_options();
-    current_scan_target_idxs_.resize(range_cols_scan_options_->size());
-    for (size_t i = 0; i < range_cols_scan_options_->size(); i++) {
-      current_scan_target_idxs_[i] = (*range_cols_scan_options_)[i].begin();
-    }
+    InitOptions(*doc_spec.range_options());
 
     // Initialize target doc key.
     if (is_forward_scan_) {
@@ -167,17 +203,28 @@ class DiscreteScanChoices : public ScanChoices {
   Result<bool> InitScanTargetRangeGroupIfNeeded();
 
  private:
+  void InitOptions(const std::vector<std::vector<KeyEntryValue>>& range_options) {
+    range_cols_scan_options_.reserve(range_options.size());
+    for (const auto& options : range_options) {
+      range_cols_scan_options_.push_back(EncodeKeyEntryValues(options));
+    }
+    current_scan_target_idxs_.resize(range_cols_scan_options_.size());
+    for (size_t i = 0; i < range_cols_scan_options_.size(); i++) {
+      current_scan_target_idxs_[i] = range_cols_scan_options_[i].begin();
+    }
+  }
+
   // For (multi)key scans (e.g. selects with 'IN' condition on the range columns) we hold the
   // options for each range column as we iteratively seek to each target key.
   // e.g. for a query "h = 1 and r1 in (2,3) and r2 in (4,5) and r3 = 6":
-  //  range_cols_scan_options_   [[2, 3], [4, 5], [6]] -- value options for each column.
+  //  range_cols_scan_options_   [[2, 3], [4, 5], [6]] -- encoded value options for each column.
   //  current_scan_target_idxs_  goes from [0, 0, 0] up to [1, 1, 0] -- except when including the
   //                             static row when it starts from [0, 0, -1] instead.
   //  current_scan_target_       goes from [1][2,4,6] up to [1][3,5,6] -- is the doc key containing,
   //                             for each range column, the value (option) referenced by the
   //                             corresponding index (updated along with current_scan_target_idxs_).
-  std::shared_ptr<std::vector<std::vector<KeyEntryValue>>> range_cols_scan_options_;
-  mutable std::vector<std::vector<KeyEntryValue>::const_iterator> current_scan_target_idxs_;
+  std::vector<std::vector<KeyBytes>> range_cols_scan_options_;
+  mutable std::vector<std::vector<KeyBytes>::const_iterator> current_scan_target_idxs_;
 };
 
 Status DiscreteScanChoices::IncrementScanTargetAtColumn(size_t start_col) {
@@ -186,7 +233,7 @@ Status DiscreteScanChoices::IncrementScanTargetAtColumn(size_t start_col) {
   // Increment start col, move backwards in case of overflow.
   ssize_t col_idx = start_col;
   for (; col_idx >= 0; col_idx--) {
-    const auto& choices = (*range_cols_scan_options_)[col_idx];
+    const auto& choices = range_cols_scan_options_[col_idx];
     auto& it = current_scan_target_idxs_[col_idx];
 
     if (++it != choices.end()) {
@@ -211,7 +258,7 @@ Status DiscreteScanChoices::IncrementScanTargetAtColumn(size_t start_col) {
       decoder.left_input().cdata() - current_scan_target_.AsSlice().cdata());
 
   for (size_t i = col_idx; i <= start_col; ++i) {
-    current_scan_target_idxs_[i]->AppendToKey(&current_scan_target_);
+    current_scan_target_.AppendRawBytes(current_scan_target_idxs_[i]->AsSlice());
   }
 
   return Status::OK();
@@ -224,8 +271,8 @@ Result<bool> DiscreteScanChoices::InitScanTargetRangeGroupIfNeeded() {
   // Initialize the range key values if needed (i.e. we scanned the static row until now).
   if (!VERIFY_RESULT(decoder.HasPrimitiveValue())) {
     current_scan_target_.mutable_data()->pop_back();
-    for (size_t col_idx = 0; col_idx < range_cols_scan_options_->size(); col_idx++) {
-      current_scan_target_idxs_[col_idx]->AppendToKey(&current_scan_target_);
+    for (size_t col_idx = 0; col_idx < range_cols_scan_options_.size(); col_idx++) {
+      current_scan_target_.AppendRawBytes(current_scan_target_idxs_[col_idx]->AsSlice());
     }
     current_scan_target_.AppendKeyEntryType(KeyEntryType::kGroupEnd);
     return true;
@@ -239,7 +286,7 @@ Status DiscreteScanChoices::DoneWithCurrentTarget() {
 
   // Initialize the first target/option if not done already, otherwise go to the next one.
   if (!VERIFY_RESULT(InitScanTargetRangeGroupIfNeeded())) {
-    RETURN_NOT_OK(IncrementScanTargetAtColumn(range_cols_scan_options_->size() - 1));
+    RETURN_NOT_OK(IncrementScanTargetAtColumn(range_cols_scan_options_.size() - 1));
     current_scan_target_.AppendKeyEntryType(KeyEntryType::kGroupEnd);
   }
   return Status::OK();
@@ -256,24 +303,23 @@ Status DiscreteScanChoices::SkipTargetsUpTo(const Slice& new_target) {
   current_scan_target_.Reset(Slice(new_target.data(), decoder.left_input().data()));
 
   size_t col_idx = 0;
-  KeyEntryValue target_value;
-  while (col_idx < range_cols_scan_options_->size()) {
-    RETURN_NOT_OK(decoder.DecodeKeyEntryValue(&target_value));
-    const auto& choices = (*range_cols_scan_options_)[col_idx];
+  while (col_idx < range_cols_scan_options_.size()) {
+    auto target_value = VERIFY_RESULT(decoder.DecodeEncodedKeyEntryValue());
+    const auto& choices = range_cols_scan_options_[col_idx];
     auto& it = current_scan_target_idxs_[col_idx];
 
     // Fast-path in case the existing value for this column already matches the new target.
-    if (target_value == *it) {
+    if (target_value == it->AsSlice()) {
       col_idx++;
-      target_value.AppendToKey(&current_scan_target_);
+      current_scan_target_.AppendRawBytes(target_value);
       continue;
     }
 
     // Search for the option that matches new target value (for the current column).
     if (is_forward_scan_) {
-      it = std::lower_bound(choices.begin(), choices.end(), target_value);
+      it = std::lower_bound(choices.begin(), choices.end(), target_value, EncodedLess);
     } else {
-      it = std::lower_bound(choices.begin(), choices.end(), target_value, std::greater<>());
+      it = std::lower_bound(choices.begin(), choices.end(), target_value, EncodedGreater);
     }
 
     // If we overflowed, the new target value for this column is larger than all our options, so
@@ -284,10 +330,10 @@ Status DiscreteScanChoices::SkipTargetsUpTo(const Slice& new_target) {
     }
 
     // Else, update the current target value for this column.
-    it->AppendToKey(&current_scan_target_);
+    current_scan_target_.AppendRawBytes(it->AsSlice());
 
     // If we did not find an exact match we are already beyond the new target so we can stop.
-    if (target_value != *it) {
+    if (target_value != it->AsSlice()) {
       col_idx++;
       break;
     }
@@ -299,8 +345,8 @@ Status DiscreteScanChoices::SkipTargetsUpTo(const Slice& new_target) {
   // match and we reached beyond the new target key. So we need to include all options for the
   // leftover columns (i.e. set all following indexes to 0).
   for (size_t i = col_idx; i < current_scan_target_idxs_.size(); i++) {
-    current_scan_target_idxs_[i] = (*range_cols_scan_options_)[i].begin();
-    current_scan_target_idxs_[i]->AppendToKey(&current_scan_target_);
+    current_scan_target_idxs_[i] = range_cols_scan_options_[i].begin();
+    current_scan_target_.AppendRawBytes(current_scan_target_idxs_[i]->AsSlice());
   }
 
   current_scan_target_.AppendKeyEntryType(KeyEntryType::kGroupEnd);
@@ -383,8 +429,8 @@ class HybridScanChoices : public ScanChoices {
         const auto upper = GetQLRangeBoundAsPVal(range, col_sort_type,
                                                     false /* upper_bound */);
 
-        range_cols_scan_options_lower_[idx - num_hash_cols].push_back(lower);
-        range_cols_scan_options_upper_[idx - num_hash_cols].push_back(upper);
+        range_cols_scan_options_lower_[idx - num_hash_cols].push_back(EncodeKeyEntryValue(lower));
+        range_cols_scan_options_upper_[idx - num_hash_cols].push_back(EncodeKeyEntryValue(upper));
       } else {
 
         // If this is an option filter, we turn each option into a
@@ -402,25 +448,25 @@ class HybridScanChoices : public ScanChoices {
             //
             // As of D15647 we do not send empty options.
             // This is kept for backward compatibility during rolling upgrades.
-            range_cols_scan_options_lower_[idx - num_hash_cols].emplace_back(
-                KeyEntryType::kHighest);
-            range_cols_scan_options_upper_[idx - num_hash_cols].emplace_back(
-                KeyEntryType::kLowest);
+            range_cols_scan_options_lower_[idx - num_hash_cols].push_back(
+                EncodeKeyEntryValue(KeyEntryValue(KeyEntryType::kHighest)));
+            range_cols_scan_options_upper_[idx - num_hash_cols].push_back(
+                EncodeKeyEntryValue(KeyEntryValue(KeyEntryType::kLowest)));
           }
 
           for (const auto& val : options) {
-            const auto& lower = val;
-            const auto& upper = val;
-            range_cols_scan_options_lower_[idx - num_hash_cols].push_back(lower);
-            range_cols_scan_options_upper_[idx - num_hash_cols].push_back(upper);
+            auto encoded = EncodeKeyEntryValue(val);
+            range_cols_scan_options_lower_[idx - num_hash_cols].push_back(encoded);
+            range_cols_scan_options_upper_[idx - num_hash_cols].push_back(std::move(encoded));
           }
 
         } else {
             // If no filter is specified, we just impose an artificial range
             // filter [kLowest, kHighest]
-            range_cols_scan_options_lower_[idx - num_hash_cols].emplace_back(KeyEntryType::kLowest);
-            range_cols_scan_options_upper_[idx - num_hash_cols].emplace_back(
-                KeyEntryType::kHighest);
+            range_cols_scan_options_lower_[idx - num_hash_cols].push_back(
+                EncodeKeyEntryValue(KeyEntryValue(KeyEntryType::kLowest)));
+            range_cols_scan_options_upper_[idx - num_hash_cols].push_back(
+                EncodeKeyEntryValue(KeyEntryValue(KeyEntryType::kHighest)));
         }
       }
     }
@@ -471,9 +517,9 @@ class HybridScanChoices : public ScanChoices {
  private:
   KeyBytes prev_scan_target_;
 
-  // The following encodes the list of ranges we are iterating over
-  std::vector<std::vector<KeyEntryValue>> range_cols_scan_options_lower_;
-  std::vector<std::vector<KeyEntryValue>> range_cols_scan_options_upper_;
+  // The following encodes the list of ranges we are iterating over, bounds are stored encoded.
+  std::vector<std::vector<KeyBytes>> range_cols_scan_options_lower_;
+  std::vector<std::vector<KeyBytes>> range_cols_scan_options_upper_;
 
   std::vector<ColumnId> range_options_indexes_;
   mutable std::vector<size_t> current_scan_target_idxs_;
@@ -533,9 +579,8 @@ Status HybridScanChoices::SkipTargetsUpTo(const Slice& new_target) {
   current_scan_target_.Reset(Slice(new_target.data(), decoder.left_input().data()));
 
   size_t col_idx = 0;
-  KeyEntryValue target_value;
   for (col_idx = 0; col_idx < current_scan_target_idxs_.size(); col_idx++) {
-    RETURN_NOT_OK(decoder.DecodeKeyEntryValue(&target_value));
+    auto target_value = VERIFY_RESULT(decoder.DecodeEncodedKeyEntryValue());
     const auto& lower_choices = range_cols_scan_options_lower_[col_idx];
     const auto& upper_choices = range_cols_scan_options_upper_[col_idx];
     auto current_ind = current_scan_target_idxs_[col_idx];
@@ -546,8 +591,8 @@ Status HybridScanChoices::SkipTargetsUpTo(const Slice& new_target) {
     // If it's in range then good, continue after appending the target value
     // column.
 
-    if (target_value >= lower && target_value <= upper) {
-      target_value.AppendToKey(&current_scan_target_);
+    if (!EncodedGreater(lower, target_value) && !EncodedLess(upper, target_value)) {
+      current_scan_target_.AppendRawBytes(target_value);
       continue;
     }
 
@@ -565,11 +610,11 @@ Status HybridScanChoices::SkipTargetsUpTo(const Slice& new_target) {
     // Find an upper (lower) bound closest to target_value
     if (is_forward_scan_) {
       it = std::lower_bound(upper_choices.begin(),
-                                upper_choices.end(), target_value);
+                                upper_choices.end(), target_value, EncodedLess);
       ind = it - upper_choices.begin();
     } else {
       it = std::lower_bound(lower_choices.begin(), lower_choices.end(),
-              target_value, std::greater<>());
+              target_value, EncodedGreater);
       ind = it - lower_choices.begin();
     }
 
@@ -584,9 +629,9 @@ Status HybridScanChoices::SkipTargetsUpTo(const Slice& new_target) {
     current_scan_target_idxs_[col_idx] = ind;
 
     // If we are within a range then target_value itself should work.
-    if (lower_choices[ind] <= target_value
-        && upper_choices[ind] >= target_value) {
-      target_value.AppendToKey(&current_scan_target_);
+    if (!EncodedGreater(lower_choices[ind], target_value)
+        && !EncodedLess(upper_choices[ind], target_value)) {
+      current_scan_target_.AppendRawBytes(target_value);
       continue;
     }
 
@@ -594,14 +639,13 @@ Status HybridScanChoices::SkipTargetsUpTo(const Slice& new_target) {
     // This only works as we are assuming all given ranges are
     // disjoint.
 
-    DCHECK((is_forward_scan_ && lower_choices[ind] > target_value)
-              || (!is_forward_scan_ && upper_choices[ind]
-              < target_value));
+    DCHECK((is_forward_scan_ && EncodedGreater(lower_choices[ind], target_value))
+              || (!is_forward_scan_ && EncodedLess(upper_choices[ind], target_value)));
 
     if (is_forward_scan_) {
-      lower_choices[ind].AppendToKey(&current_scan_target_);
+      current_scan_target_.AppendRawBytes(lower_choices[ind].AsSlice());
     } else {
-      upper_choices[ind].AppendToKey(&current_scan_target_);
+      current_scan_target_.AppendRawBytes(upper_choices[ind].AsSlice());
     }
     col_idx++;
     break;
@@ -612,11 +656,9 @@ Status HybridScanChoices::SkipTargetsUpTo(const Slice& new_target) {
   for (size_t i = col_idx; i < range_cols_scan_options_lower_.size(); i++) {
     current_scan_target_idxs_[i] = 0;
     if (is_forward_scan_) {
-      range_cols_scan_options_lower_[i][0]
-                    .AppendToKey(&current_scan_target_);
+      current_scan_target_.AppendRawBytes(range_cols_scan_options_lower_[i][0].AsSlice());
     } else {
-      range_cols_scan_options_upper_[i][0]
-                    .AppendToKey(&current_scan_target_);
+      current_scan_target_.AppendRawBytes(range_cols_scan_options_upper_[i][0].AsSlice());
     }
   }
 
@@ -671,11 +713,10 @@ Status HybridScanChoices::IncrementScanTargetAtColumn(int start_col) {
   // refer to the documentation of this function to see what extremal
   // means here
   std::vector<bool> is_extremal;
-  KeyEntryValue target_value;
   for (int i = 0; i <= col_idx; ++i) {
-    RETURN_NOT_OK(t_decoder.DecodeKeyEntryValue(&target_value));
+    auto target_value = VERIFY_RESULT(t_decoder.DecodeEncodedKeyEntryValue());
     is_extremal.push_back(target_value ==
-      upper_extremal_vector[i][current_scan_target_idxs_[i]]);
+      upper_extremal_vector[i][current_scan_target_idxs_[i]].AsSlice());
   }
 
   // this variable tells us whether we start by appending
@@ -737,14 +778,14 @@ Status HybridScanChoices::IncrementScanTargetAtColumn(int start_col) {
   }
 
   for (int i = col_idx; i <= start_col; ++i) {
-      lower_extremal_vector[i][current_scan_target_idxs_[i]]
-                                      .AppendToKey(&current_scan_target_);
+    current_scan_target_.AppendRawBytes(
+        lower_extremal_vector[i][current_scan_target_idxs_[i]].AsSlice());
   }
 
   for (size_t i = start_col + 1; i < current_scan_target_idxs_.size(); ++i) {
     current_scan_target_idxs_[i] = 0;
-    lower_extremal_vector[i][current_scan_target_idxs_[i]]
-                                    .AppendToKey(&current_scan_target_);
+    current_scan_target_.AppendRawBytes(
+        lower_extremal_vector[i][current_scan_target_idxs_[i]].AsSlice());
   }
 
   return Status::OK();
@@ -854,8 +895,10 @@ class RangeBasedScanChoices : public ScanChoices {
       const ColumnId col_idx = schema.column_id(idx);
       const auto col_sort_type = schema.column(idx).sorting_type();
       const QLScanRange::QLRange range = doc_spec.range_bounds()->RangeFor(col_idx);
-      lower_.push_back(GetQLRangeBoundAsPVal(range, col_sort_type, true /* lower_bound */));
-      upper_.push_back(GetQLRangeBoundAsPVal(range, col_sort_type, false /* upper_bound */));
+      lower_.push_back(EncodeKeyEntryValue(
+          GetQLRangeBoundAsPVal(range, col_sort_type, true /* lower_bound */)));
+      upper_.push_back(EncodeKeyEntryValue(
+          GetQLRangeBoundAsPVal(range, col_sort_type, false /* upper_bound */)));
     }
   }
 
@@ -870,8 +913,8 @@ class RangeBasedScanChoices : public ScanChoices {
       const QLScanRange::QLRange range = doc_spec.range_bounds()->RangeFor(col_idx);
       const auto lower = GetQLRangeBoundAsPVal(range, col_sort_type, true /* lower_bound */);
       const auto upper = GetQLRangeBoundAsPVal(range, col_sort_type, false /* upper_bound */);
-      lower_.emplace_back(lower);
-      upper_.emplace_back(upper);
+      lower_.push_back(EncodeKeyEntryValue(lower));
+      upper_.push_back(EncodeKeyEntryValue(upper));
     }
   }
 
@@ -880,7 +923,8 @@ class RangeBasedScanChoices : public ScanChoices {
   Status SeekToCurrentTarget(IntentAwareIterator* db_iter) override;
 
  private:
-  std::vector<KeyEntryValue> lower_, upper_;
+  // Encoded bounds for each range column.
+  std::vector<KeyBytes> lower_, upper_;
   KeyBytes prev_scan_target_;
 };
 
@@ -911,31 +955,32 @@ Status RangeBasedScanChoices::SkipTargetsUpTo(const Slice& new_target) {
   current_scan_target_.Reset(Slice(new_target.data(), decoder.left_input().data()));
 
   size_t col_idx = 0;
-  KeyEntryValue target_value;
   bool last_was_infinity = false;
   for (col_idx = 0; VERIFY_RESULT(decoder.HasPrimitiveValue()); col_idx++) {
-    RETURN_NOT_OK(decoder.DecodeKeyEntryValue(&target_value));
-    VLOG(3) << "col_idx " << col_idx << " is " << target_value << " in ["
-            << yb::ToString(lower_[col_idx]) << " , " << yb::ToString(upper_[col_idx]) << " ] ?";
+    auto target_value = VERIFY_RESULT(decoder.DecodeEncodedKeyEntryValue());
+    VLOG(3) << "col_idx " << col_idx << " is " << target_value.ToDebugHexString() << " in ["
+            << lower_[col_idx].ToString() << " , " << upper_[col_idx].ToString() << " ] ?";
 
     const auto& lower = lower_[col_idx];
-    if (target_value < lower) {
-      const auto tgt = (is_forward_scan_ ? lower : KeyEntryValue(KeyEntryType::kLowest));
-      tgt.AppendToKey(&current_scan_target_);
-      last_was_infinity = tgt.IsInfinity();
-      VLOG(3) << " Updating idx " << col_idx << " from " << target_value << " to " << tgt;
+    if (EncodedGreater(lower, target_value)) {
+      const auto& tgt = is_forward_scan_ ? lower : EncodedLowest();
+      current_scan_target_.AppendRawBytes(tgt.AsSlice());
+      last_was_infinity = IsEncodedInfinity(tgt.AsSlice());
+      VLOG(3) << " Updating idx " << col_idx << " from " << target_value.ToDebugHexString()
+              << " to " << tgt.ToString();
       break;
     }
     const auto& upper = upper_[col_idx];
-    if (target_value > upper) {
-      const auto tgt = (!is_forward_scan_ ? upper : KeyEntryValue(KeyEntryType::kHighest));
-      VLOG(3) << " Updating idx " << col_idx << " from " << target_value << " to " << tgt;
-      tgt.AppendToKey(&current_scan_target_);
-      last_was_infinity = tgt.IsInfinity();
+    if (EncodedLess(upper, target_value)) {
+      const auto& tgt = !is_forward_scan_ ? upper : EncodedHighest();
+      VLOG(3) << " Updating idx " << col_idx << " from " << target_value.ToDebugHexString()
+              << " to " << tgt.ToString();
+      current_scan_target_.AppendRawBytes(tgt.AsSlice());
+      last_was_infinity = IsEncodedInfinity(tgt.AsSlice());
       break;
     }
-    target_value.AppendToKey(&current_scan_target_);
-    last_was_infinity = target_value.IsInfinity();
+    current_scan_target_.AppendRawBytes(target_value);
+    last_was_infinity = IsEncodedInfinity(target_value);
   }
 
   // Reset the remaining range columns to kHighest/lower for forward scans
@@ -946,13 +991,13 @@ Status RangeBasedScanChoices::SkipTargetsUpTo(const Slice& new_target) {
       break;
     }
     if (is_forward_scan_) {
-      VLOG(3) << " Updating col_idx " << col_idx << " to " << lower_[col_idx];
-      lower_[col_idx].AppendToKey(&current_scan_target_);
-      last_was_infinity = lower_[col_idx].IsInfinity();
+      VLOG(3) << " Updating col_idx " << col_idx << " to " << lower_[col_idx].ToString();
+      current_scan_target_.AppendRawBytes(lower_[col_idx].AsSlice());
+      last_was_infinity = IsEncodedInfinity(lower_[col_idx].AsSlice());
     } else {
-      VLOG(3) << " Updating col_idx " << col_idx << " to " << upper_[col_idx];
-      upper_[col_idx].AppendToKey(&current_scan_target_);
-      last_was_infinity = upper_[col_idx].IsInfinity();
+      VLOG(3) << " Updating col_idx " << col_idx << " to " << upper_[col_idx].ToString();
+      current_scan_target_.AppendRawBytes(upper_[col_idx].AsSlice());
+      last_was_infinity = IsEncodedInfinity(upper_[col_idx].AsSlice());
     }
   }
   current_scan_target_.AppendKeyEntryType(KeyEntryType::kGroupEnd);
@@ -0,0 +1,98 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "yb/docdb/doc_write_batch_cache.h"
+
+#include "yb/util/format.h"
+#include "yb/util/test_macros.h"
+
+namespace yb {
+namespace docdb {
+
+namespace {
+
+KeyBytes MakeKey(const std::string& str) {
+  KeyBytes result;
+  result.AppendRawBytes(str);
+  return result;
+}
+
+DocHybridTime MakeTime(IntraTxnWriteId write_id) {
+  return DocHybridTime(HybridTime::kMax, write_id);
+}
+
+} // namespace
+
+TEST(DocWriteBatchCacheTest, PutGet) {
+  DocWriteBatchCache cache;
+  // Longer than the inline capacity of KeyBuffer.
+  const std::string long_key(200, 'x');
+
+  auto key = MakeKey("key");
+  cache.Put(key, MakeTime(1), ValueEntryType::kObject);
+  cache.Put(MakeKey(long_key), MakeTime(2), ValueEntryType::kTombstone);
+
+  // Key is copied by the cache, so changing the caller's buffer does not affect it.
+  key.AppendRawBytes(std::string("suffix"));
+  ASSERT_FALSE(cache.Get(key));
+
+  auto entry = cache.Get(MakeKey("key"));
+  ASSERT_TRUE(entry);
+  ASSERT_EQ(entry->doc_hybrid_time, MakeTime(1));
+  ASSERT_EQ(entry->value_type, ValueEntryType::kObject);
+
+  entry = cache.Get(MakeKey(long_key));
+  ASSERT_TRUE(entry);
+  ASSERT_EQ(entry->value_type, ValueEntryType::kTombstone);
+
+  // Overwrite existing entry.
+  cache.Put(MakeKey("key"), MakeTime(3), ValueEntryType::kTombstone);
+  entry = cache.Get(MakeKey("key"));
+  ASSERT_TRUE(entry);
+  ASSERT_EQ(entry->doc_hybrid_time, MakeTime(3));
+  ASSERT_EQ(entry->value_type, ValueEntryType::kTombstone);
+}
+
+TEST(DocWriteBatchCacheTest, ClearAndReuse) {
+  constexpr int kNumKeys = 1000;
+  DocWriteBatchCache cache;
+  for (int iteration = 0; iteration != 3; ++iteration) {
+    for (int i = 0; i != kNumKeys; ++i) {
+      cache.Put(MakeKey(Format("key-$0-$1", iteration, i)), MakeTime(i), ValueEntryType::kObject);
+    }
+    for (int i = 0; i != kNumKeys; ++i) {
+      auto entry = cache.Get(MakeKey(Format("key-$0-$1", iteration, i)));
+      ASSERT_TRUE(entry) << "Iteration: " << iteration << ", key: " << i;
+      ASSERT_EQ(entry->doc_hybrid_time, MakeTime(i));
+    }
+    cache.Clear();
+    // Keys of the previous iteration are gone together with the arena contents.
+    ASSERT_FALSE(cache.Get(MakeKey(Format("key-$0-0", iteration))));
+  }
+}
+
+TEST(DocWriteBatchCacheTest, Move) {
+  DocWriteBatchCache cache;
+  cache.Put(MakeKey("key"), MakeTime(1), ValueEntryType::kObject);
+  DocWriteBatchCache moved(std::move(cache));
+  moved.Put(MakeKey("other"), MakeTime(2), ValueEntryType::kObject);
+  ASSERT_TRUE(moved.Get(MakeKey("key")));
+  ASSERT_TRUE(moved.Get(MakeKey("other")));
+}
+
+} // namespace docdb
+} // namespace yb
@@ -43,12 +43,17 @@ void DocWriteBatchCache::Put(const KeyBytes& key_bytes, const DocWriteBatchCache
     BestEffortDocDBKeyToStr(key_bytes),
     entry.doc_hybrid_time.ToString(),
     ToString(entry.value_type));
-  prefix_to_gen_ht_[key_bytes.data()] = entry;
+  auto it = prefix_to_gen_ht_.find(key_bytes.AsSlice());
+  if (it != prefix_to_gen_ht_.end()) {
+    it->second = entry;
+    return;
+  }
+  prefix_to_gen_ht_.emplace(arena_->DupSlice(key_bytes.AsSlice()), entry);
 }
 
 boost::optional<DocWriteBatchCache::Entry> DocWriteBatchCache::Get(
     const KeyBytes& encoded_key_prefix) {
-  auto iter = prefix_to_gen_ht_.find(encoded_key_prefix.data());
+  auto iter = prefix_to_gen_ht_.find(encoded_key_prefix.AsSlice());
 #ifdef DOCDB_DEBUG
   if (iter == prefix_to_gen_ht_.end()) {
     DOCDB_DEBUG_LOG("DocWriteBatchCache contained no entry for $0",
@@ -62,13 +67,13 @@ boost::optional<DocWriteBatchCache::Entry> DocWriteBatchCache::Get(
 }
 
 string DocWriteBatchCache::ToDebugString() {
-  vector<pair<KeyBuffer, Entry>> sorted_contents;
+  vector<pair<Slice, Entry>> sorted_contents;
   copy(prefix_to_gen_ht_.begin(), prefix_to_gen_ht_.end(), back_inserter(sorted_contents));
   sort(sorted_contents.begin(), sorted_contents.end());
   ostringstream ss;
   ss << "DocWriteBatchCache[" << endl;
   for (const auto& kv : sorted_contents) {
-    ss << "  " << BestEffortDocDBKeyToStr(kv.first.AsSlice()) << " -> "
+    ss << "  " << BestEffortDocDBKeyToStr(kv.first) << " -> "
        << EntryToStr(kv.second) << endl;
   }
   ss << "]";
@@ -91,7 +96,10 @@ string DocWriteBatchCache::EntryToStr(const Entry& entry) {
 }
 
 void DocWriteBatchCache::Clear() {
-  prefix_to_gen_ht_.clear();
+  // Replace the map before resetting the arena, since its nodes and buckets live in the arena.
+  // An empty map does not allocate.
+  prefix_to_gen_ht_ = NewMap();
+  arena_->Reset();
 }
 
 }  // namespace docdb
@@ -14,9 +14,11 @@
 #ifndef YB_DOCDB_DOC_WRITE_BATCH_CACHE_H_
 #define YB_DOCDB_DOC_WRITE_BATCH_CACHE_H_
 
+#include <memory>
 #include <unordered_map>
 #include <string>
 
+#include <boost/functional/hash.hpp>
 #include <boost/optional.hpp>
 
 #include "yb/common/hybrid_time.h"
@@ -24,6 +26,8 @@
 #include "yb/docdb/value_type.h"
 #include "yb/docdb/value.h"
 
+#include "yb/util/memory/arena.h"
+
 namespace yb {
 namespace docdb {
 
@@ -31,6 +35,9 @@ namespace docdb {
 // or deletion) for key prefixes that were read from RocksDB or created by previous operations
 // performed on the DocWriteBatch.
 //
+// Keys and hash map nodes are allocated in an arena owned by the cache, so caching a key prefix
+// does not allocate from the heap once the arena has grown, and all of them are released at once.
+//
 // This class is not thread-safe.
 class DocWriteBatchCache {
  public:
@@ -64,7 +71,6 @@ class DocWriteBatchCache {
 
   // Returns the latest generation hybrid_time for the document/subdocument identified by the given
   // encoded key prefix.
-  // TODO: switch to taking a slice as an input to avoid making a copy on lookup.
   boost::optional<Entry> Get(const KeyBytes& encoded_key_prefix);
 
   std::string ToDebugString();
@@ -74,7 +80,17 @@ class DocWriteBatchCache {
   void Clear();
 
  private:
-  std::unordered_map<KeyBuffer, Entry, ByteBufferHash> prefix_to_gen_ht_;
+  using Map = std::unordered_map<
+      Slice, Entry, boost::hash<Slice>, std::equal_to<Slice>,
+      ArenaAllocator<std::pair<const Slice, Entry>>>;
+
+  Map NewMap() {
+    return Map(0, boost::hash<Slice>(), std::equal_to<Slice>(), arena_.get());
+  }
+
+  // Arena is held by pointer, so the map could keep a pointer to it while the cache is moved.
+  std::unique_ptr<Arena> arena_ = std::make_unique<Arena>();
+  Map prefix_to_gen_ht_ = NewMap();
 };
 
 
@@ -3441,6 +3441,111 @@ TEST_F(DocDBTestRedis, TestBuildSubDocumentBounds) {
   EXPECT_FALSE(subdoc_found);
 }
 
+// Reading rank ranges from the end of a two level subdocument should return the same result as
+// reading them from the start, also after deletes of leaves and of intermediate levels.
+TEST_F(DocDBTestRedis, TestBuildSubDocumentFromEnd) {
+  const DocKey doc_key(KeyEntryValues("key"));
+  const KeyBytes encoded_doc_key(doc_key.Encode());
+  constexpr int kNumGroups = 10;
+  constexpr int kGroupSize = 5;
+  const int base = 11000; // To ensure ints can be compared lexicographically.
+  auto group_key = [base](int group) {
+    return KeyEntryValue("group" + std::to_string(base + group));
+  };
+  auto member_key = [base](int member) {
+    return KeyEntryValue("member" + std::to_string(base + member));
+  };
+
+  MicrosTime write_time = 1000;
+  int num_leaves = 0;
+  for (int group = 0; group != kNumGroups; ++group) {
+    for (int member = 0; member != kGroupSize; ++member) {
+      ASSERT_OK(SetPrimitive(
+          DocPath(encoded_doc_key, group_key(group), member_key(member)),
+          QLValue::Primitive(Format("value$0_$1", group, member)),
+          HybridTime::FromMicros(write_time += 1000)));
+      ++num_leaves;
+    }
+  }
+
+  auto read = [this, &encoded_doc_key](
+      int low, int high, bool read_from_end, int num_leaves) -> Result<SubDocument> {
+    SubDocument result;
+    bool found = false;
+    IndexBound low_bound(low, true /* is_lower */);
+    IndexBound high_bound(high, false /* is_lower */);
+    GetRedisSubDocumentData data = { encoded_doc_key, &result, &found };
+    data.low_index = &low_bound;
+    data.high_index = &high_bound;
+    data.read_from_end = read_from_end;
+    data.num_leaves = num_leaves;
+    RETURN_NOT_OK(GetRedisSubDocument(
+        doc_db(), data, rocksdb::kDefaultQueryId, kNonTransactionalOperationContext,
+        CoarseTimePoint::max() /* deadline */, ReadHybridTime::Max()));
+    SCHECK(found, NotFound, "Subdocument not found");
+    return result;
+  };
+
+  auto verify = [&read, &num_leaves]() {
+    for (const auto& range : std::vector<std::pair<int, int>>{
+             {num_leaves - 1, num_leaves - 1}, {num_leaves - 3, num_leaves - 1},
+             {num_leaves - 12, num_leaves - 4}, {num_leaves / 2, num_leaves - 1},
+             {0, num_leaves - 1}}) {
+      const auto forward = ASSERT_RESULT(read(range.first, range.second, false, num_leaves));
+      const auto backward = ASSERT_RESULT(read(range.first, range.second, true, num_leaves));
+      ASSERT_EQ(forward, backward)
+          << "Range: " << AsString(range) << ", forward: " << forward.ToString()
+          << ", backward: " << backward.ToString();
+    }
+  };
+
+  ASSERT_NO_FATALS(verify());
+
+  // Delete leaves in the middle and at the end.
+  for (const auto& leaf : std::vector<std::pair<int, int>>{
+           {kNumGroups - 1, kGroupSize - 1}, {kNumGroups - 2, 2}, {kNumGroups - 3, 0}}) {
+    ASSERT_OK(DeleteSubDoc(
+        DocPath(encoded_doc_key, group_key(leaf.first), member_key(leaf.second)),
+        HybridTime::FromMicros(write_time += 1000)));
+    --num_leaves;
+  }
+  ASSERT_NO_FATALS(verify());
+
+  // The number of leaves passed by the caller, e.g. sorted set cardinality, differs from the number
+  // of live leaves. It is detected when the bounds include the first leaf or when all leaves are
+  // walked, and the subdocument is read from the start.
+  for (const auto wrong_num_leaves : {num_leaves - 3, num_leaves + 3}) {
+    std::vector<std::pair<int, int>> ranges = {{0, wrong_num_leaves - 1}, {0, 5}};
+    if (wrong_num_leaves > num_leaves) {
+      ranges.emplace_back(2, wrong_num_leaves - 1);
+    }
+    for (const auto& range : ranges) {
+      const auto forward = ASSERT_RESULT(
+          read(range.first, range.second, false, wrong_num_leaves));
+      const auto backward = ASSERT_RESULT(
+          read(range.first, range.second, true, wrong_num_leaves));
+      ASSERT_EQ(forward, backward)
+          << "Range: " << AsString(range) << ", number of leaves: " << wrong_num_leaves
+          << ", forward: " << forward.ToString() << ", backward: " << backward.ToString();
+    }
+  }
+
+  // Delete an intermediate level, and write one of its leaves again after that.
+  ASSERT_OK(DeleteSubDoc(
+      DocPath(encoded_doc_key, group_key(kNumGroups - 2)),
+      HybridTime::FromMicros(write_time += 1000)));
+  num_leaves -= kGroupSize - 1;
+  ASSERT_OK(SetPrimitive(
+      DocPath(encoded_doc_key, group_key(kNumGroups - 2), member_key(kGroupSize - 1)),
+      QLValue::Primitive("new_value"), HybridTime::FromMicros(write_time += 1000)));
+  ++num_leaves;
+  ASSERT_NO_FATALS(verify());
+
+  const auto last = ASSERT_RESULT(read(num_leaves - 1, num_leaves - 1, true, num_leaves));
+  ASSERT_EQ(last.object_num_keys(), 1U);
+  ASSERT_NE(last.GetChild(group_key(kNumGroups - 1)), nullptr);
+}
+
 TEST_P(DocDBTestWrapper, TestCompactionForCollectionsWithTTL) {
   DocKey collection_key(KeyEntryValues("collection"));
   SetUpCollectionWithTTL(collection_key, UseIntermediateFlushes::kFalse);
@@ -35,6 +35,7 @@ class DocRowwiseIterator;
 class DocWriteBatch;
 class HistoryRetentionPolicy;
 class IntentAwareIterator;
+class IntentIndex;
 class KeyBytes;
 class KeyEntryValue;
 class ManualHistoryRetentionPolicy;
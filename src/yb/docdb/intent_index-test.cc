@@ -0,0 +1,150 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/intent_index.h"
+
+#include "yb/util/mem_tracker.h"
+#include "yb/util/test_macros.h"
+#include "yb/util/test_thread_holder.h"
+#include "yb/util/test_util.h"
+
+using namespace std::literals;
+
+namespace yb {
+namespace docdb {
+
+const auto kStrongWrite = IntentTypeSet({IntentType::kStrongWrite});
+const auto kWeakWrite = IntentTypeSet({IntentType::kWeakWrite});
+
+class IntentIndexTest : public YBTest {
+ protected:
+  IntentIndex index_{/* max_entries= */ 4};
+};
+
+TEST_F(IntentIndexTest, AddLookupRemove) {
+  auto txn1 = TransactionId::GenerateRandom();
+  auto txn2 = TransactionId::GenerateRandom();
+
+  index_.Add(txn1, kMinSubTransactionId, "key1"s, kStrongWrite, /* lock_only= */ false);
+  index_.Add(txn1, kMinSubTransactionId, "key2"s, kWeakWrite, /* lock_only= */ false);
+  index_.Add(txn2, kMinSubTransactionId + 1, "key2"s, kWeakWrite, /* lock_only= */ true);
+  ASSERT_EQ(index_.TEST_NumEntries(), 3);
+
+  boost::container::small_vector<IndexedIntent, 4> intents;
+  ASSERT_TRUE(index_.Lookup("key2"s, &intents));
+  ASSERT_EQ(intents.size(), 2);
+
+  intents.clear();
+  ASSERT_TRUE(index_.Lookup("key3"s, &intents));
+  ASSERT_TRUE(intents.empty());
+
+  index_.RemoveTransaction(txn1);
+  ASSERT_EQ(index_.TEST_NumEntries(), 1);
+  ASSERT_TRUE(index_.Lookup("key2"s, &intents));
+  ASSERT_EQ(intents.size(), 1);
+  ASSERT_EQ(intents[0].transaction_id, txn2);
+  ASSERT_EQ(intents[0].subtransaction_id, kMinSubTransactionId + 1);
+  ASSERT_TRUE(intents[0].lock_only);
+
+  intents.clear();
+  ASSERT_TRUE(index_.Lookup("key1"s, &intents));
+  ASSERT_TRUE(intents.empty());
+}
+
+TEST_F(IntentIndexTest, Unindexed) {
+  auto loaded = TransactionId::GenerateRandom();
+  index_.AddUnindexedTransaction(loaded);
+
+  boost::container::small_vector<IndexedIntent, 4> intents;
+  ASSERT_FALSE(index_.Lookup("key1"s, &intents));
+
+  index_.RemoveTransaction(loaded);
+  ASSERT_TRUE(index_.Lookup("key1"s, &intents));
+}
+
+TEST_F(IntentIndexTest, Overflow) {
+  auto txn1 = TransactionId::GenerateRandom();
+  auto txn2 = TransactionId::GenerateRandom();
+  for (int i = 0; i != 4; ++i) {
+    index_.Add(txn1, kMinSubTransactionId, Format("key$0", i), kStrongWrite, false);
+  }
+  ASSERT_TRUE(index_.Usable());
+
+  // Index is full, so txn2 intents are not indexed and index should not be used until it is gone.
+  index_.Add(txn2, kMinSubTransactionId, "key4"s, kStrongWrite, false);
+  ASSERT_FALSE(index_.Usable());
+  ASSERT_EQ(index_.TEST_NumEntries(), 4);
+
+  index_.RemoveTransaction(txn1);
+  ASSERT_FALSE(index_.Usable());
+  index_.RemoveTransaction(txn2);
+  ASSERT_TRUE(index_.Usable());
+  ASSERT_EQ(index_.TEST_NumEntries(), 0);
+}
+
+TEST_F(IntentIndexTest, MemTracking) {
+  auto mem_tracker = MemTracker::CreateTracker("IntentIndexTest");
+  {
+    IntentIndex index(/* max_entries= */ 4, mem_tracker);
+    auto txn1 = TransactionId::GenerateRandom();
+    auto txn2 = TransactionId::GenerateRandom();
+    index.Add(txn1, kMinSubTransactionId, "key1"s, kStrongWrite, false);
+    index.Add(txn2, kMinSubTransactionId, "key2"s, kStrongWrite, false);
+    MemTracker::FlushThreadLocalConsumption();
+    auto consumption = mem_tracker->consumption();
+    ASSERT_GT(consumption, 0);
+
+    index.RemoveTransaction(txn1);
+    MemTracker::FlushThreadLocalConsumption();
+    ASSERT_GT(mem_tracker->consumption(), 0);
+    ASSERT_LT(mem_tracker->consumption(), consumption);
+  }
+  // Remaining intents are released when the index is destroyed.
+  MemTracker::FlushThreadLocalConsumption();
+  ASSERT_EQ(mem_tracker->consumption(), 0);
+}
+
+TEST_F(IntentIndexTest, ConcurrentAdd) {
+  constexpr int kThreads = 8;
+  constexpr int kKeysPerThread = 100;
+  IntentIndex index(/* max_entries= */ kThreads * kKeysPerThread);
+  std::vector<TransactionId> transactions;
+  for (int i = 0; i != kThreads; ++i) {
+    transactions.push_back(TransactionId::GenerateRandom());
+  }
+
+  TestThreadHolder thread_holder;
+  for (int i = 0; i != kThreads; ++i) {
+    thread_holder.AddThreadFunctor([&index, txn = transactions[i]] {
+      // All threads write the same keys, so intent shards are contended as well.
+      for (int key = 0; key != kKeysPerThread; ++key) {
+        index.Add(txn, kMinSubTransactionId, Format("key$0", key), kWeakWrite, false);
+      }
+    });
+  }
+  thread_holder.JoinAll();
+
+  ASSERT_TRUE(index.Usable());
+  ASSERT_EQ(index.TEST_NumEntries(), kThreads * kKeysPerThread);
+  boost::container::small_vector<IndexedIntent, kThreads> intents;
+  ASSERT_TRUE(index.Lookup("key0"s, &intents));
+  ASSERT_EQ(intents.size(), kThreads);
+
+  for (const auto& txn : transactions) {
+    index.RemoveTransaction(txn);
+  }
+  ASSERT_EQ(index.TEST_NumEntries(), 0);
+}
+
+} // namespace docdb
+} // namespace yb
@@ -0,0 +1,166 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/intent_index.h"
+
+#include <algorithm>
+
+#include "yb/util/logging.h"
+
+namespace yb {
+namespace docdb {
+
+namespace {
+
+// Approximate memory used by a single indexed intent: the key is stored both in the intent map
+// and in the list of keys of the transaction, plus hash map node and vector overhead.
+int64_t IntentConsumption(Slice intent_key) {
+  return 2 * (intent_key.size() + sizeof(KeyBuffer)) + sizeof(IndexedIntent) + 64;
+}
+
+} // namespace
+
+IntentIndex::IntentIndex(size_t max_entries, MemTrackerPtr mem_tracker)
+    : max_entries_(max_entries), mem_tracker_(std::move(mem_tracker)) {
+}
+
+IntentIndex::~IntentIndex() {
+  Reset();
+}
+
+IntentIndex::Shard& IntentIndex::ShardFor(Slice intent_key) const {
+  return shards_[intent_key.hash() % kNumShards];
+}
+
+IntentIndex::TransactionShard& IntentIndex::ShardFor(const TransactionId& transaction_id) {
+  return transaction_shards_[TransactionIdHash()(transaction_id) % kNumShards];
+}
+
+void IntentIndex::Add(
+    const TransactionId& transaction_id, SubTransactionId subtransaction_id, Slice intent_key,
+    IntentTypeSet types, bool lock_only) {
+  // Mutations of the same transaction are serialized by its transaction shard, so removal of
+  // transaction could not race with adding its intents. Lookups only lock the intent shard they
+  // are interested in.
+  auto& transaction_shard = ShardFor(transaction_id);
+  std::lock_guard<std::mutex> lock(transaction_shard.mutex);
+  auto& entry = transaction_shard.transactions[transaction_id];
+  if (entry.unindexed) {
+    return;
+  }
+  // Concurrent adds of different transactions could overshoot the limit by a few entries.
+  if (num_entries_.load(std::memory_order_relaxed) >= max_entries_) {
+    YB_LOG_EVERY_N_SECS(INFO, 10)
+        << "Intent index is full, " << transaction_id << " would use intents DB";
+    MarkUnindexedUnlocked(&entry);
+    return;
+  }
+  entry.keys.emplace_back(intent_key);
+
+  auto& shard = ShardFor(intent_key);
+  {
+    std::lock_guard<std::mutex> shard_lock(shard.mutex);
+    shard.intents[KeyBuffer(intent_key)].push_back(IndexedIntent {
+      .transaction_id = transaction_id,
+      .subtransaction_id = subtransaction_id,
+      .types = types,
+      .lock_only = lock_only,
+    });
+  }
+  num_entries_.fetch_add(1, std::memory_order_acq_rel);
+  if (mem_tracker_) {
+    auto consumption = IntentConsumption(intent_key);
+    entry.consumption += consumption;
+    mem_tracker_->Consume(consumption);
+  }
+}
+
+void IntentIndex::AddUnindexedTransaction(const TransactionId& transaction_id) {
+  auto& transaction_shard = ShardFor(transaction_id);
+  std::lock_guard<std::mutex> lock(transaction_shard.mutex);
+  MarkUnindexedUnlocked(&transaction_shard.transactions[transaction_id]);
+}
+
+void IntentIndex::MarkUnindexedUnlocked(TransactionEntry* entry) {
+  if (!entry->unindexed) {
+    entry->unindexed = true;
+    num_unindexed_.fetch_add(1, std::memory_order_acq_rel);
+  }
+}
+
+void IntentIndex::RemoveTransaction(const TransactionId& transaction_id) {
+  auto& transaction_shard = ShardFor(transaction_id);
+  std::lock_guard<std::mutex> lock(transaction_shard.mutex);
+  auto it = transaction_shard.transactions.find(transaction_id);
+  if (it == transaction_shard.transactions.end()) {
+    return;
+  }
+  RemoveTransactionUnlocked(transaction_id, &it->second);
+  transaction_shard.transactions.erase(it);
+}
+
+void IntentIndex::RemoveTransactionUnlocked(
+    const TransactionId& transaction_id, TransactionEntry* entry) {
+  size_t removed = 0;
+  for (const auto& key : entry->keys) {
+    auto& shard = ShardFor(key.AsSlice());
+    std::lock_guard<std::mutex> shard_lock(shard.mutex);
+    auto intents_it = shard.intents.find(key);
+    if (intents_it == shard.intents.end()) {
+      continue;
+    }
+    auto& intents = intents_it->second;
+    auto new_end = std::remove_if(
+        intents.begin(), intents.end(), [&transaction_id](const IndexedIntent& intent) {
+      return intent.transaction_id == transaction_id;
+    });
+    removed += intents.end() - new_end;
+    intents.erase(new_end, intents.end());
+    if (intents.empty()) {
+      shard.intents.erase(intents_it);
+    }
+  }
+  num_entries_.fetch_sub(removed, std::memory_order_acq_rel);
+  if (entry->unindexed) {
+    num_unindexed_.fetch_sub(1, std::memory_order_acq_rel);
+  }
+  if (mem_tracker_ && entry->consumption) {
+    mem_tracker_->Release(entry->consumption);
+  }
+}
+
+void IntentIndex::Reset() {
+  for (auto& transaction_shard : transaction_shards_) {
+    std::lock_guard<std::mutex> lock(transaction_shard.mutex);
+    for (auto& p : transaction_shard.transactions) {
+      RemoveTransactionUnlocked(p.first, &p.second);
+    }
+    transaction_shard.transactions.clear();
+  }
+}
+
+bool IntentIndex::Lookup(Slice intent_key, IndexedIntents* out) const {
+  if (!Usable()) {
+    return false;
+  }
+  auto& shard = ShardFor(intent_key);
+  std::lock_guard<std::mutex> shard_lock(shard.mutex);
+  auto it = shard.intents.find(KeyBuffer(intent_key));
+  if (it != shard.intents.end()) {
+    out->insert(out->end(), it->second.begin(), it->second.end());
+  }
+  return true;
+}
+
+} // namespace docdb
+} // namespace yb
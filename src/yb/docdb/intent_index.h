@@ -0,0 +1,133 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_DOCDB_INTENT_INDEX_H
+#define YB_DOCDB_INTENT_INDEX_H
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+#include <boost/container/small_vector.hpp>
+
+#include "yb/common/transaction.h"
+
+#include "yb/docdb/intent.h"
+
+#include "yb/util/byte_buffer.h"
+#include "yb/util/kv_util.h"
+#include "yb/util/mem_tracker.h"
+
+namespace yb {
+namespace docdb {
+
+struct IndexedIntent {
+  TransactionId transaction_id;
+  SubTransactionId subtransaction_id;
+  IntentTypeSet types;
+  // Whether intent is an explicit row lock, i.e. does not modify data.
+  bool lock_only;
+};
+
+using IndexedIntents = boost::container::small_vector_base<IndexedIntent>;
+
+// In-memory index of intents of running transactions of a single tablet, keyed by encoded intent
+// key without intent type and hybrid time. Used by conflict resolution instead of seeking the
+// intents DB for every intent key.
+//
+// Intents are added when transactional writes are applied to the intents DB, and removed when
+// the transaction is removed from the participant. Transactions whose intents are not present in
+// the index (loaded during bootstrap, or written while the index was full) are tracked as
+// unindexed, while there is at least one such transaction the index reports itself as unusable,
+// so the caller should fall back to the intents DB.
+//
+// Memory used by the index is charged to mem_tracker, when specified.
+class IntentIndex {
+ public:
+  explicit IntentIndex(size_t max_entries, MemTrackerPtr mem_tracker = nullptr);
+  ~IntentIndex();
+
+  void Add(
+      const TransactionId& transaction_id, SubTransactionId subtransaction_id, Slice intent_key,
+      IntentTypeSet types, bool lock_only);
+
+  // Marks transaction as running with intents that are not present in the index.
+  void AddUnindexedTransaction(const TransactionId& transaction_id);
+
+  void RemoveTransaction(const TransactionId& transaction_id);
+
+  // Forgets all intents, used when intents DB is truncated or restored.
+  void Reset();
+
+  // Permanently marks index as unusable, used when intents are written bypassing the index,
+  // e.g. external intents of xCluster replication.
+  void Disable() {
+    disabled_.store(true, std::memory_order_release);
+  }
+
+  // Appends intents stored for intent_key to out.
+  // Returns false if index is not complete, in this case out is not modified.
+  bool Lookup(Slice intent_key, IndexedIntents* out) const;
+
+  bool Usable() const {
+    return num_unindexed_.load(std::memory_order_acquire) == 0 &&
+           !disabled_.load(std::memory_order_acquire);
+  }
+
+  size_t TEST_NumEntries() const {
+    return num_entries_.load(std::memory_order_acquire);
+  }
+
+ private:
+  static constexpr size_t kNumShards = 16;
+
+  struct Shard {
+    mutable std::mutex mutex;
+    std::unordered_map<KeyBuffer, std::vector<IndexedIntent>, ByteBufferHash> intents;
+  };
+
+  struct TransactionEntry {
+    std::vector<KeyBuffer> keys;
+    bool unindexed = false;
+    // Bytes charged to mem_tracker_ for intents of this transaction.
+    int64_t consumption = 0;
+  };
+
+  // Transactions are sharded by id, so writes of different transactions, that are applied
+  // concurrently by different tablet writers, do not contend on a single mutex.
+  struct TransactionShard {
+    std::mutex mutex;
+    std::unordered_map<TransactionId, TransactionEntry, TransactionIdHash> transactions;
+  };
+
+  Shard& ShardFor(Slice intent_key) const;
+  TransactionShard& ShardFor(const TransactionId& transaction_id);
+  void MarkUnindexedUnlocked(TransactionEntry* entry);
+  void RemoveTransactionUnlocked(const TransactionId& transaction_id, TransactionEntry* entry);
+
+  const size_t max_entries_;
+  const MemTrackerPtr mem_tracker_;
+  mutable std::array<Shard, kNumShards> shards_;
+  std::atomic<size_t> num_entries_{0};
+  std::atomic<size_t> num_unindexed_{0};
+  std::atomic<bool> disabled_{false};
+
+  // Lock order is transaction shard, then intent shard.
+  std::array<TransactionShard, kNumShards> transaction_shards_;
+};
+
+} // namespace docdb
+} // namespace yb
+
+#endif // YB_DOCDB_INTENT_INDEX_H
@@ -14,6 +14,7 @@
 #ifndef YB_DOCDB_KEY_BOUNDS_H
 #define YB_DOCDB_KEY_BOUNDS_H
 
+#include "yb/docdb/docdb_fwd.h"
 #include "yb/docdb/key_bytes.h"
 #include "yb/rocksdb/rocksdb_fwd.h"
 
@@ -52,6 +53,8 @@ struct DocDB {
   rocksdb::DB* regular = nullptr;
   rocksdb::DB* intents = nullptr;
   const KeyBounds* key_bounds = nullptr;
+  // In-memory index of intents DB, null when disabled.
+  IntentIndex* intent_index = nullptr;
 
   static DocDB FromRegularUnbounded(rocksdb::DB* regular) {
     return {regular, nullptr /* intents */, &KeyBounds::kNoBounds};
@@ -1664,6 +1664,12 @@ Status RedisReadOperation::ExecuteCollectionGetRange() {
       data.deadline_info = deadline_info_.get_ptr();
       data.low_index = &low_bound;
       data.high_index = &high_bound;
+      // Ranks closer to the end of the set are read backwards starting from the last member, so
+      // that getting the top of a large set (e.g. ZREVRANGE 0 9) does not scan the whole set.
+      // Reading from the closer end visits O(min(rank, card - rank) + window) members instead of
+      // O(rank + window).
+      data.read_from_end = card - 1 - high_idx_normalized < low_idx_normalized;
+      data.num_leaves = card;
 
       RETURN_NOT_OK(GetAndPopulateResponseValues(
           iterator_.get(), AddResponseValuesSortedSets, data, ValueEntryType::kObject, request_,
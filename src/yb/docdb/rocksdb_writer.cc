@@ -21,6 +21,7 @@
 #include "yb/docdb/docdb.pb.h"
 #include "yb/docdb/docdb_rocksdb_util.h"
 #include "yb/docdb/intent.h"
+#include "yb/docdb/intent_index.h"
 #include "yb/docdb/value_type.h"
 
 #include "yb/gutil/walltime.h"
@@ -306,6 +307,11 @@ Status TransactionalWriter::operator()(
     reverse_value_prefix = replicated_batches_state_;
   }
   AddIntent<kNumKeyParts>(transaction_id_, key_parts, value, handler_, reverse_value_prefix);
+  if (intent_index_) {
+    intent_index_->Add(
+        transaction_id_, subtransaction_id_, key->AsSlice(), strong_intent_types_,
+        IsValidRowMarkType(row_mark_));
+  }
 
   return Status::OK();
 }
@@ -352,6 +358,13 @@ Status TransactionalWriter::AddWeakIntent(
   }};
 
   AddIntent<kNumKeyParts>(transaction_id_, key, value, handler_);
+  if (intent_index_) {
+    // Weak intents are written w/o subtransaction id, so conflict resolution treats them as
+    // belonging to kMinSubTransactionId.
+    intent_index_->Add(
+        transaction_id_, kMinSubTransactionId, intent_and_types.first.AsSlice(),
+        intent_and_types.second, /* lock_only= */ false);
+  }
 
   return Status::OK();
 }
@@ -80,6 +80,11 @@ class TransactionalWriter : public rocksdb::DirectWriter {
     metadata_to_store_ = value;
   }
 
+  // Written intents are also added to this index, if specified.
+  void SetIntentIndex(IntentIndex* intent_index) {
+    intent_index_ = intent_index;
+  }
+
   Status operator()(
       IntentStrength intent_strength, FullDocKey, Slice value_slice, KeyBytes* key,
       LastKey last_key);
@@ -100,6 +105,7 @@ class TransactionalWriter : public rocksdb::DirectWriter {
   IntraTxnWriteId intra_txn_write_id_;
   IntraTxnWriteId write_id_ = 0;
   const TransactionMetadataPB* metadata_to_store_ = nullptr;
+  IntentIndex* intent_index_ = nullptr;
 
   // TODO(dtxn) weak & strong intent in one batch.
   // TODO(dtxn) extract part of code knowing about intents structure to lower level.
@@ -60,6 +60,14 @@ class BlockAccessCipherStream {
   bool UseOpensslCompatibleCounterOverflow();
 
  private:
+  // Encrypt data starting at a block boundary. Large inputs are split into chunks that are
+  // encrypted in parallel.
+  Status EncryptBlocks(
+      uint64_t block_index,
+      const Slice& input,
+      void* output,
+      EncryptionOverflowWorkaround counter_overflow_workaround);
+
   Status EncryptByBlock(
       uint64_t block_index,
       const Slice& input,
@@ -71,8 +79,9 @@ class BlockAccessCipherStream {
                         EncryptionOverflowWorkaround counter_overflow_workaround);
 
   EncryptionParamsPtr encryption_params_;
-  std::unique_ptr<EVP_CIPHER_CTX, std::function<void(EVP_CIPHER_CTX*)>> encryption_context_;
-  mutable simple_spinlock mutex_;
+  // The cipher contexts are per thread and shared by all the streams, so concurrent reads of the
+  // same file do not serialize on the stream.
+  const EVP_CIPHER* cipher_ = nullptr;
 };
 
 } // namespace encryption
@@ -13,6 +13,7 @@
 
 #include <string>
 #include <thread>
+#include <vector>
 
 #include <glog/logging.h>
 #include <gtest/gtest.h>
@@ -30,6 +31,8 @@
 #include "yb/util/test_util.h"
 
 DECLARE_bool(TEST_encryption_use_openssl_compatible_counter_overflow);
+DECLARE_int64(encryption_parallel_min_bytes);
+DECLARE_int64(encryption_parallel_chunk_bytes);
 
 namespace yb {
 namespace encryption {
@@ -128,6 +131,45 @@ TEST_F(TestCipherStream, ConcurrentEncryption) {
   }
 }
 
+// Check that encrypting large buffers in parallel chunks produces the same bytes as encrypting them
+// with a single call, including when the counter is about to overflow.
+TEST_F(TestCipherStream, ParallelEncryption) {
+  rpc::InitOpenSSL();
+
+  constexpr int kBufSize = 64 * 1024;
+  auto plaintext_bytes = RandomBytes(kBufSize);
+  std::vector<uint8_t> serial_bytes(kBufSize);
+  std::vector<uint8_t> parallel_bytes(kBufSize);
+
+  for (bool openssl_compatible_counter_overflow : {true, false}) {
+    FLAGS_TEST_encryption_use_openssl_compatible_counter_overflow =
+        openssl_compatible_counter_overflow;
+    for (uint32_t counter : {0U, 0xFFFFFF00U}) {
+      auto params = EncryptionParams::NewEncryptionParams();
+      params->counter = counter;
+      auto cipher_stream = ASSERT_RESULT(BlockAccessCipherStream::FromEncryptionParams(
+          std::move(params)));
+
+      for (int i = 0; i < 100; i++) {
+        int start = RandomUniformInt(0, kBufSize / 2);
+        int size = RandomUniformInt(0, kBufSize - start);
+        Slice input(plaintext_bytes.data() + start, size);
+
+        FLAGS_encryption_parallel_min_bytes = 0;
+        ASSERT_OK(cipher_stream->Encrypt(start, input, serial_bytes.data()));
+
+        FLAGS_encryption_parallel_min_bytes = 1024;
+        FLAGS_encryption_parallel_chunk_bytes = RandomUniformInt(1, 4096);
+        ASSERT_OK(cipher_stream->Encrypt(start, input, parallel_bytes.data()));
+
+        ASSERT_EQ(Slice(serial_bytes.data(), size), Slice(parallel_bytes.data(), size))
+            << "start: " << start << ", size: " << size << ", counter: " << counter
+            << ", openssl compatible: " << openssl_compatible_counter_overflow;
+      }
+    }
+  }
+}
+
 TEST_F(TestCipherStream, Overflow) {
   // Create a cipher stream on a iv about to overflow.
   ASSERT_OK(TestOverFlowWithKeyType(true /* use_openssl_compatible_counter_overflow */ ));
@@ -13,17 +13,72 @@
 
 #include <openssl/evp.h>
 
+#include <limits>
+#include <vector>
+
 #include "yb/encryption/cipher_stream.h"
 #include "yb/encryption/encryption_util.h"
 
 #include "yb/gutil/casts.h"
 #include "yb/gutil/endian.h"
+#include "yb/gutil/sysinfo.h"
 
+#include "yb/util/atomic.h"
+#include "yb/util/countdown_latch.h"
+#include "yb/util/flag_tags.h"
+#include "yb/util/logging.h"
 #include "yb/util/status_format.h"
+#include "yb/util/threadpool.h"
+
+DEFINE_int64(encryption_parallel_min_bytes, 1024 * 1024,
+             "Minimum size of a buffer to encrypt or decrypt it in parallel chunks. 0 disables "
+             "parallel encryption.");
+TAG_FLAG(encryption_parallel_min_bytes, advanced);
+TAG_FLAG(encryption_parallel_min_bytes, runtime);
+
+DEFINE_int64(encryption_parallel_chunk_bytes, 256 * 1024,
+             "Size of the chunks a large buffer is split into for parallel encryption.");
+TAG_FLAG(encryption_parallel_chunk_bytes, advanced);
+TAG_FLAG(encryption_parallel_chunk_bytes, runtime);
 
 namespace yb {
 namespace encryption {
 
+namespace {
+
+// Returns the cipher context of the calling thread. Every encryption call sets the key and iv, so
+// the context is shared by all the streams the thread works with.
+EVP_CIPHER_CTX* ThreadCipherContext() {
+  struct CipherContextHolder {
+    CipherContextHolder() : context(EVP_CIPHER_CTX_new()) {}
+
+    ~CipherContextHolder() {
+      EVP_CIPHER_CTX_free(context);
+    }
+
+    EVP_CIPHER_CTX* context;
+  };
+
+  static thread_local CipherContextHolder holder;
+  return holder.context;
+}
+
+// Returns the pool used to encrypt chunks of large buffers, nullptr if it could not be created.
+// The pool is never destroyed, to avoid joining its threads during static destruction.
+ThreadPool* ParallelEncryptionPool() {
+  static ThreadPool* pool = [] {
+    std::unique_ptr<ThreadPool> result;
+    auto status = ThreadPoolBuilder("encrypt").set_max_threads(base::NumCPUs()).Build(&result);
+    if (!status.ok()) {
+      LOG(DFATAL) << "Failed to create parallel encryption pool: " << status;
+    }
+    return result.release();
+  }();
+  return pool;
+}
+
+} // namespace
+
 Result<std::unique_ptr<BlockAccessCipherStream>> BlockAccessCipherStream::FromEncryptionParams(
     EncryptionParamsPtr encryption_params) {
   auto stream = std::make_unique<BlockAccessCipherStream>(std::move(encryption_params));
@@ -33,46 +88,24 @@ Result<std::unique_ptr<BlockAccessCipherStream>> BlockAccessCipherStream::FromEn
 
 BlockAccessCipherStream::BlockAccessCipherStream(
     EncryptionParamsPtr encryption_params) :
-    encryption_params_(std::move(encryption_params)),
-    encryption_context_(EVP_CIPHER_CTX_new(), [](EVP_CIPHER_CTX* ctx){
-      EVP_CIPHER_CTX_cleanup(ctx);
-      EVP_CIPHER_CTX_free(ctx);
-    }) {}
+    encryption_params_(std::move(encryption_params)) {}
 
 Status BlockAccessCipherStream::Init() {
-  EVP_CIPHER_CTX_init(encryption_context_.get());
-  const EVP_CIPHER* cipher;
   switch (encryption_params_->key_size) {
     case 16:
-      cipher = EVP_aes_128_ctr();
+      cipher_ = EVP_aes_128_ctr();
       break;
     case 24:
-      cipher = EVP_aes_192_ctr();
+      cipher_ = EVP_aes_192_ctr();
       break;
     case 32:
-      cipher = EVP_aes_256_ctr();
+      cipher_ = EVP_aes_256_ctr();
       break;
     default:
       return STATUS_SUBSTITUTE(IllegalState, "Expected key size to be one of 16, 24, 32, found $0.",
           encryption_params_->key_size);
   }
 
-  const auto encrypt_init_ex_result = EVP_EncryptInit_ex(
-      encryption_context_.get(), cipher, /* impl */ nullptr, /* key */ nullptr,
-      /* iv */ nullptr);
-  if (encrypt_init_ex_result != 1) {
-    return STATUS_FORMAT(InternalError,
-                         "EVP_EncryptInit_ex returned $0",
-                         encrypt_init_ex_result);
-  }
-
-  const auto set_padding_result = EVP_CIPHER_CTX_set_padding(encryption_context_.get(), 0);
-  if (set_padding_result != 1) {
-    return STATUS_FORMAT(InternalError,
-                         "EVP_CIPHER_CTX_set_padding returned $0",
-                         set_padding_result);
-  }
-
   return Status::OK();
 }
 
@@ -108,10 +141,10 @@ Status BlockAccessCipherStream::Encrypt(
 
   // Encrypt the rest of the data.
   if (data_size > 0) {
-    RETURN_NOT_OK(EncryptByBlock(block_index,
-                                 Slice(input.data() + first_block_size, data_size),
-                                 static_cast<uint8_t*>(output) + first_block_size,
-                                 counter_overflow_workaround));
+    RETURN_NOT_OK(EncryptBlocks(block_index,
+                                Slice(input.data() + first_block_size, data_size),
+                                static_cast<uint8_t*>(output) + first_block_size,
+                                counter_overflow_workaround));
   }
   return Status::OK();
 }
@@ -128,6 +161,67 @@ bool BlockAccessCipherStream::UseOpensslCompatibleCounterOverflow() {
   return encryption_params_->openssl_compatible_counter_overflow;
 }
 
+Status BlockAccessCipherStream::EncryptBlocks(
+    uint64_t block_index, const Slice& input, void* output,
+    EncryptionOverflowWorkaround counter_overflow_workaround) {
+  constexpr auto kBlockSize = EncryptionParams::kBlockSize;
+  const auto min_parallel_bytes = GetAtomicFlag(&FLAGS_encryption_parallel_min_bytes);
+  const uint64_t chunk_size = std::max<int64_t>(
+      GetAtomicFlag(&FLAGS_encryption_parallel_chunk_bytes), kBlockSize) / kBlockSize * kBlockSize;
+  if (min_parallel_bytes <= 0 || input.size() < implicit_cast<size_t>(min_parallel_bytes) ||
+      input.size() <= chunk_size) {
+    return EncryptByBlock(block_index, input, output, counter_overflow_workaround);
+  }
+
+  // Without the OpenSSL compatible counter overflow, the lower 32 bits of the counter wrap around
+  // between calls but carry into the nonce within a single call. So the input can only be split
+  // when it does not cross such a wrap around.
+  if (!UseOpensslCompatibleCounterOverflow() && !counter_overflow_workaround) {
+    const uint64_t start_index = encryption_params_->counter + block_index;
+    const uint64_t num_blocks = (input.size() + kBlockSize - 1) / kBlockSize;
+    if ((start_index & std::numeric_limits<uint32_t>::max()) + num_blocks >
+            std::numeric_limits<uint32_t>::max() + 1ULL) {
+      return EncryptByBlock(block_index, input, output, counter_overflow_workaround);
+    }
+  }
+
+  auto* pool = ParallelEncryptionPool();
+  if (!pool) {
+    return EncryptByBlock(block_index, input, output, counter_overflow_workaround);
+  }
+
+  // CTR mode is seekable, so each chunk is encrypted on its own starting from its block index. The
+  // calling thread takes the first chunk and the rest go to the pool.
+  const size_t num_chunks = (input.size() + chunk_size - 1) / chunk_size;
+  std::vector<Status> statuses(num_chunks);
+  CountDownLatch latch(num_chunks - 1);
+  auto encrypt_chunk = [this, block_index, &input, output, counter_overflow_workaround, chunk_size,
+                        &statuses](size_t chunk) {
+    const size_t offset = chunk * chunk_size;
+    statuses[chunk] = EncryptByBlock(
+        block_index + offset / kBlockSize,
+        Slice(input.data() + offset, std::min<size_t>(chunk_size, input.size() - offset)),
+        static_cast<uint8_t*>(output) + offset, counter_overflow_workaround);
+  };
+  for (size_t chunk = 1; chunk != num_chunks; ++chunk) {
+    auto submit_status = pool->SubmitFunc([&encrypt_chunk, &latch, chunk] {
+      encrypt_chunk(chunk);
+      latch.CountDown();
+    });
+    if (!submit_status.ok()) {
+      encrypt_chunk(chunk);
+      latch.CountDown();
+    }
+  }
+  encrypt_chunk(0);
+  latch.Wait();
+
+  for (const auto& status : statuses) {
+    RETURN_NOT_OK(status);
+  }
+  return Status::OK();
+}
+
 Status BlockAccessCipherStream::EncryptByBlock(
     uint64_t block_index, const Slice& input, void* output,
     EncryptionOverflowWorkaround counter_overflow_workaround) {
@@ -149,24 +243,31 @@ Status BlockAccessCipherStream::EncryptByBlock(
   const uint64_t start_index = encryption_params_->counter + block_index;
   IncrementCounter(start_index, iv, counter_overflow_workaround);
 
-  // Lock the encryption op since we modify encryption context.
-  std::lock_guard<simple_spinlock> l(mutex_);
-
+  auto* context = ThreadCipherContext();
+  // Only reset the cipher when the thread's context was last used with a different key size, the
+  // key and iv are set on every call anyway.
+  const EVP_CIPHER* cipher = EVP_CIPHER_CTX_cipher(context) == cipher_ ? nullptr : cipher_;
   const int init_result =
-      EVP_EncryptInit_ex(encryption_context_.get(), /* cipher */ nullptr, /* impl */ nullptr,
-                         encryption_params_->key, iv);
+      EVP_EncryptInit_ex(context, cipher, /* impl */ nullptr, encryption_params_->key, iv);
   if (init_result != 1) {
     return STATUS_FORMAT(InternalError,
                          "EVP_EncryptInit_ex returned $0 when encrypting/decrypting $1 bytes "
                          "at block index $2.",
                          init_result, data_size, block_index);
   }
+  if (cipher) {
+    const auto set_padding_result = EVP_CIPHER_CTX_set_padding(context, 0);
+    if (set_padding_result != 1) {
+      return STATUS_FORMAT(InternalError,
+                           "EVP_CIPHER_CTX_set_padding returned $0",
+                           set_padding_result);
+    }
+  }
 
   // Perform the encryption.
   int bytes_updated = 0;
   const int update_result = EVP_EncryptUpdate(
-      encryption_context_.get(), static_cast<uint8_t*>(output), &bytes_updated, input.data(),
-      data_size);
+      context, static_cast<uint8_t*>(output), &bytes_updated, input.data(), data_size);
   if (update_result != 1) {
     return STATUS_FORMAT(InternalError,
                          "EVP_EncryptUpdate returned $0 when encrypting/decrypting $1 bytes "
@@ -12,6 +12,7 @@
 //
 
 #include <string>
+#include <vector>
 
 #include <glog/logging.h>
 #include <gtest/gtest.h>
@@ -23,11 +24,15 @@
 
 #include "yb/gutil/casts.h"
 
+#include "yb/util/monotime.h"
 #include "yb/util/random_util.h"
+#include "yb/util/size_literals.h"
 #include "yb/util/status.h"
 #include "yb/util/test_macros.h"
 #include "yb/util/test_util.h"
 
+DECLARE_int64(encryption_parallel_min_bytes);
+
 namespace yb {
 namespace encryption {
 
@@ -61,5 +66,57 @@ TEST_F(TestEncryptedEnv, FileOps) {
   }
 }
 
+// Compares the throughput of plain, serially encrypted and parallel encrypted files for writes and
+// reads in large chunks, like the ones done by flushes and compactions.
+TEST_F(TestEncryptedEnv, Throughput) {
+  if (!AllowSlowTests()) {
+    LOG(INFO) << "Skipping benchmark in fast-test mode";
+    return;
+  }
+
+  constexpr size_t kChunkSize = 4_MB;
+  constexpr size_t kFileSize = 256_MB;
+
+  auto header_manager = GetMockHeaderManager();
+  HeaderManager* hm_ptr = header_manager.get();
+  auto env = NewEncryptedEnv(std::move(header_manager));
+  auto bytes = RandomBytes(kChunkSize);
+  Slice data(bytes.data(), kChunkSize);
+  std::vector<uint8_t> scratch(kChunkSize);
+
+  auto min_parallel_bytes = FLAGS_encryption_parallel_min_bytes;
+  std::vector<std::pair<bool, bool>> modes = {{false, false}, {true, false}, {true, true}};
+  for (auto [encrypted, parallel] : modes) {
+    down_cast<HeaderManagerMockImpl*>(hm_ptr)->SetFileEncryption(encrypted);
+    FLAGS_encryption_parallel_min_bytes = parallel ? min_parallel_bytes : 0;
+
+    string fname;
+    std::unique_ptr<WritableFile> writable_file;
+    ASSERT_OK(env->NewTempWritableFile(
+        WritableFileOptions(), "test-fileXXXXXX", &fname, &writable_file));
+    auto start = MonoTime::Now();
+    for (size_t written = 0; written < kFileSize; written += kChunkSize) {
+      ASSERT_OK(writable_file->Append(data));
+    }
+    ASSERT_OK(writable_file->Close());
+    auto write_time = MonoTime::Now() - start;
+
+    std::unique_ptr<yb::RandomAccessFile> ra_file;
+    ASSERT_OK(env->NewRandomAccessFile(fname, &ra_file));
+    start = MonoTime::Now();
+    for (size_t offset = 0; offset < kFileSize; offset += kChunkSize) {
+      Slice result;
+      ASSERT_OK(ra_file->Read(offset, kChunkSize, &result, scratch.data()));
+      ASSERT_EQ(result, data);
+    }
+    auto read_time = MonoTime::Now() - start;
+
+    LOG(INFO) << "Encrypted: " << encrypted << ", parallel: " << parallel
+              << ", write MB/s: " << kFileSize / 1_MB / write_time.ToSeconds()
+              << ", read MB/s: " << kFileSize / 1_MB / read_time.ToSeconds();
+    ASSERT_OK(env->DeleteFile(fname));
+  }
+}
+
 } // namespace encryption
 } // namespace yb
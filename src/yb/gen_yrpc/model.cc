@@ -93,6 +93,10 @@ bool IsTrivialMethod(const google::protobuf::MethodDescriptor* method) {
   return method->options().GetExtension(rpc::trivial);
 }
 
+bool IsRunToCompletionMethod(const google::protobuf::MethodDescriptor* method) {
+  return method->options().GetExtension(rpc::run_to_completion);
+}
+
 bool HasLightweightMethod(const google::protobuf::ServiceDescriptor* service, rpc::RpcSides side) {
   for (int i = 0; i != service->method_count(); ++i) {
     if (IsLightweightMethod(service->method(i), side)) {
@@ -100,6 +100,7 @@ void ServiceGenerator::Header(YBPrinter printer, const google::protobuf::FileDes
           "const ::yb::rpc::RpcServicePtr& service, ::yb::rpc::RpcEndpointMap* map) override;\n"
       "  std::string service_name() const override;\n"
       "  static std::string static_service_name();\n"
+      "  std::vector<size_t> RunToCompletionMethods() const override;\n"
       "\n"
       );
 
@@ -240,6 +241,21 @@ void ServiceGenerator::Source(YBPrinter printer, const google::protobuf::FileDes
         "std::string $service_name$If::static_service_name() {\n"
         "  return \"$full_service_name$\";\n"
         "}\n\n"
+        "std::vector<size_t> $service_name$If::RunToCompletionMethods() const {\n"
+        "  return {\n"
+    );
+
+    for (int method_idx = 0; method_idx < service->method_count(); ++method_idx) {
+      auto* method = service->method(method_idx);
+      if (IsRunToCompletionMethod(method)) {
+        ScopedSubstituter method_subs(printer, method, rpc::RpcSides::SERVICE);
+        printer("    static_cast<size_t>($service_method_enum$::$metric_enum_key$),\n");
+      }
+    }
+
+    printer(
+        "  };\n"
+        "}\n\n"
         "void $service_name$If::InitMethods(const scoped_refptr<MetricEntity>& entity) {\n"
     );
 
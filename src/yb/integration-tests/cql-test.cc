@@ -48,6 +48,7 @@ DECLARE_int32(timestamp_history_retention_interval_sec);
 DECLARE_int32(partitions_vtable_cache_refresh_secs);
 DECLARE_int32(client_read_write_timeout_ms);
 DECLARE_bool(disable_truncate_table);
+DECLARE_int32(ycql_max_parallel_aggregate_scan_tablets);
 
 namespace yb {
 
@@ -367,6 +368,72 @@ TEST_F(CqlTest, CompactDeleteMarkers) {
   ASSERT_EQ(count_str, "0");
 }
 
+TEST_F(CqlTest, ParallelAggregateScan) {
+  constexpr int kNumRows = 500;
+
+  auto session = ASSERT_RESULT(EstablishSession(driver_.get()));
+  ASSERT_OK(session.ExecuteQuery(
+      "CREATE TABLE t (key INT PRIMARY KEY, value INT) WITH tablets = 8"));
+  int64_t sum = 0;
+  for (int i = 0; i != kNumRows; ++i) {
+    ASSERT_OK(session.ExecuteQueryFormat("INSERT INTO t (key, value) VALUES ($0, $1)", i, i * 2));
+    sum += i * 2;
+  }
+
+  const std::string kTokenRangeCount =
+      "SELECT COUNT(*) FROM t WHERE token(key) >= -4611686018427387904 AND token(key) < 0";
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_ycql_max_parallel_aggregate_scan_tablets) = 1;
+  auto token_range_count = ASSERT_RESULT(session.ExecuteAndRenderToString(kTokenRangeCount));
+  LOG(INFO) << "Rows in token range: " << token_range_count;
+
+  // Less parallel tablets than tablets in the table, so some ops read several tablets.
+  for (int parallel_tablets : {3, 16}) {
+    ANNOTATE_UNPROTECTED_WRITE(FLAGS_ycql_max_parallel_aggregate_scan_tablets) = parallel_tablets;
+    ASSERT_EQ(ASSERT_RESULT(session.ExecuteAndRenderToString("SELECT COUNT(*) FROM t")),
+              AsString(kNumRows));
+    ASSERT_EQ(ASSERT_RESULT(session.ExecuteAndRenderToString("SELECT SUM(value) FROM t")),
+              AsString(sum));
+    ASSERT_EQ(ASSERT_RESULT(session.ExecuteAndRenderToString("SELECT MAX(value) FROM t")),
+              AsString((kNumRows - 1) * 2));
+    ASSERT_EQ(ASSERT_RESULT(session.ExecuteAndRenderToString(kTokenRangeCount)),
+              token_range_count);
+  }
+}
+
+// Partial aggregates that do not fit into one page should be returned the same way as by the
+// serial scan, without losing tablets that were not read yet.
+TEST_F(CqlTest, ParallelAggregateScanPaging) {
+  constexpr int kNumRows = 100;
+  constexpr int kNumTablets = 8;
+
+  auto session = ASSERT_RESULT(EstablishSession(driver_.get()));
+  ASSERT_OK(session.ExecuteQueryFormat(
+      "CREATE TABLE t (key INT PRIMARY KEY, value INT) WITH tablets = $0", kNumTablets));
+  for (int i = 0; i != kNumRows; ++i) {
+    ASSERT_OK(session.ExecuteQueryFormat("INSERT INTO t (key, value) VALUES ($0, $1)", i, i));
+  }
+
+  auto count_with_page_size = [&session](int page_size) -> Result<std::string> {
+    CassandraStatement statement("SELECT COUNT(*) FROM t");
+    cass_statement_set_paging_size(statement.get(), page_size);
+    return VERIFY_RESULT(session.ExecuteWithResult(statement)).RenderToString();
+  };
+
+  for (int page_size : {1, 3, kNumTablets - 1}) {
+    ANNOTATE_UNPROTECTED_WRITE(FLAGS_ycql_max_parallel_aggregate_scan_tablets) = 1;
+    const auto serial_result = ASSERT_RESULT(count_with_page_size(page_size));
+    ANNOTATE_UNPROTECTED_WRITE(FLAGS_ycql_max_parallel_aggregate_scan_tablets) = 16;
+    ASSERT_EQ(ASSERT_RESULT(count_with_page_size(page_size)), serial_result)
+        << "Page size: " << page_size;
+  }
+
+  // All partial aggregates fit into one page, so tablets are read in parallel.
+  for (int page_size : {kNumTablets, kNumTablets * 2}) {
+    ASSERT_EQ(ASSERT_RESULT(count_with_page_size(page_size)), AsString(kNumRows))
+        << "Page size: " << page_size;
+  }
+}
+
 class CqlRF1Test : public CqlTest {
  public:
   int num_tablet_servers() override {
@@ -27,6 +27,7 @@
 
 #include <algorithm>
 #include <string>
+#include <typeinfo>
 #include <unordered_map>
 #include <vector>
 
@@ -40,9 +41,21 @@
 #include "yb/rocksdb/util/coding.h"
 #include "yb/rocksdb/util/perf_context_imp.h"
 
+#include "yb/gutil/endian.h"
+
+#include "yb/util/flag_tags.h"
 #include "yb/util/result.h"
 #include "yb/util/stats/perf_step_timer.h"
 
+// Off until the seek benchmark in block_test (BlockTest.RestartKeyPrefixesSeekPerf) is run on
+// production-like data and shows a win over the plain binary search.
+DEFINE_bool(rocksdb_use_restart_key_prefixes, false,
+            "Whether to keep in-memory fixed-width prefixes of block restart keys and use them to "
+            "narrow the binary search over restart points on seek. Checked when a block "
+            "iterator is created.");
+TAG_FLAG(rocksdb_use_restart_key_prefixes, advanced);
+TAG_FLAG(rocksdb_use_restart_key_prefixes, runtime);
+
 namespace rocksdb {
 
 namespace {
@@ -53,6 +66,41 @@ namespace {
 // - num_restarts: uint32
 const size_t kMinBlockSize = 2*sizeof(uint32_t);
 
+constexpr size_t kRestartKeyPrefixSize = sizeof(uint64_t);
+
+// Ranges of restart points up to this size are narrowed with a branch-free counting loop that the
+// compiler vectorizes, larger ones with a binary search over prefixes.
+constexpr uint32_t kRestartKeyPrefixScanLimit = 64;
+
+// Returns the first kRestartKeyPrefixSize bytes of user_key padded with zeros as a big-endian
+// integer. In bytewise order prefix(a) < prefix(b) implies a < b, while a < b implies
+// prefix(a) <= prefix(b).
+inline uint64_t UserKeyPrefix(const Slice& user_key) {
+  if (user_key.size() >= kRestartKeyPrefixSize) {
+    return BigEndian::Load64(user_key.data());
+  }
+  char buffer[kRestartKeyPrefixSize] = {0};
+  memcpy(buffer, user_key.data(), user_key.size());
+  return BigEndian::Load64(buffer);
+}
+
+// Returns true if keys compared by comparator are ordered by bytewise order of their user keys.
+// In that case key_trailer_size is set to the size of the suffix following the user key.
+bool OrderedByBytewiseUserKey(const Comparator* comparator, size_t* key_trailer_size) {
+  if (comparator == BytewiseComparator()) {
+    *key_trailer_size = 0;
+    return true;
+  }
+  // Subclasses, like the ones used in tests, may compare keys differently.
+  if (typeid(*comparator) == typeid(InternalKeyComparator) &&
+      static_cast<const InternalKeyComparator*>(comparator)->user_comparator() ==
+          BytewiseComparator()) {
+    *key_trailer_size = kLastInternalComponentSize;
+    return true;
+  }
+  return false;
+}
+
 } // namespace
 
 // Helper routine: decode the next block entry starting at "p",
@@ -366,6 +414,10 @@ bool BlockIter::BinarySeek(const Slice& target, uint32_t left, uint32_t right,
                   uint32_t* index) {
   assert(left <= right);
 
+  if (restart_key_prefixes_ && left < right) {
+    NarrowByRestartKeyPrefixes(target, &left, &right);
+  }
+
   while (left < right) {
     uint32_t mid = (left + right + 1) / 2;
     uint32_t region_offset = GetRestartPoint(mid);
@@ -395,6 +447,52 @@ bool BlockIter::BinarySeek(const Slice& target, uint32_t left, uint32_t right,
   return true;
 }
 
+void BlockIter::NarrowByRestartKeyPrefixes(
+    const Slice& target, uint32_t* left, uint32_t* right) const {
+  if (target.size() < key_trailer_size_) {
+    return;
+  }
+  auto target_user_key = target.WithoutSuffix(key_trailer_size_);
+  // All restart keys start with restart_key_common_prefix_, so target that differs from it within
+  // its length is less or greater than all of them.
+  const auto common_size = std::min(target_user_key.size(), restart_key_common_prefix_.size());
+  int cmp = memcmp(target_user_key.data(), restart_key_common_prefix_.data(), common_size);
+  if (cmp == 0 && target_user_key.size() < restart_key_common_prefix_.size()) {
+    cmp = -1;
+  }
+  if (cmp < 0) {
+    *right = *left;
+    return;
+  }
+  if (cmp > 0) {
+    *left = *right;
+    return;
+  }
+  target_user_key.remove_prefix(restart_key_common_prefix_.size());
+  const auto target_prefix = UserKeyPrefix(target_user_key);
+  const uint64_t* begin = restart_key_prefixes_ + *left;
+  const uint32_t count = *right - *left + 1;
+  uint32_t num_less = 0;
+  uint32_t num_less_or_equal = 0;
+  if (count <= kRestartKeyPrefixScanLimit) {
+    for (uint32_t i = 0; i != count; ++i) {
+      num_less += begin[i] < target_prefix;
+      num_less_or_equal += begin[i] <= target_prefix;
+    }
+  } else {
+    const uint64_t* end = begin + count;
+    const uint64_t* lower = std::lower_bound(begin, end, target_prefix);
+    num_less = static_cast<uint32_t>(lower - begin);
+    num_less_or_equal = static_cast<uint32_t>(std::upper_bound(lower, end, target_prefix) - begin);
+  }
+  // Restart keys with a smaller prefix are less than target and ones with a greater prefix are
+  // greater than target. So the last restart key that is not greater than target lies between
+  // the last key with a smaller prefix and the last key with a smaller or equal prefix.
+  const uint32_t new_left = *left + (num_less ? num_less - 1 : 0);
+  *right = std::max(new_left, *left + (num_less_or_equal ? num_less_or_equal - 1 : 0));
+  *left = new_left;
+}
+
 // Compare target key and the block key of the block of `block_index`.
 // Return -1 if error.
 int BlockIter::CompareBlockKey(uint32_t block_index, const Slice& target) {
@@ -544,6 +642,19 @@ InternalIterator* Block::NewIterator(
       iter = new BlockIter(cmp, data_, key_value_encoding_format, restart_offset_, num_restarts,
                            hash_index_ptr, prefix_index_ptr);
     }
+
+    size_t key_trailer_size;
+    if (FLAGS_rocksdb_use_restart_key_prefixes && !hash_index_ptr && !prefix_index_ptr &&
+        OrderedByBytewiseUserKey(cmp, &key_trailer_size)) {
+      std::call_once(
+          restart_key_prefixes_once_, &Block::BuildRestartKeyPrefixes, this,
+          key_value_encoding_format, key_trailer_size);
+      if (!restart_key_prefixes_.empty() &&
+          restart_key_prefixes_trailer_size_ == key_trailer_size) {
+        iter->SetRestartKeyPrefixes(
+            restart_key_prefixes_.data(), restart_key_common_prefix_, key_trailer_size);
+      }
+    }
   }
 
   return iter;
@@ -557,6 +668,45 @@ void Block::SetBlockPrefixIndex(BlockPrefixIndex* prefix_index) {
   prefix_index_.reset(prefix_index);
 }
 
+void Block::BuildRestartKeyPrefixes(
+    const KeyValueEncodingFormat key_value_encoding_format, const size_t key_trailer_size) {
+  const auto num_restarts = NumRestarts();
+  std::vector<Slice> user_keys;
+  user_keys.reserve(num_restarts);
+  for (uint32_t i = 0; i != num_restarts; ++i) {
+    const auto entry_offset = DecodeFixed32(data_ + restart_offset_ + i * sizeof(uint32_t));
+    uint32_t key_size;
+    const char* key_ptr = DecodeRestartEntry(
+        key_value_encoding_format, data_ + entry_offset, data_ + restart_offset_, data_,
+        &key_size);
+    if (key_ptr == nullptr || key_size < key_trailer_size) {
+      // Leave it to the regular seek path to report the corruption.
+      return;
+    }
+    user_keys.emplace_back(key_ptr, key_size - key_trailer_size);
+  }
+  if (user_keys.empty()) {
+    return;
+  }
+
+  // Restart keys are sorted, so the common prefix of the first and the last ones is shared by all
+  // of them. Prefixes are taken after it, otherwise blocks of keys sharing long prefixes, that are
+  // typical for DocDB, would have all prefixes equal.
+  const auto common_prefix_size = user_keys.front().difference_offset(user_keys.back());
+  const auto common_prefix = user_keys.front().Prefix(common_prefix_size);
+  std::vector<uint64_t> prefixes;
+  prefixes.reserve(num_restarts);
+  for (auto& user_key : user_keys) {
+    user_key.remove_prefix(common_prefix_size);
+    prefixes.push_back(UserKeyPrefix(user_key));
+  }
+  restart_key_prefixes_ = std::move(prefixes);
+  restart_key_common_prefix_ = common_prefix;
+  restart_key_prefixes_trailer_size_ = key_trailer_size;
+  restart_key_prefixes_memory_usage_.store(
+      restart_key_prefixes_.capacity() * sizeof(uint64_t), std::memory_order_release);
+}
+
 size_t Block::ApproximateMemoryUsage() const {
   size_t usage = usable_size();
   if (hash_index_) {
@@ -565,6 +715,7 @@ size_t Block::ApproximateMemoryUsage() const {
   if (prefix_index_) {
     usage += prefix_index_->ApproximateMemoryUsage();
   }
+  usage += restart_key_prefixes_memory_usage_.load(std::memory_order_acquire);
   return usage;
 }
 
@@ -30,6 +30,10 @@
 #include <malloc.h>
 #endif
 
+#include <atomic>
+#include <mutex>
+#include <vector>
+
 #include "yb/rocksdb/iterator.h"
 #include "yb/rocksdb/options.h"
 #include "yb/rocksdb/db/dbformat.h"
@@ -112,6 +116,22 @@ class Block {
   std::unique_ptr<BlockHashIndex> hash_index_;
   std::unique_ptr<BlockPrefixIndex> prefix_index_;
 
+  // Fixed-width big-endian prefixes of restart point user keys taken after
+  // restart_key_common_prefix_, built lazily on the first iterator created with a bytewise
+  // comparator. Lets BlockIter::BinarySeek narrow the search range with integer comparisons before
+  // falling back to the comparator.
+  std::once_flag restart_key_prefixes_once_;
+  std::vector<uint64_t> restart_key_prefixes_;
+  // Prefix shared by all restart point user keys, points into data_.
+  Slice restart_key_common_prefix_;
+  // Internal key trailer size the prefixes were built for.
+  size_t restart_key_prefixes_trailer_size_ = 0;
+  // Set once prefixes are built, so ApproximateMemoryUsage does not race with building them.
+  std::atomic<size_t> restart_key_prefixes_memory_usage_{0};
+
+  void BuildRestartKeyPrefixes(
+      KeyValueEncodingFormat key_value_encoding_format, size_t key_trailer_size);
+
   // No copying allowed
   Block(const Block&);
   void operator=(const Block&);
@@ -149,6 +169,15 @@ class BlockIter : public InternalIterator {
     status_ = s;
   }
 
+  // Provides restart key prefixes built by Block, see Block::restart_key_prefixes_.
+  void SetRestartKeyPrefixes(
+      const uint64_t* restart_key_prefixes, Slice restart_key_common_prefix,
+      size_t key_trailer_size) {
+    restart_key_prefixes_ = restart_key_prefixes;
+    restart_key_common_prefix_ = restart_key_common_prefix;
+    key_trailer_size_ = key_trailer_size;
+  }
+
   virtual bool Valid() const override { return current_ < restarts_; }
   virtual Status status() const override { return status_; }
   virtual Slice key() const override {
@@ -197,6 +226,9 @@ class BlockIter : public InternalIterator {
   Status status_;
   BlockHashIndex* hash_index_;
   BlockPrefixIndex* prefix_index_;
+  const uint64_t* restart_key_prefixes_ = nullptr;
+  Slice restart_key_common_prefix_;
+  size_t key_trailer_size_ = 0;
 
   inline int Compare(const Slice& a, const Slice& b) const {
     return comparator_->Compare(a, b);
@@ -231,6 +263,9 @@ class BlockIter : public InternalIterator {
   bool BinarySeek(const Slice& target, uint32_t left, uint32_t right,
                   uint32_t* index);
 
+  // Narrows [left, right] of BinarySeek using restart key prefixes.
+  void NarrowByRestartKeyPrefixes(const Slice& target, uint32_t* left, uint32_t* right) const;
+
   int CompareBlockKey(uint32_t block_index, const Slice& target);
 
   bool BinaryBlockIndexSeek(const Slice& target, uint32_t* block_ids,
@@ -20,6 +20,7 @@
 
 #include <stdio.h>
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -38,9 +39,11 @@
 #include "yb/rocksdb/util/testutil.h"
 
 #include "yb/util/logging.h"
+#include "yb/util/monotime.h"
 #include "yb/util/random_util.h"
 #include "yb/util/test_macros.h"
 
+DECLARE_bool(rocksdb_use_restart_key_prefixes);
 DECLARE_int32(v);
 
 namespace rocksdb {
@@ -436,6 +439,160 @@ TEST_F(BlockTest, GetMiddleKey) {
   }
 }
 
+// Seek results should not depend on whether restart key prefixes are used. Keys are internal keys
+// with user keys of various lengths, including ones shorter than the prefix, sharing long
+// prefixes. Blocks are built with and without a prefix common to all keys, targets could also
+// diverge from that common prefix or be shorter than it.
+TEST_F(BlockTest, RestartKeyPrefixes) {
+  constexpr auto kNumKeys = 2000;
+  constexpr auto kNumSeeks = 5000;
+  const InternalKeyComparator comparator(BytewiseComparator());
+
+  auto random_suffix = [] {
+    return std::string(yb::RandomUniformInt(0, 12), 'k') +
+           yb::RandomString(yb::RandomUniformInt(0, 3));
+  };
+
+  for (const std::string common_prefix : {"", "common key prefix of the block"}) {
+    std::vector<std::string> user_keys;
+    for (int i = 0; i < kNumKeys; ++i) {
+      user_keys.push_back(common_prefix + random_suffix());
+    }
+    std::sort(user_keys.begin(), user_keys.end());
+    user_keys.erase(std::unique(user_keys.begin(), user_keys.end()), user_keys.end());
+
+    std::vector<std::string> keys;
+    for (const auto& user_key : user_keys) {
+      keys.push_back(InternalKey(user_key, kMaxSequenceNumber, kTypeValue).Encode().ToString());
+    }
+
+    auto random_target_prefix = [&common_prefix]() -> std::string {
+      if (common_prefix.empty()) {
+        return common_prefix;
+      }
+      switch (yb::RandomUniformInt(0, 3)) {
+        case 0:
+          return common_prefix.substr(0, yb::RandomUniformInt<size_t>(0, common_prefix.size()));
+        case 1: {
+          auto result = common_prefix;
+          result[yb::RandomUniformInt<size_t>(0, result.size() - 1)] =
+              yb::RandomUniformBool() ? '\0' : '\xff';
+          return result;
+        }
+        default:
+          return common_prefix;
+      }
+    };
+
+    for (auto key_value_encoding_format : KeyValueEncodingFormatList()) {
+      for (auto restart_interval : {1, 4, 16}) {
+        BlockBuilder builder(restart_interval, key_value_encoding_format);
+        for (const auto& key : keys) {
+          builder.Add(key, key);
+        }
+        BlockContents contents;
+        contents.data = builder.Finish();
+        contents.cachable = false;
+        Block reader(std::move(contents));
+
+        for (auto use_prefixes : {false, true}) {
+          FLAGS_rocksdb_use_restart_key_prefixes = use_prefixes;
+          const auto memory_usage = reader.ApproximateMemoryUsage();
+          std::unique_ptr<InternalIterator> iter(
+              reader.NewIterator(&comparator, key_value_encoding_format));
+          if (use_prefixes) {
+            ASSERT_GT(reader.ApproximateMemoryUsage(), memory_usage);
+          }
+          for (int i = 0; i < kNumSeeks; ++i) {
+            const auto target = InternalKey(
+                random_target_prefix() + random_suffix(),
+                yb::RandomUniformInt<SequenceNumber>(0, kMaxSequenceNumber), kTypeValue);
+            const auto expected = std::lower_bound(
+                keys.begin(), keys.end(), target.Encode().ToString(),
+                [&comparator](const std::string& lhs, const std::string& rhs) {
+                  return comparator.Compare(lhs, rhs) < 0;
+                });
+            iter->Seek(target.Encode());
+            ASSERT_OK(iter->status());
+            if (expected == keys.end()) {
+              ASSERT_FALSE(iter->Valid()) << target.DebugString();
+            } else {
+              ASSERT_TRUE(iter->Valid()) << target.DebugString();
+              ASSERT_EQ(iter->key().ToDebugHexString(), Slice(*expected).ToDebugHexString());
+            }
+          }
+        }
+      }
+    }
+  }
+  FLAGS_rocksdb_use_restart_key_prefixes = false;
+}
+
+// Compares seek time within a data block with and without restart key prefixes. Keys resemble
+// DocDB keys of a table with a hash column and a range column: they share a short table prefix and
+// differ after it. Timings are logged, the test only checks that both modes find the same keys.
+TEST_F(BlockTest, YB_DISABLE_TEST_IN_SANITIZERS(RestartKeyPrefixesSeekPerf)) {
+  constexpr auto kNumKeys = 256;
+  constexpr auto kNumTargets = 1000;
+  constexpr auto kNumRounds = 1000;
+  const InternalKeyComparator comparator(BytewiseComparator());
+
+  std::vector<std::string> user_keys;
+  for (int i = 0; i < kNumKeys; ++i) {
+    user_keys.push_back(
+        "\x47\x12\x34" + yb::RandomString(8) + "!" + yb::RandomString(yb::RandomUniformInt(4, 24)));
+  }
+  std::sort(user_keys.begin(), user_keys.end());
+  user_keys.erase(std::unique(user_keys.begin(), user_keys.end()), user_keys.end());
+
+  std::vector<std::string> targets;
+  for (int i = 0; i < kNumTargets; ++i) {
+    const auto& user_key = user_keys[yb::RandomUniformInt<size_t>(0, user_keys.size() - 1)];
+    targets.push_back(InternalKey(user_key, kMaxSequenceNumber, kTypeValue).Encode().ToString());
+  }
+
+  for (auto key_value_encoding_format : KeyValueEncodingFormatList()) {
+    for (auto restart_interval : {4, 16}) {
+      BlockBuilder builder(restart_interval, key_value_encoding_format);
+      for (const auto& user_key : user_keys) {
+        auto key = InternalKey(user_key, kMaxSequenceNumber, kTypeValue).Encode().ToString();
+        builder.Add(key, key);
+      }
+      BlockContents contents;
+      contents.data = builder.Finish();
+      contents.cachable = false;
+      Block reader(std::move(contents));
+
+      std::vector<std::string> found[2];
+      for (auto use_prefixes : {false, true}) {
+        FLAGS_rocksdb_use_restart_key_prefixes = use_prefixes;
+        std::unique_ptr<InternalIterator> iter(
+            reader.NewIterator(&comparator, key_value_encoding_format));
+        auto& found_keys = found[use_prefixes];
+        for (const auto& target : targets) {
+          iter->Seek(target);
+          ASSERT_TRUE(iter->Valid());
+          found_keys.push_back(iter->key().ToBuffer());
+        }
+
+        auto start = yb::MonoTime::Now();
+        for (int round = 0; round < kNumRounds; ++round) {
+          for (const auto& target : targets) {
+            iter->Seek(target);
+          }
+        }
+        auto elapsed = yb::MonoTime::Now() - start;
+        LOG(INFO) << "Format: " << KeyValueEncodingFormatToString(key_value_encoding_format)
+                  << ", restart interval: " << restart_interval
+                  << ", use prefixes: " << use_prefixes << ", "
+                  << elapsed.ToNanoseconds() / (kNumRounds * kNumTargets) << " ns per seek";
+      }
+      ASSERT_EQ(found[false], found[true]);
+    }
+  }
+  FLAGS_rocksdb_use_restart_key_prefixes = false;
+}
+
 TEST_F(BlockTest, EncodeThreeSharedPartsSizes) {
   constexpr auto kNumIters = 100000;
 
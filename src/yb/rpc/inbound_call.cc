@@ -44,6 +44,7 @@
 #include "yb/util/flag_tags.h"
 #include "yb/util/logging.h"
 #include "yb/util/metrics.h"
+#include "yb/util/numa.h"
 #include "yb/util/trace.h"
 
 using std::shared_ptr;
@@ -84,6 +85,11 @@ InboundCall::InboundCall(ConnectionPtr conn, RpcMetrics* rpc_metrics,
   TRACE_TO(trace_, "Created InboundCall");
   IncrementCounter(rpc_metrics_->inbound_calls_created);
   IncrementGauge(rpc_metrics_->inbound_calls_alive);
+  auto numa_node_index = CurrentThreadNumaNodeIndex();
+  const auto& numa_node_counters = rpc_metrics_->inbound_calls_created_on_numa_node;
+  if (numa_node_index >= 0 && static_cast<size_t>(numa_node_index) < numa_node_counters.size()) {
+    IncrementCounter(numa_node_counters[numa_node_index]);
+  }
 }
 
 InboundCall::~InboundCall() {
@@ -66,6 +66,7 @@
 #include "yb/util/metric_entity.h"
 #include "yb/util/monotime.h"
 #include "yb/util/net/socket.h"
+#include "yb/util/numa.h"
 #include "yb/util/scope_exit.h"
 #include "yb/util/size_literals.h"
 #include "yb/util/status.h"
@@ -135,6 +136,7 @@ Reactor::Reactor(Messenger* messenger,
                  int index,
                  const MessengerBuilder &bld)
     : messenger_(messenger),
+      index_(index),
       name_(StringPrintf("%s_R%03d", messenger->name().c_str(), index)),
       log_prefix_(name_ + ": "),
       loop_(kDefaultLibEvFlags),
@@ -495,6 +497,12 @@ void Reactor::RunThread() {
   ThreadRestrictions::SetWaitAllowed(false);
   ThreadRestrictions::SetIOAllowed(false);
   DVLOG_WITH_PREFIX(6) << "Calling Reactor::RunThread()...";
+  // Connections are assigned to reactors, so binding the reactor to a NUMA node makes it the home
+  // node of its connections and their buffers.
+  auto numa_node_index = MaybeBindCurrentThreadToNumaNode(index_);
+  if (numa_node_index >= 0) {
+    VLOG_WITH_PREFIX(1) << "Bound to NUMA node " << NumaNodes()[numa_node_index].id;
+  }
   loop_.run(/* flags */ 0);
   VLOG_WITH_PREFIX(1) << "thread exiting.";
 }
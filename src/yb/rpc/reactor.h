@@ -445,6 +445,9 @@ class Reactor {
   // parent messenger
   Messenger* const messenger_;
 
+  // Index of this reactor in the messenger, also determines its NUMA node.
+  const int index_;
+
   const std::string name_;
 
   const std::string log_prefix_;
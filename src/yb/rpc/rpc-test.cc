@@ -80,6 +80,7 @@ METRIC_DECLARE_histogram(rpc_incoming_queue_time);
 METRIC_DECLARE_counter(tcp_bytes_sent);
 METRIC_DECLARE_counter(tcp_bytes_received);
 METRIC_DECLARE_counter(rpcs_timed_out_early_in_queue);
+METRIC_DECLARE_counter(rpcs_handled_inline);
 
 DEFINE_int32(rpc_test_connection_keepalive_num_iterations, 1,
   "Number of iterations in TestRpc.TestConnectionKeepalive");
@@ -701,6 +702,38 @@ TEST_F(TestRpc, TestRpcHandlerLatencyMetric) {
   ASSERT_OK(GetHistogram(metric_entity(), METRIC_rpc_incoming_queue_time));
 }
 
+TEST_F(TestRpc, RunToCompletion) {
+  HostPort server_addr;
+  StartTestServerWithGeneratedCode(&server_addr);
+
+  auto client_messenger = CreateAutoShutdownMessengerHolder("Client");
+  ProxyCache proxy_cache(client_messenger.get());
+  CalculatorServiceProxy p(&proxy_cache, server_addr, client_messenger->DefaultProtocol());
+
+  // Ping is annotated as run_to_completion in rtest.proto.
+  constexpr int kNumCalls = 10;
+  for (int i = 0; i < kNumCalls; i++) {
+    RpcController controller;
+    controller.set_timeout(5s * kTimeMultiplier);
+    rpc_test::PingRequestPB req;
+    req.set_id(i);
+    rpc_test::PingResponsePB resp;
+    ASSERT_OK(p.Ping(req, &resp, &controller));
+  }
+  // Not annotated, so should go through the service queue.
+  RpcController controller;
+  controller.set_timeout(5s * kTimeMultiplier);
+  rpc_test::AddRequestPB req;
+  req.set_x(10);
+  req.set_y(20);
+  rpc_test::AddResponsePB resp;
+  ASSERT_OK(p.Add(req, &resp, &controller));
+  ASSERT_EQ(30, resp.result());
+
+  auto counter = ASSERT_RESULT(GetCounter(metric_entity(), METRIC_rpcs_handled_inline));
+  ASSERT_EQ(counter->value(), kNumCalls);
+}
+
 TEST_F(TestRpc, TestRpcCallbackDestroysMessenger) {
   auto client_messenger = CreateAutoShutdownMessengerHolder("Client");
   HostPort bad_addr;
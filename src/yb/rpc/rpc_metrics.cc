@@ -13,7 +13,10 @@
 
 #include "yb/rpc/rpc_metrics.h"
 
+#include "yb/util/format.h"
+#include "yb/util/metric_entity.h"
 #include "yb/util/metrics.h"
+#include "yb/util/numa.h"
 
 METRIC_DEFINE_gauge_int64(server, rpc_connections_alive,
                           "Number of alive RPC connections.",
@@ -56,6 +59,22 @@ RpcMetrics::RpcMetrics(const scoped_refptr<MetricEntity>& metric_entity) {
     inbound_calls_created = METRIC_rpc_inbound_calls_created.Instantiate(metric_entity);
     outbound_calls_alive = METRIC_rpc_outbound_calls_alive.Instantiate(metric_entity, 0);
     outbound_calls_created = METRIC_rpc_outbound_calls_created.Instantiate(metric_entity);
+    // Per node metrics are created only when threads are spread over NUMA nodes, for each of them.
+    auto num_nodes = NumNumaPlacementNodes();
+    if (num_nodes > 1) {
+      inbound_calls_created_on_numa_node.reserve(num_nodes);
+      for (size_t i = 0; i != num_nodes; ++i) {
+        auto node_id = NumaNodes()[i].id;
+        inbound_calls_created_on_numa_node.push_back(metric_entity->FindOrCreateCounter(
+            std::make_unique<OwningCounterPrototype>(
+                "server", Format("rpc_inbound_calls_created_numa_node$0", node_id),
+                Format("Number of RPC inbound calls received on NUMA node $0.", node_id),
+                MetricUnit::kRequests,
+                Format("Number of RPC inbound calls received by reactors bound to NUMA node $0.",
+                       node_id),
+                MetricLevel::kInfo)));
+      }
+    }
   }
 }
 
@@ -14,6 +14,8 @@
 #ifndef YB_RPC_RPC_METRICS_H
 #define YB_RPC_RPC_METRICS_H
 
+#include <vector>
+
 #include "yb/util/metrics_fwd.h"
 
 namespace yb {
@@ -28,6 +30,10 @@ struct RpcMetrics {
   scoped_refptr<Counter> inbound_calls_created;
   scoped_refptr<AtomicGauge<int64_t>> outbound_calls_alive;
   scoped_refptr<Counter> outbound_calls_created;
+
+  // Inbound calls received by reactors bound to each NUMA node, see numa_aware_thread_placement.
+  // Indexed by position of the node in NumaNodes(). Empty when threads are not bound to nodes.
+  std::vector<scoped_refptr<Counter>> inbound_calls_created_on_numa_node;
 };
 
 } // namespace rpc
@@ -47,6 +47,10 @@ ServiceIf::~ServiceIf() {
 void ServiceIf::Shutdown() {
 }
 
+std::vector<size_t> ServiceIf::RunToCompletionMethods() const {
+  return {};
+}
+
 RpcMethodMetrics::RpcMethodMetrics() = default;
 
 RpcMethodMetrics::RpcMethodMetrics(const scoped_refptr<Counter>& request_bytes_,
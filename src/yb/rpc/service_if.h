@@ -33,6 +33,7 @@
 #define YB_RPC_SERVICE_IF_H_
 
 #include <string>
+#include <vector>
 
 #include <boost/functional/hash.hpp>
 
@@ -81,6 +82,10 @@ class ServiceIf {
 
   virtual void Shutdown();
   virtual std::string service_name() const = 0;
+
+  // Indexes of methods annotated as run_to_completion in the service proto, i.e. methods whose
+  // handlers are cheap and never block.
+  virtual std::vector<size_t> RunToCompletionMethods() const;
 };
 
 }  // namespace rpc
@@ -51,7 +51,9 @@
 #include "yb/gutil/ref_counted.h"
 #include "yb/gutil/strings/substitute.h"
 
+#include "yb/rpc/connection.h"
 #include "yb/rpc/inbound_call.h"
+#include "yb/rpc/reactor.h"
 #include "yb/rpc/scheduler.h"
 #include "yb/rpc/service_if.h"
 
@@ -64,6 +66,7 @@
 #include "yb/util/net/sockaddr.h"
 #include "yb/util/scope_exit.h"
 #include "yb/util/status.h"
+#include "yb/util/thread_restrictions.h"
 #include "yb/util/trace.h"
 
 using namespace std::literals;
@@ -85,6 +88,18 @@ DEFINE_test_flag(bool, enable_backpressure_mode_for_testing, false,
             "For testing purposes. Enables the rpc's to be considered timed out in the queue even "
             "when we have not had any backpressure in the recent past.");
 
+DEFINE_bool(rpc_run_to_completion, true,
+            "Execute RPC methods annotated as run_to_completion in their service proto inline on "
+            "the reactor thread that received them, instead of handing them off to the service "
+            "thread pool.");
+TAG_FLAG(rpc_run_to_completion, advanced);
+DEFINE_int64(rpc_run_to_completion_max_handler_time_us, 1000,
+             "If an inline RPC handler runs longer than this on the reactor thread, the method "
+             "is demoted back to the service thread pool for the lifetime of the process. "
+             "0 disables demotion.");
+TAG_FLAG(rpc_run_to_completion_max_handler_time_us, advanced);
+TAG_FLAG(rpc_run_to_completion_max_handler_time_us, runtime);
+
 METRIC_DEFINE_coarse_histogram(server, rpc_incoming_queue_time,
                         "RPC Queue Time",
                         yb::MetricUnit::kMicroseconds,
@@ -104,6 +119,12 @@ METRIC_DEFINE_counter(server, rpcs_timed_out_early_in_queue,
                       "in the service queue, and thus were not processed. "
                       "Timeout for those calls were detected before the calls tried to execute.");
 
+METRIC_DEFINE_counter(server, rpcs_handled_inline,
+                      "RPCs Handled Inline",
+                      yb::MetricUnit::kRequests,
+                      "Number of RPCs executed to completion on the reactor thread, "
+                      "bypassing the service queue.");
+
 METRIC_DEFINE_counter(server, rpcs_queue_overflow,
                       "RPC Queue Overflows",
                       yb::MetricUnit::kRequests,
@@ -136,6 +157,7 @@ class ServicePoolImpl final : public InboundCallHandler {
         rpcs_timed_out_early_in_queue_(
             METRIC_rpcs_timed_out_early_in_queue.Instantiate(entity)),
         rpcs_queue_overflow_(METRIC_rpcs_queue_overflow.Instantiate(entity)),
+        rpcs_handled_inline_(METRIC_rpcs_handled_inline.Instantiate(entity)),
         check_timeout_strand_(scheduler->io_service()),
         log_prefix_(Format("$0: ", service_->service_name())) {
 
@@ -149,6 +171,8 @@ class ServicePoolImpl final : public InboundCallHandler {
                   description, MetricUnit::kRequests, description, MetricLevel::kInfo)),
               static_cast<int64>(0) /* initial_value */);
 
+          InitRunToCompletionMethods();
+
           LOG_WITH_PREFIX(INFO) << "yb::rpc::ServicePoolImpl created at " << this;
   }
 
@@ -183,6 +207,10 @@ class ServicePoolImpl final : public InboundCallHandler {
   }
 
   void Enqueue(const InboundCallPtr& call) {
+    if (PREDICT_FALSE(!run_to_completion_methods_.empty()) && TryRunToCompletion(call)) {
+      return;
+    }
+
     TRACE_TO(call->trace(), "Inserting onto call queue");
 
     auto task = call->BindTask(this);
@@ -282,6 +310,71 @@ class ServicePoolImpl final : public InboundCallHandler {
   }
 
  private:
+  // Method statically classified as cheap and non-blocking, so it could be run on the reactor
+  // thread.
+  struct RunToCompletionMethod {
+    size_t index;
+    // Set once the method was caught running too long on the reactor.
+    std::atomic<bool> demoted{false};
+
+    explicit RunToCompletionMethod(size_t index_) : index(index_) {}
+  };
+
+  void InitRunToCompletionMethods() {
+    if (!FLAGS_rpc_run_to_completion) {
+      return;
+    }
+    for (auto index : service_->RunToCompletionMethods()) {
+      run_to_completion_methods_.emplace_back(std::make_unique<RunToCompletionMethod>(index));
+    }
+  }
+
+  RunToCompletionMethod* FindRunToCompletionMethod(size_t method_index) {
+    // Only a few methods are annotated, so linear search is cheaper than hashing.
+    for (const auto& method : run_to_completion_methods_) {
+      if (method->index == method_index) {
+        return method.get();
+      }
+    }
+    return nullptr;
+  }
+
+  // Executes the call inline when it is received on a reactor thread and its method is
+  // classified as run-to-completion. Returns false if the call should be queued as usual.
+  bool TryRunToCompletion(const InboundCallPtr& call) {
+    auto* method = FindRunToCompletionMethod(call->method_index());
+    if (!method || method->demoted.load(std::memory_order_acquire) ||
+        closing_.load(std::memory_order_acquire)) {
+      return false;
+    }
+    auto connection = call->connection();
+    if (!connection || !connection->reactor()->IsCurrentThread()) {
+      return false;
+    }
+
+    TRACE_TO(call->trace(), "Running to completion on reactor");
+    rpcs_handled_inline_->Increment();
+    auto start = MonoTime::Now();
+    {
+      // Reactor threads already forbid blocking, but make it explicit so that a misclassified
+      // handler is caught in debug builds regardless of the calling context.
+      bool wait_allowed = ThreadRestrictions::SetWaitAllowed(false);
+      bool io_allowed = ThreadRestrictions::SetIOAllowed(false);
+      Handle(call);
+      ThreadRestrictions::SetIOAllowed(io_allowed);
+      ThreadRestrictions::SetWaitAllowed(wait_allowed);
+    }
+    auto max_time_us = GetAtomicFlag(&FLAGS_rpc_run_to_completion_max_handler_time_us);
+    auto elapsed = MonoTime::Now() - start;
+    if (max_time_us > 0 && elapsed > MonoDelta::FromMicroseconds(max_time_us) &&
+        !method->demoted.exchange(true, std::memory_order_acq_rel)) {
+      LOG_WITH_PREFIX(WARNING)
+          << call->method_name().ToBuffer() << " took " << elapsed << " on reactor thread, "
+          << "demoting it to the service thread pool";
+    }
+    return true;
+  }
+
   void TimedOut(InboundCall* call, const char* error_message, Counter* metric) {
     if (call->RespondTimedOutIfPending(error_message)) {
       metric->Increment();
@@ -416,7 +509,10 @@ class ServicePoolImpl final : public InboundCallHandler {
   scoped_refptr<Counter> rpcs_timed_out_in_queue_;
   scoped_refptr<Counter> rpcs_timed_out_early_in_queue_;
   scoped_refptr<Counter> rpcs_queue_overflow_;
+  scoped_refptr<Counter> rpcs_handled_inline_;
   scoped_refptr<AtomicGauge<int64_t>> rpcs_in_queue_;
+  // Methods of this service that are executed inline on the reactor thread.
+  std::vector<std::unique_ptr<RunToCompletionMethod>> run_to_completion_methods_;
   // Have to use CoarseDuration here, since CoarseTimePoint does not work with clang + libstdc++
   std::atomic<CoarseDuration> last_backpressure_at_{CoarseTimePoint().time_since_epoch()};
   std::atomic<int64_t> queued_calls_{0};
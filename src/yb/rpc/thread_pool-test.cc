@@ -22,11 +22,13 @@
 #include "yb/rpc/thread_pool.h"
 
 #include "yb/util/countdown_latch.h"
+#include "yb/util/numa.h"
 #include "yb/util/test_util.h"
 #include "yb/util/thread.h"
 #include "yb/util/tsan_util.h"
 
 DECLARE_int32(TEST_strand_done_inject_delay_ms);
+DECLARE_bool(numa_aware_thread_placement);
 
 using namespace std::literals;
 
@@ -259,6 +261,71 @@ TEST_F(ThreadPoolTest, TestOwns) {
   ASSERT_TRUE(pool.Owns(task.thread()));
 }
 
+// Tasks submitted from a thread bound to a NUMA node are executed by idle workers of that node.
+TEST_F(ThreadPoolTest, NumaRouting) {
+  FLAGS_numa_aware_thread_placement = true;
+  const auto num_nodes = NumNumaPlacementNodes();
+  if (num_nodes < 2) {
+    LOG(INFO) << "Skipping test on machine with " << num_nodes << " NUMA nodes";
+    return;
+  }
+
+  class NodeTask : public ThreadPoolTask {
+   public:
+    explicit NodeTask(CountDownLatch* start = nullptr) : start_(start) {}
+
+    void Run() override {
+      node_ = CurrentThreadNumaNodeIndex();
+      if (start_) {
+        start_->CountDown();
+        start_->Wait();
+      }
+    }
+
+    void Done(const Status& status) override {
+      latch_.CountDown();
+    }
+
+    int Wait() {
+      latch_.Wait();
+      return node_;
+    }
+
+   private:
+    CountDownLatch* start_;
+    CountDownLatch latch_{1};
+    std::atomic<int> node_{-1};
+  };
+
+  const size_t kTotalWorkers = num_nodes * 2;
+  ThreadPool pool("test", kTotalWorkers * 2, kTotalWorkers);
+
+  // Keep all workers busy at the same time, so all of them are started.
+  {
+    CountDownLatch start(kTotalWorkers);
+    std::vector<std::unique_ptr<NodeTask>> tasks;
+    for (size_t i = 0; i != kTotalWorkers; ++i) {
+      tasks.push_back(std::make_unique<NodeTask>(&start));
+      ASSERT_TRUE(pool.Enqueue(tasks.back().get()));
+    }
+    for (auto& task : tasks) {
+      ASSERT_GE(task->Wait(), 0);
+    }
+  }
+
+  for (size_t i = 0; i != num_nodes * 3; ++i) {
+    std::thread thread([i, &pool] {
+      CDSAttacher attacher;
+      auto node = MaybeBindCurrentThreadToNumaNode(i);
+      ASSERT_GE(node, 0);
+      NodeTask task;
+      ASSERT_TRUE(pool.Enqueue(&task));
+      ASSERT_EQ(task.Wait(), node);
+    });
+    thread.join();
+  }
+}
+
 namespace strand {
 
 constexpr size_t kPoolMaxTasks = 100;
@@ -21,6 +21,7 @@
 #include <cds/container/basket_queue.h>
 #include <cds/gc/dhp.h>
 
+#include "yb/util/numa.h"
 #include "yb/util/scope_exit.h"
 #include "yb/util/status_format.h"
 #include "yb/util/thread.h"
@@ -35,13 +36,35 @@ class Worker;
 typedef cds::container::BasketQueue<cds::gc::DHP, ThreadPoolTask*> TaskQueue;
 typedef cds::container::BasketQueue<cds::gc::DHP, Worker*> WaitingWorkers;
 
-struct ThreadPoolShare {
-  ThreadPoolOptions options;
+// Tasks and idle workers of a single NUMA node, see numa_aware_thread_placement.
+struct NodeQueues {
   TaskQueue task_queue;
   WaitingWorkers waiting_workers;
+};
+
+struct ThreadPoolShare {
+  ThreadPoolOptions options;
+  // A single entry unless threads are spread over NUMA nodes. Tasks are queued on the node of the
+  // thread that submitted them, e.g. the reactor that received the call, and idle workers of that
+  // node are notified first. Workers take tasks of their own node first, then of other nodes.
+  std::vector<std::unique_ptr<NodeQueues>> nodes;
 
   explicit ThreadPoolShare(ThreadPoolOptions o)
-      : options(std::move(o)) {}
+      : options(std::move(o)) {
+    nodes.resize(NumNumaPlacementNodes());
+    for (auto& node : nodes) {
+      node = std::make_unique<NodeQueues>();
+    }
+  }
+
+  bool PopTask(size_t first_node, ThreadPoolTask** task) {
+    for (size_t i = 0; i != nodes.size(); ++i) {
+      if (nodes[(first_node + i) % nodes.size()]->task_queue.pop(*task)) {
+        return true;
+      }
+    }
+    return false;
+  }
 };
 
 namespace {
@@ -57,6 +80,7 @@ class Worker {
   }
 
   Status Start(size_t index) {
+    node_ = index % share_->nodes.size();
     auto name = strings::Substitute("rpc_tp_$0_$1", share_->options.name, index);
     return yb::Thread::Create(kRpcThreadCategory, name, &Worker::Execute, this, &thread_);
   }
@@ -98,6 +122,9 @@ class Worker {
   // does not have free hands (worker queue empty)
   void Execute() {
     Thread::current_thread()->SetUserData(share_);
+    if (share_->nodes.size() > 1) {
+      MaybeBindCurrentThreadToNumaNode(node_);
+    }
     while (!stop_requested_) {
       ThreadPoolTask* task = nullptr;
       if (PopTask(&task)) {
@@ -110,7 +137,7 @@ class Worker {
   bool PopTask(ThreadPoolTask** task) {
     // First of all we try to get already queued task, w/o locking.
     // If there is no task, so we could go to waiting state.
-    if (share_->task_queue.pop(*task)) {
+    if (share_->PopTask(node_, task)) {
       return true;
     }
     std::unique_lock<std::mutex> lock(mutex_);
@@ -126,7 +153,7 @@ class Worker {
       // the worker queue. So worker queue could be empty in this case, and nobody was notified
       // about new task. So we check there for this case. This technique is similar to
       // double check.
-      if (share_->task_queue.pop(*task)) {
+      if (share_->PopTask(node_, task)) {
         return true;
       }
 
@@ -134,7 +161,7 @@ class Worker {
 
       // Sometimes another worker could steal task before we wake up. In this case we will
       // just enqueue ourselves back.
-      if (share_->task_queue.pop(*task)) {
+      if (share_->PopTask(node_, task)) {
         return true;
       }
     }
@@ -143,13 +170,15 @@ class Worker {
 
   void AddToWaitingWorkers() {
     if (!added_to_waiting_workers_) {
-      auto pushed = share_->waiting_workers.push(this);
+      auto pushed = share_->nodes[node_]->waiting_workers.push(this);
       DCHECK(pushed); // BasketQueue always succeed.
       added_to_waiting_workers_ = true;
     }
   }
 
   ThreadPoolShare* share_;
+  // Position of the NUMA node of this worker in share_->nodes.
+  size_t node_ = 0;
   scoped_refptr<yb::Thread> thread_;
   std::mutex mutex_;
   std::condition_variable cond_;
@@ -182,13 +211,19 @@ class ThreadPool::Impl {
       task->Done(shutdown_status_);
       return false;
     }
-    bool added = share_.task_queue.push(task);
+    const auto num_nodes = share_.nodes.size();
+    const auto node = num_nodes == 1 ? 0 : SubmitterNode();
+    bool added = share_.nodes[node]->task_queue.push(task);
     DCHECK(added); // BasketQueue always succeed.
     Worker* worker = nullptr;
-    while (share_.waiting_workers.pop(worker)) {
-      if (worker->Notify()) {
-        --adding_;
-        return true;
+    // Prefer idle workers of the same node, otherwise a worker of another node takes the task.
+    for (size_t i = 0; i != num_nodes; ++i) {
+      auto& waiting_workers = share_.nodes[(node + i) % num_nodes]->waiting_workers;
+      while (waiting_workers.pop(worker)) {
+        if (worker->Notify()) {
+          --adding_;
+          return true;
+        }
       }
     }
     --adding_;
@@ -222,7 +257,9 @@ class ThreadPool::Impl {
     {
       std::lock_guard<std::mutex> lock(mutex_);
       if (closing_) {
-        CHECK(share_.task_queue.empty());
+        for (const auto& node : share_.nodes) {
+          CHECK(node->task_queue.empty());
+        }
         CHECK(workers_.empty());
         return;
       }
@@ -241,7 +278,7 @@ class ThreadPool::Impl {
     }
     workers_.clear();
     ThreadPoolTask* task = nullptr;
-    while (share_.task_queue.pop(task)) {
+    while (share_.PopTask(0, &task)) {
       task->Done(shutdown_status_);
     }
   }
@@ -251,12 +288,23 @@ class ThreadPool::Impl {
   }
 
  private:
+  // Node of the thread that submits a task. Threads that are not bound to a node spread their
+  // tasks over all nodes.
+  size_t SubmitterNode() {
+    auto node = CurrentThreadNumaNodeIndex();
+    if (node >= 0) {
+      return node % share_.nodes.size();
+    }
+    return next_unbound_node_.fetch_add(1, std::memory_order_relaxed) % share_.nodes.size();
+  }
+
   ThreadPoolShare share_;
   std::vector<std::unique_ptr<Worker>> workers_;
   std::atomic<size_t> created_workers_ = {0};
   std::mutex mutex_;
   std::atomic<bool> closing_ = {false};
   std::atomic<size_t> adding_ = {0};
+  std::atomic<size_t> next_unbound_node_ = {0};
   const Status shutdown_status_ = STATUS(Aborted, "Service is shutting down");
   const Status queue_full_status_;
 };
@@ -31,6 +31,7 @@
 //
 
 #include <algorithm>
+#include <thread>
 
 #include <glog/logging.h>
 #include <gtest/gtest.h>
@@ -219,5 +220,57 @@ TEST_F(HybridClockTest, CompareHybridClocksToDelta) {
       MonoDelta::FromMicroseconds(1)));
 }
 
+TEST(TscClockTest, TracksUnderlyingClock) {
+  auto clock = TscWallClock();
+  // Run long enough for the TSC clock to calibrate and start extrapolating.
+  auto deadline = MonoTime::Now() + MonoDelta::FromMilliseconds(500);
+  while (MonoTime::Now() < deadline) {
+    auto before = ASSERT_RESULT(WallClock()->Now());
+    auto now = ASSERT_RESULT(clock->Now());
+    auto after = ASSERT_RESULT(WallClock()->Now());
+    ASSERT_GE(now.time_point + now.max_error, before.time_point - before.max_error);
+    ASSERT_LE(now.time_point - now.max_error, after.time_point + after.max_error);
+  }
+}
+
+namespace {
+
+void MeasureHybridClockNow(const std::string& name, const PhysicalClockPtr& physical_clock,
+                           int num_threads) {
+  constexpr int kIterations = 1000000;
+  scoped_refptr<HybridClock> clock(new HybridClock(physical_clock));
+  ASSERT_OK(clock->Init());
+  std::vector<std::thread> threads;
+  auto start = MonoTime::Now();
+  for (int i = 0; i != num_threads; ++i) {
+    threads.emplace_back([clock] {
+      for (int j = 0; j != kIterations; ++j) {
+        clock->Now();
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  auto passed = MonoTime::Now() - start;
+  LOG(INFO) << name << ", threads: " << num_threads << ", time: " << passed << ", ops/sec: "
+            << num_threads * kIterations / passed.ToSeconds();
+}
+
+} // namespace
+
+TEST(HybridClockPerfTest, TscVsWallClock) {
+  if (!AllowSlowTests()) {
+    LOG(INFO) << "Skipping benchmark in fast-test mode";
+    return;
+  }
+
+  const int kMaxThreads = std::max(1u, std::thread::hardware_concurrency());
+  for (int num_threads : {1, kMaxThreads}) {
+    MeasureHybridClockNow("WallClock", WallClock(), num_threads);
+    MeasureHybridClockNow("TscWallClock", TscWallClock(), num_threads);
+  }
+}
+
 }  // namespace server
 }  // namespace yb
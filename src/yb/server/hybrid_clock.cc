@@ -71,6 +71,12 @@ DEFINE_string(time_source, "",
               "specific for appropriate tests, that adds them.");
 TAG_FLAG(time_source, hidden);
 
+DEFINE_bool(use_tsc_clock, false,
+            "Read wall clock time from a process-wide time page extrapolated by the CPU time "
+            "stamp counter, instead of calling clock_gettime for every hybrid time. Used only "
+            "when the TSC is invariant.");
+TAG_FLAG(use_tsc_clock, advanced);
+
 DEFINE_bool(fail_on_out_of_range_clock_skew, true,
             "In case transactional tables are present, crash the process if clock skew greater "
             "than the configured maximum.");
@@ -100,7 +106,7 @@ std::atomic<bool> clock_skew_control_enabled{false};
 // clock factory.
 PhysicalClockPtr GetClock(const std::string& options) {
   if (options.empty()) {
-    return WallClock();
+    return FLAGS_use_tsc_clock ? TscWallClock() : WallClock();
   }
 
   auto pos = options.find(',');
@@ -45,6 +45,7 @@
 #include "yb/util/random_util.h"
 #include "yb/util/scope_exit.h"
 #include "yb/util/status.h"
+#include "yb/util/test_thread_holder.h"
 #include "yb/util/test_util.h"
 
 using namespace std::literals;
@@ -52,6 +53,8 @@ using std::vector;
 
 using yb::server::LogicalClock;
 
+DECLARE_bool(mvcc_lock_free_safe_time);
+
 namespace yb {
 namespace tablet {
 
@@ -65,6 +68,9 @@ class MvccTest : public YBTest {
  protected:
   void RunRandomizedTest(bool use_ht_lease);
 
+  // Returns number of safe time reads per second.
+  double RunSafeTimeContention(bool lock_free);
+
   server::ClockPtr clock_;
   MvccManager manager_;
 };
@@ -92,6 +98,9 @@ TEST_F(MvccTest, Basic) {
 }
 
 TEST_F(MvccTest, SafeHybridTimeToReadAt) {
+  // Safe time calculated without the mutex is not recorded in the trace checked below.
+  FLAGS_mvcc_lock_free_safe_time = false;
+
   std::ostringstream mvcc_op_trace_stream;
   manager_.TEST_DumpTrace(&mvcc_op_trace_stream);
   ASSERT_STR_CONTAINS(mvcc_op_trace_stream.str(), "No MVCC operations");
@@ -367,5 +376,75 @@ TEST_F(MvccTest, WaitForSafeTime) {
   ASSERT_FALSE(manager_.SafeTime(ht3, CoarseMonoClock::now() + 100ms, FixedHybridTimeLease()));
 }
 
+double MvccTest::RunSafeTimeContention(bool lock_free) {
+  constexpr int kNumReaders = 8;
+  constexpr auto kTestDuration = 3s;
+
+  FLAGS_mvcc_lock_free_safe_time = lock_free;
+
+  TestThreadHolder thread_holder;
+  std::atomic<uint64_t> num_reads{0};
+  std::atomic<uint64_t> num_writes{0};
+  std::atomic<uint64_t> last_replicated{HybridTime::kMin.ToUint64()};
+  // Max safe time returned to any reader. Safe time should be monotonic across all readers, and
+  // operations added after it was returned should get greater hybrid times.
+  std::atomic<uint64_t> max_safe_time{HybridTime::kMin.ToUint64()};
+
+  for (int i = 0; i != kNumReaders; ++i) {
+    thread_holder.AddThreadFunctor(
+        [this, &stop = thread_holder.stop_flag(), &num_reads, &last_replicated, &max_safe_time] {
+      HybridTime prev_safe_time = HybridTime::kMin;
+      uint64_t reads = 0;
+      while (!stop.load(std::memory_order_acquire)) {
+        HybridTime replicated(last_replicated.load(std::memory_order_acquire));
+        HybridTime returned_before(max_safe_time.load(std::memory_order_acquire));
+        auto safe_time = manager_.SafeTime(FixedHybridTimeLease());
+        ASSERT_GE(safe_time, replicated);
+        ASSERT_GE(safe_time, prev_safe_time);
+        ASSERT_GE(safe_time, returned_before);
+        UpdateAtomicMax(&max_safe_time, safe_time.ToUint64());
+        prev_safe_time = safe_time;
+        ++reads;
+      }
+      num_reads += reads;
+    });
+  }
+
+  thread_holder.AddThreadFunctor(
+      [this, &stop = thread_holder.stop_flag(), &num_writes, &last_replicated, &max_safe_time] {
+    int64_t index = 0;
+    while (!stop.load(std::memory_order_acquire)) {
+      OpId op_id(1, ++index);
+      HybridTime returned_before(max_safe_time.load(std::memory_order_acquire));
+      auto ht = manager_.AddLeaderPending(op_id);
+      ASSERT_GT(ht, returned_before);
+      if (RandomUniformInt(0, 7) == 0) {
+        manager_.Aborted(ht, op_id);
+        continue;
+      }
+      manager_.Replicated(ht, op_id);
+      last_replicated.store(ht.ToUint64(), std::memory_order_release);
+      ++num_writes;
+    }
+  });
+
+  auto start = CoarseMonoClock::now();
+  thread_holder.WaitAndStop(kTestDuration);
+  auto passed_sec = MonoDelta(CoarseMonoClock::now() - start).ToSeconds();
+
+  auto reads_per_sec = num_reads.load() / passed_sec;
+  LOG(INFO) << (lock_free ? "Lock free" : "Locked") << " safe time, reads/sec: " << reads_per_sec
+            << ", writes/sec: " << num_writes.load() / passed_sec;
+  return reads_per_sec;
+}
+
+// Concurrent safe time readers together with a writer, checks that safe time is monotonic and
+// never reaches hybrid time of a pending operation. Also serves as a contention benchmark.
+TEST_F(MvccTest, SafeTimeContention) {
+  auto locked_reads_per_sec = RunSafeTimeContention(/* lock_free= */ false);
+  auto lock_free_reads_per_sec = RunSafeTimeContention(/* lock_free= */ true);
+  LOG(INFO) << "Lock free speedup: " << lock_free_reads_per_sec / locked_reads_per_sec;
+}
+
 } // namespace tablet
 } // namespace yb
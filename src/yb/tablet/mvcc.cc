@@ -53,6 +53,13 @@ DEFINE_test_flag(int64, mvcc_op_trace_num_items, 32,
 DEFINE_test_flag(int32, inject_mvcc_delay_add_leader_pending_ms, 0,
                  "Inject delay after MvccManager::AddLeaderPending read clock.");
 
+DEFINE_bool(mvcc_lock_free_safe_time, true,
+            "Whether MvccManager should try to calculate leader safe time without acquiring its "
+            "mutex. The locked path is still used when the operation queue is being modified "
+            "concurrently, or when the caller has to wait for safe time.");
+TAG_FLAG(mvcc_lock_free_safe_time, advanced);
+TAG_FLAG(mvcc_lock_free_safe_time, runtime);
+
 namespace yb {
 namespace tablet {
 
@@ -241,6 +248,53 @@ std::string SafeTimeWithSource::ToString() const {
   return Format("{ safe_time: $0 source: $1 }", safe_time, source);
 }
 
+// ------------------------------------------------------------------------------------------------
+// AtomicSafeTimeWithSource
+// ------------------------------------------------------------------------------------------------
+
+SafeTimeWithSource AtomicSafeTimeWithSource::Load() const {
+  return SafeTimeWithSource {
+    .safe_time = safe_time_.load(std::memory_order_acquire),
+    .source = source_.load(std::memory_order_acquire),
+  };
+}
+
+void AtomicSafeTimeWithSource::UpdateMax(const SafeTimeWithSource& value) {
+  auto current = safe_time_.load(std::memory_order_acquire);
+  while (value.safe_time > current) {
+    if (safe_time_.compare_exchange_weak(current, value.safe_time)) {
+      source_.store(value.source, std::memory_order_release);
+      return;
+    }
+  }
+}
+
+// ------------------------------------------------------------------------------------------------
+// MvccManager::StateUpdateScope
+// ------------------------------------------------------------------------------------------------
+
+// Makes state_version_ odd for the lifetime of the scope, and publishes the state that is read by
+// TryGetSafeTimeLockFree before making it even again.
+class MvccManager::StateUpdateScope {
+ public:
+  explicit StateUpdateScope(MvccManager* mvcc) : mvcc_(*mvcc) {
+    // Sequentially consistent, because AddLeaderPending reads the clock after this point, and
+    // lock free readers should either observe the odd version or read the clock before it.
+    mvcc_.state_version_.fetch_add(1, std::memory_order_seq_cst);
+  }
+
+  ~StateUpdateScope() {
+    mvcc_.published_queue_front_.store(
+        mvcc_.queue_.empty() ? HybridTime::kInvalid : mvcc_.queue_.front().hybrid_time,
+        std::memory_order_relaxed);
+    mvcc_.published_last_replicated_.store(mvcc_.last_replicated_, std::memory_order_relaxed);
+    mvcc_.state_version_.fetch_add(1, std::memory_order_release);
+  }
+
+ private:
+  MvccManager& mvcc_;
+};
+
 // ------------------------------------------------------------------------------------------------
 // MvccManager
 // ------------------------------------------------------------------------------------------------
@@ -263,6 +317,7 @@ void MvccManager::Replicated(HybridTime ht, const OpId& op_id) {
 
   {
     std::lock_guard<std::mutex> lock(mutex_);
+    StateUpdateScope state_update(this);
     if (op_trace_) {
       op_trace_->Add(ReplicatedTraceItem { .ht = ht, .op_id = op_id });
     }
@@ -280,6 +335,7 @@ void MvccManager::Aborted(HybridTime ht, const OpId& op_id) {
 
   {
     std::lock_guard<std::mutex> lock(mutex_);
+    StateUpdateScope state_update(this);
     if (op_trace_) {
       op_trace_->Add(AbortedTraceItem { .ht = ht, .op_id = op_id });
     }
@@ -304,6 +360,8 @@ bool BadNextOpId(const OpId& prev, const OpId& next) {
 
 HybridTime MvccManager::AddLeaderPending(const OpId& op_id) {
   std::lock_guard<std::mutex> lock(mutex_);
+  // Should be created before reading the clock, see TryGetSafeTimeLockFree.
+  StateUpdateScope state_update(this);
   auto ht = clock_->Now();
   AtomicFlagSleepMs(&FLAGS_TEST_inject_mvcc_delay_add_leader_pending_ms);
   VLOG_WITH_PREFIX(1) << __func__ << "(" << op_id << "), time: " << ht;
@@ -321,6 +379,7 @@ HybridTime MvccManager::AddLeaderPending(const OpId& op_id) {
 
 void MvccManager::AddFollowerPending(HybridTime ht, const OpId& op_id) {
   std::lock_guard<std::mutex> lock(mutex_);
+  StateUpdateScope state_update(this);
   VLOG_WITH_PREFIX(1) << __func__ << "(" << ht << ", " << op_id << ")";
 
   AddPending(ht, op_id, /* is_follower_side= */ true);
@@ -337,11 +396,13 @@ void MvccManager::AddPending(HybridTime ht, const OpId& op_id, bool is_follower_
   CHECK(!op_id.empty());
 
   HybridTime last_ht_in_queue = queue_.empty() ? HybridTime::kMin : queue_.back().hybrid_time;
+  const auto max_safe_time_returned_with_lease = max_safe_time_returned_with_lease_.Load();
+  const auto max_safe_time_returned_without_lease = max_safe_time_returned_without_lease_.Load();
 
   HybridTime sanity_check_lower_bound =
       std::max({
-          max_safe_time_returned_with_lease_.safe_time,
-          max_safe_time_returned_without_lease_.safe_time,
+          max_safe_time_returned_with_lease.safe_time,
+          max_safe_time_returned_without_lease.safe_time,
           max_safe_time_returned_for_follower_.safe_time,
           propagated_safe_time_,
           last_replicated_,
@@ -362,8 +423,8 @@ void MvccManager::AddPending(HybridTime ht, const OpId& op_id, bool is_follower_
 #define LOG_INFO_FOR_HT_LOWER_BOUND(t) LOG_INFO_FOR_HT_LOWER_BOUND_IMPL(t, t)
 
       ss << "New operation's hybrid time too low: " << ht << ", op id: " << op_id
-         << LOG_INFO_FOR_HT_LOWER_BOUND_WITH_SOURCE(max_safe_time_returned_with_lease_)
-         << LOG_INFO_FOR_HT_LOWER_BOUND_WITH_SOURCE(max_safe_time_returned_without_lease_)
+         << LOG_INFO_FOR_HT_LOWER_BOUND_WITH_SOURCE(max_safe_time_returned_with_lease)
+         << LOG_INFO_FOR_HT_LOWER_BOUND_WITH_SOURCE(max_safe_time_returned_without_lease)
          << LOG_INFO_FOR_HT_LOWER_BOUND_WITH_SOURCE(max_safe_time_returned_for_follower_)
          << LOG_INFO_FOR_HT_LOWER_BOUND(last_replicated_)
          << LOG_INFO_FOR_HT_LOWER_BOUND(last_ht_in_queue)
@@ -410,6 +471,7 @@ void MvccManager::SetLastReplicated(HybridTime ht) {
 
   {
     std::lock_guard<std::mutex> lock(mutex_);
+    StateUpdateScope state_update(this);
     if (op_trace_) {
       op_trace_->Add(SetLastReplicatedTraceItem { .ht = ht });
     }
@@ -544,6 +606,14 @@ HybridTime MvccManager::SafeTime(
     HybridTime min_allowed,
     CoarseTimePoint deadline,
     const FixedHybridTimeLease& ht_lease) const NO_THREAD_SAFETY_ANALYSIS {
+  if (GetAtomicFlag(&FLAGS_mvcc_lock_free_safe_time)) {
+    // Not recorded in op_trace_, since that would require the mutex.
+    auto safe_time = TryGetSafeTimeLockFree(min_allowed, ht_lease);
+    if (safe_time) {
+      return safe_time;
+    }
+  }
+
   std::unique_lock<std::mutex> lock(mutex_);
   auto safe_time = DoGetSafeTime(min_allowed, deadline, ht_lease, &lock);
   if (op_trace_) {
@@ -557,6 +627,71 @@ HybridTime MvccManager::SafeTime(
   return safe_time;
 }
 
+HybridTime MvccManager::TryGetSafeTimeLockFree(
+    HybridTime min_allowed, const FixedHybridTimeLease& ht_lease) const {
+  if (!ht_lease.lease.is_valid() || min_allowed > ht_lease.lease) {
+    // Let DoGetSafeTime report the invariant violation.
+    return HybridTime::kInvalid;
+  }
+
+  const auto version = state_version_.load(std::memory_order_acquire);
+  if (version & 1) {
+    return HybridTime::kInvalid;
+  }
+
+  const bool has_lease = !ht_lease.empty();
+  auto& max_safe_time_returned = has_lease ? max_safe_time_returned_with_lease_
+                                           : max_safe_time_returned_without_lease_;
+  // Should be read before calculating the result, since concurrent readers could increase it.
+  const auto enforced_min_time = max_safe_time_returned.safe_time();
+  const auto queue_front = published_queue_front_.load(std::memory_order_relaxed);
+  const auto last_replicated = published_last_replicated_.load(std::memory_order_relaxed);
+
+  // Same logic as in DoGetSafeTime.
+  HybridTime result;
+  SafeTimeSource source;
+  if (!queue_front.is_valid()) {
+    result = ht_lease.time.is_valid()
+        ? std::max(max_safe_time_returned_with_lease_.safe_time(), ht_lease.time)
+        : clock_->Now();
+    source = SafeTimeSource::kNow;
+  } else {
+    result = queue_front.Decremented();
+    source = SafeTimeSource::kNextInQueue;
+  }
+
+  if (has_lease) {
+    auto used_lease = std::max({ht_lease.lease, max_safe_time_returned_with_lease_.safe_time()});
+    if (result > used_lease) {
+      result = used_lease;
+      source = SafeTimeSource::kHybridTimeLease;
+    }
+  }
+
+  result = std::max(result, last_replicated);
+  if (result < min_allowed) {
+    return HybridTime::kInvalid;
+  }
+
+  // If the version did not change, then no operation was added or replicated while we were
+  // calculating the result. AddLeaderPending makes the version odd before reading the clock, so
+  // operations added after this point will get hybrid time greater than the clock reading above.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (state_version_.load(std::memory_order_relaxed) != version) {
+    return HybridTime::kInvalid;
+  }
+
+  CHECK_GE(result, enforced_min_time)
+      << LogPrefix()
+      << EXPR_VALUE_FOR_LOG(has_lease)
+      << ", " << EXPR_VALUE_FOR_LOG(ht_lease)
+      << ", " << EXPR_VALUE_FOR_LOG(queue_front)
+      << ", " << EXPR_VALUE_FOR_LOG(last_replicated);
+
+  max_safe_time_returned.UpdateMax({ result, source });
+  return result;
+}
+
 HybridTime MvccManager::DoGetSafeTime(const HybridTime min_allowed,
                                       const CoarseTimePoint deadline,
                                       const FixedHybridTimeLease& ht_lease,
@@ -575,10 +710,17 @@ HybridTime MvccManager::DoGetSafeTime(const HybridTime min_allowed,
 
   HybridTime result;
   SafeTimeSource source = SafeTimeSource::kUnknown;
-  auto predicate = [this, &result, &source, min_allowed, ht_lease, has_lease] {
+  auto& max_safe_time_returned = has_lease ? max_safe_time_returned_with_lease_
+                                           : max_safe_time_returned_without_lease_;
+  HybridTime enforced_min_time;
+  auto predicate = [this, &result, &source, &enforced_min_time, &max_safe_time_returned,
+                    min_allowed, ht_lease, has_lease] {
+    // Lock free readers could increase returned safe time concurrently, so it should be read
+    // before calculating the result.
+    enforced_min_time = max_safe_time_returned.safe_time();
     if (queue_.empty()) {
       result = ht_lease.time.is_valid()
-          ? std::max(max_safe_time_returned_with_lease_.safe_time, ht_lease.time)
+          ? std::max(max_safe_time_returned_with_lease_.safe_time(), ht_lease.time)
           : clock_->Now();
       source = SafeTimeSource::kNow;
       VLOG_WITH_PREFIX(2) << "DoGetSafeTime, Now: " << result;
@@ -589,7 +731,7 @@ HybridTime MvccManager::DoGetSafeTime(const HybridTime min_allowed,
     }
 
     if (has_lease) {
-      auto used_lease = std::max({ht_lease.lease, max_safe_time_returned_with_lease_.safe_time});
+      auto used_lease = std::max({ht_lease.lease, max_safe_time_returned_with_lease_.safe_time()});
       if (result > used_lease) {
         result = used_lease;
         source = SafeTimeSource::kHybridTimeLease;
@@ -613,8 +755,6 @@ HybridTime MvccManager::DoGetSafeTime(const HybridTime min_allowed,
   VLOG_WITH_PREFIX_AND_FUNC(1)
       << "(" << min_allowed << ", " << ht_lease << "),  result = " << result;
 
-  auto enforced_min_time = has_lease ? max_safe_time_returned_with_lease_.safe_time
-                                     : max_safe_time_returned_without_lease_.safe_time;
   CHECK_GE(result, enforced_min_time)
       << InvariantViolationLogPrefix()
       << ": " << EXPR_VALUE_FOR_LOG(has_lease)
@@ -626,11 +766,7 @@ HybridTime MvccManager::DoGetSafeTime(const HybridTime min_allowed,
       << ", " << EXPR_VALUE_FOR_LOG(queue_.size())
       << ", " << EXPR_VALUE_FOR_LOG(queue_);
 
-  if (has_lease) {
-    max_safe_time_returned_with_lease_ = { result, source };
-  } else {
-    max_safe_time_returned_without_lease_ = { result, source };
-  }
+  max_safe_time_returned.UpdateMax({ result, source });
   return result;
 }
 
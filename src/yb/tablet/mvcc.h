@@ -32,6 +32,7 @@
 #ifndef YB_TABLET_MVCC_H_
 #define YB_TABLET_MVCC_H_
 
+#include <atomic>
 #include <condition_variable>
 #include <deque>
 #include <vector>
@@ -59,6 +60,23 @@ struct SafeTimeWithSource {
   std::string ToString() const;
 };
 
+// Maximum safe time returned so far, that could be updated without holding MvccManager mutex.
+// Source is used only for logging, so it is not updated atomically together with safe time.
+class AtomicSafeTimeWithSource {
+ public:
+  HybridTime safe_time() const {
+    return safe_time_.load(std::memory_order_acquire);
+  }
+
+  SafeTimeWithSource Load() const;
+
+  void UpdateMax(const SafeTimeWithSource& value);
+
+ private:
+  std::atomic<HybridTime> safe_time_{HybridTime::kMin};
+  std::atomic<SafeTimeSource> source_{SafeTimeSource::kUnknown};
+};
+
 struct FixedHybridTimeLease {
   HybridTime time;
   HybridTime lease = HybridTime::kMax;
@@ -157,6 +175,15 @@ class MvccManager {
                            const FixedHybridTimeLease& ht_lease,
                            std::unique_lock<std::mutex>* lock) const REQUIRES(mutex_);
 
+  // Tries to calculate safe time without acquiring mutex_, using the state published by the last
+  // modification of queue_ and last_replicated_. Returns invalid hybrid time when the state is
+  // being modified concurrently, or when the caller would have to wait for min_allowed.
+  HybridTime TryGetSafeTimeLockFree(
+      HybridTime min_allowed, const FixedHybridTimeLease& ht_lease) const EXCLUDES(mutex_);
+
+  // Should be alive while queue_ or last_replicated_ are being modified.
+  class StateUpdateScope;
+
   const std::string& LogPrefix() const { return prefix_; }
 
   struct InvariantViolationLoggingHelper;
@@ -208,10 +235,17 @@ class MvccManager {
   // Special flag for RF==1 mode when propagated_safe_time_ can be not up-to-date.
   bool leader_only_mode_ = false;
 
-  mutable SafeTimeWithSource max_safe_time_returned_with_lease_;
-  mutable SafeTimeWithSource max_safe_time_returned_without_lease_;
+  mutable AtomicSafeTimeWithSource max_safe_time_returned_with_lease_;
+  mutable AtomicSafeTimeWithSource max_safe_time_returned_without_lease_;
   mutable SafeTimeWithSource max_safe_time_returned_for_follower_ { HybridTime::kMin };
 
+  // Seqlock style version of the state used by TryGetSafeTimeLockFree. It is odd while queue_ or
+  // last_replicated_ are being modified.
+  std::atomic<uint64_t> state_version_{0};
+  // Hybrid time of the first operation in queue_, or invalid hybrid time if queue_ is empty.
+  std::atomic<HybridTime> published_queue_front_{HybridTime::kInvalid};
+  std::atomic<HybridTime> published_last_replicated_{HybridTime::kMin};
+
   std::unique_ptr<MvccOpTrace> op_trace_ GUARDED_BY(mutex_);
 };
 
@@ -14,6 +14,7 @@
 #include "yb/tablet/preparer.h"
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <memory>
 #include <mutex>
@@ -30,20 +31,38 @@
 
 #include "yb/tablet/operations/operation_driver.h"
 
+#include "yb/util/atomic.h"
 #include "yb/util/debug-util.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/lockfree.h"
 #include "yb/util/logging.h"
+#include "yb/util/metrics.h"
 #include "yb/util/threadpool.h"
 
 DEFINE_uint64(max_group_replicate_batch_size, 16,
               "Maximum number of operations to submit to consensus for replication in a batch.");
 
+DEFINE_int32(preparer_batch_coalescing_window_us, 0,
+             "When operations of the previous batch were submitted concurrently, wait up to this "
+             "number of microseconds for more leader-side operations to join the current batch, "
+             "so they are replicated by a single consensus round. 0 to disable.");
+TAG_FLAG(preparer_batch_coalescing_window_us, advanced);
+
 DEFINE_test_flag(int32, preparer_batch_inject_latency_ms, 0,
                  "Inject latency before replicating batch.");
 
 DECLARE_int32(protobuf_message_total_bytes_limit);
 
+METRIC_DEFINE_counter(tablet, preparer_replicated_batches, "Preparer Replicated Batches",
+                      yb::MetricUnit::kRequests,
+                      "Number of batches of leader-side operations submitted to consensus for "
+                      "replication by the preparer.");
+
+METRIC_DEFINE_counter(tablet, preparer_coalesced_operations, "Preparer Coalesced Operations",
+                      yb::MetricUnit::kOperations,
+                      "Number of leader-side operations that joined a batch while the preparer "
+                      "was waiting within preparer_batch_coalescing_window_us.");
+
 using namespace std::literals;
 using std::vector;
 
@@ -58,7 +77,8 @@ namespace tablet {
 
 class PreparerImpl {
  public:
-  explicit PreparerImpl(consensus::Consensus* consensus, ThreadPool* tablet_prepare_pool);
+  PreparerImpl(consensus::Consensus* consensus, ThreadPool* tablet_prepare_pool,
+               const MetricEntityPtr& metric_entity);
   ~PreparerImpl();
   Status Start();
   void Stop();
@@ -106,20 +126,41 @@ class PreparerImpl {
   std::mutex stop_mtx_;
   std::condition_variable stop_cond_;
 
+  // Used by the prepare task to sleep while coalescing a leader-side batch. Submit wakes it up
+  // when a new operation is pushed to the queue while coalescing_ is set.
+  std::atomic<bool> coalescing_{false};
+  std::mutex coalesce_mtx_;
+  std::condition_variable coalesce_cond_;
+
   OperationDrivers leader_side_batch_;
   size_t leader_side_batch_size_estimate_ = 0;
   const size_t leader_side_batch_size_limit_;
 
+  // Number of operations in the last processed leader-side batch. More than one operation means
+  // that there are concurrent writers, so it is worth waiting for the next batch to fill up.
+  size_t last_leader_side_batch_size_ = 0;
+
   std::unique_ptr<ThreadPoolToken> tablet_prepare_pool_token_;
 
   // A temporary buffer of rounds to replicate, used to reduce reallocation.
   consensus::ConsensusRounds rounds_to_replicate_;
 
+  // Null when the preparer was created without a metric entity.
+  scoped_refptr<Counter> replicated_batches_;
+  scoped_refptr<Counter> coalesced_operations_;
+
   void Run();
   void ProcessItem(OperationDriver* item);
 
   void ProcessAndClearLeaderSideBatch();
 
+  // Keeps processing items that arrive within the coalescing window, while the current batch
+  // has room for them.
+  void CoalesceLeaderSideBatch();
+
+  // Wakes up the prepare task if it is waiting in CoalesceLeaderSideBatch.
+  void NotifyCoalescing();
+
   // A wrapper around ProcessAndClearLeaderSideBatch that assumes we are currently holding the
   // mutex.
 
@@ -127,12 +168,17 @@ class PreparerImpl {
                          OperationDrivers::iterator end);
 };
 
-PreparerImpl::PreparerImpl(consensus::Consensus* consensus, ThreadPool* tablet_prepare_pool)
+PreparerImpl::PreparerImpl(consensus::Consensus* consensus, ThreadPool* tablet_prepare_pool,
+                           const MetricEntityPtr& metric_entity)
     : consensus_(consensus),
       // Reserve 5% for other LogEntryBatchPB fields in case of big batches.
       leader_side_batch_size_limit_(FLAGS_protobuf_message_total_bytes_limit * 0.95),
       tablet_prepare_pool_token_(tablet_prepare_pool
                                      ->NewToken(ThreadPool::ExecutionMode::SERIAL)) {
+  if (metric_entity) {
+    replicated_batches_ = METRIC_preparer_replicated_batches.Instantiate(metric_entity);
+    coalesced_operations_ = METRIC_preparer_coalesced_operations.Instantiate(metric_entity);
+  }
 }
 
 PreparerImpl::~PreparerImpl() {
@@ -148,6 +194,7 @@ void PreparerImpl::Stop() {
     return;
   }
   stop_requested_ = true;
+  NotifyCoalescing();
   {
     std::unique_lock<std::mutex> stop_lock(stop_mtx_);
     stop_cond_.wait(stop_lock, [this] {
@@ -175,6 +222,7 @@ Status PreparerImpl::Submit(OperationDriver* operation_driver) {
     // ReplicaState lock once and append multiple operations.
     active_tasks_.fetch_add(1, std::memory_order_release);
     queue_.Push(operation_driver);
+    NotifyCoalescing();
   } else {
     // For follower-side operations, there would be no benefit in preparing them on the preparer
     // thread.
@@ -199,6 +247,7 @@ void PreparerImpl::Run() {
       active_tasks_.fetch_sub(1, std::memory_order_release);
       ProcessItem(item);
     }
+    CoalesceLeaderSideBatch();
     ProcessAndClearLeaderSideBatch();
     std::unique_lock<std::mutex> stop_lock(stop_mtx_);
     running_.store(false, std::memory_order_release);
@@ -279,10 +328,52 @@ void PreparerImpl::ProcessItem(OperationDriver* item) {
   }
 }
 
+void PreparerImpl::CoalesceLeaderSideBatch() {
+  const auto window_us = GetAtomicFlag(&FLAGS_preparer_batch_coalescing_window_us);
+  if (window_us <= 0 || leader_side_batch_.empty() || last_leader_side_batch_size_ < 2) {
+    return;
+  }
+  const auto deadline = std::chrono::steady_clock::now() + window_us * 1us;
+  // Submit increments active_tasks_ before pushing and notifies after pushing when coalescing_ is
+  // set. Even if a wakeup is missed, the wait is bounded by the deadline and the operation is
+  // picked up by Run.
+  coalescing_.store(true);
+  while (!leader_side_batch_.empty() &&
+         leader_side_batch_.size() < FLAGS_max_group_replicate_batch_size &&
+         !stop_requested_.load(std::memory_order_acquire)) {
+    if (OperationDriver *item = queue_.Pop()) {
+      active_tasks_.fetch_sub(1, std::memory_order_release);
+      ProcessItem(item);
+      if (coalesced_operations_) {
+        coalesced_operations_->Increment();
+      }
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(coalesce_mtx_);
+    if (!coalesce_cond_.wait_until(lock, deadline, [this] {
+          return active_tasks_.load() != 0 || stop_requested_.load(std::memory_order_acquire);
+        })) {
+      break;
+    }
+  }
+  coalescing_.store(false, std::memory_order_release);
+}
+
+void PreparerImpl::NotifyCoalescing() {
+  if (!coalescing_.load()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(coalesce_mtx_);
+  }
+  coalesce_cond_.notify_one();
+}
+
 void PreparerImpl::ProcessAndClearLeaderSideBatch() {
   if (leader_side_batch_.empty()) {
     return;
   }
+  last_leader_side_batch_size_ = leader_side_batch_.size();
 
   VLOG(2) << "Preparing a batch of " << leader_side_batch_.size()
           << " leader-side operations, estimated size: " << leader_side_batch_size_estimate_
@@ -352,6 +443,9 @@ void PreparerImpl::ReplicateSubBatch(
   bool should_fail = prepare_should_fail_.load(std::memory_order_acquire);
   const Status s = consensus_->ReplicateBatch(rounds_to_replicate_);
   rounds_to_replicate_.clear();
+  if (replicated_batches_) {
+    replicated_batches_->Increment();
+  }
 
   if (s.ok() && should_fail) {
     LOG(DFATAL) << "Operations should fail, but was successfully prepared: "
@@ -362,8 +456,9 @@ void PreparerImpl::ReplicateSubBatch(
 // ------------------------------------------------------------------------------------------------
 // Preparer
 
-Preparer::Preparer(consensus::Consensus* consensus, ThreadPool* tablet_prepare_thread)
-    : impl_(std::make_unique<PreparerImpl>(consensus, tablet_prepare_thread)) {
+Preparer::Preparer(consensus::Consensus* consensus, ThreadPool* tablet_prepare_thread,
+                   const MetricEntityPtr& metric_entity)
+    : impl_(std::make_unique<PreparerImpl>(consensus, tablet_prepare_thread, metric_entity)) {
 }
 
 Preparer::~Preparer() = default;
@@ -16,6 +16,7 @@
 
 #include <gflags/gflags.h>
 
+#include "yb/util/metrics_fwd.h"
 #include "yb/util/status_fwd.h"
 #include "yb/util/threadpool.h"
 
@@ -40,7 +41,8 @@ class PreparerImpl;
 // Preparer does not manage a thread but only submits to a token in a thread pool.
 class Preparer {
  public:
-  explicit Preparer(consensus::Consensus* consensus, ThreadPool* tablet_prepare_pool);
+  Preparer(consensus::Consensus* consensus, ThreadPool* tablet_prepare_pool,
+           const MetricEntityPtr& metric_entity);
   ~Preparer();
 
   Status Start();
@@ -66,6 +66,7 @@
 #include "yb/docdb/docdb_compaction_filter_intents.h"
 #include "yb/docdb/docdb_debug.h"
 #include "yb/docdb/docdb_rocksdb_util.h"
+#include "yb/docdb/intent_index.h"
 #include "yb/docdb/pgsql_operation.h"
 #include "yb/docdb/ql_rocksdb_storage.h"
 #include "yb/docdb/redis_operation.h"
@@ -159,6 +160,17 @@ DEFINE_int32(num_raft_ops_to_force_idle_intents_db_to_flush, 1000,
 DEFINE_bool(delete_intents_sst_files, true,
             "Delete whole intents .SST files when possible.");
 
+DEFINE_bool(enable_intent_index, false,
+            "Keep in-memory index of intents of running transactions and use it for conflict "
+            "resolution instead of seeking intents RocksDB.");
+TAG_FLAG(enable_intent_index, advanced);
+
+DEFINE_uint64(intent_index_max_entries, 1000000,
+              "Max number of intents stored in the in-memory intent index of a tablet. "
+              "When exceeded, conflict resolution falls back to intents RocksDB until transactions "
+              "whose intents were not indexed are resolved.");
+TAG_FLAG(intent_index_max_entries, advanced);
+
 DEFINE_uint64(backfill_index_write_batch_size, 128, "The batch size for backfilling the index.");
 TAG_FLAG(backfill_index_write_batch_size, advanced);
 TAG_FLAG(backfill_index_write_batch_size, runtime);
@@ -771,6 +783,14 @@ Status Tablet::OpenKeyValueTablet() {
         rocksdb::DB::Open(intents_rocksdb_options, db_dir + kIntentsDBSuffix, &intents_db));
     intents_db_.reset(intents_db);
     intents_db_->ListenFilesChanged(std::bind(&Tablet::CleanupIntentFiles, this));
+
+    if (intent_index_) {
+      intent_index_->Reset();
+    } else if (FLAGS_enable_intent_index && !metadata_->is_under_twodc_replication()) {
+      intent_index_ = std::make_unique<docdb::IntentIndex>(
+          FLAGS_intent_index_max_entries,
+          MemTracker::FindOrCreateTracker("IntentIndex", mem_tracker_));
+    }
   }
 
   ql_storage_.reset(new docdb::QLRocksDBStorage(doc_db()));
@@ -1239,6 +1259,7 @@ Status Tablet::WriteTransactionalBatch(
   if (store_metadata) {
     writer.SetMetadataToStore(&put_batch.transaction());
   }
+  writer.SetIntentIndex(intent_index_.get());
   rocksdb::WriteBatch write_batch;
   write_batch.SetDirectWriter(&writer);
   RequestScope request_scope(transaction_participant_.get());
@@ -1279,6 +1300,9 @@ Status Tablet::ApplyKeyValueRowOperations(
         put_batch, hybrid_time, intents_db_.get(), regular_write_batch_ptr, &intents_write_batch);
 
     if (intents_write_batch.Count() != 0) {
+      if (intent_index_) {
+        intent_index_->Disable();
+      }
       if (!metadata_->is_under_twodc_replication()) {
         RETURN_NOT_OK(metadata_->SetIsUnderTwodcReplicationAndFlush(true));
       }
@@ -1308,6 +1332,11 @@ void Tablet::WriteToRocksDB(
     const rocksdb::UserFrontiers* frontiers,
     rocksdb::WriteBatch* write_batch,
     docdb::StorageDbType storage_db_type) {
+  if (witness()) {
+    // Witness does not store data, it only keeps the Raft log.
+    return;
+  }
+
   rocksdb::DB* dest_db = nullptr;
   switch (storage_db_type) {
     case StorageDbType::kRegular: dest_db = regular_db_.get(); break;
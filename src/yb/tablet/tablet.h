@@ -561,7 +561,9 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
 
   Status ForceFullRocksDBCompact(docdb::SkipFlush skip_flush = docdb::SkipFlush::kFalse);
 
-  docdb::DocDB doc_db() const { return { regular_db_.get(), intents_db_.get(), &key_bounds_ }; }
+  docdb::DocDB doc_db() const {
+    return { regular_db_.get(), intents_db_.get(), &key_bounds_, intent_index_.get() };
+  }
 
   // Returns approximate middle key for tablet split:
   // - for hash-based partitions: encoded hash code in order to split by hash code.
@@ -595,6 +597,10 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   // Returns the number of memtables in intents and regular db-s.
   std::pair<int, int> GetNumMemtables() const;
 
+  // A witness replica only keeps the Raft log, so operations are not written to RocksDB.
+  void SetWitness(bool value) { witness_.store(value, std::memory_order_release); }
+  bool witness() const { return witness_.load(std::memory_order_acquire); }
+
   void SetHybridTimeLeaseProvider(HybridTimeLeaseProvider provider) {
     ht_lease_provider_ = std::move(provider);
   }
@@ -887,7 +893,10 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   // RocksDB database instances for key-value tables.
   std::unique_ptr<rocksdb::DB> regular_db_;
   std::unique_ptr<rocksdb::DB> intents_db_;
+  // In-memory index of intents_db_, null when intent index is disabled.
+  std::unique_ptr<docdb::IntentIndex> intent_index_;
   std::atomic<bool> rocksdb_shutdown_requested_{false};
+  std::atomic<bool> witness_{false};
 
   // Optional key bounds (see docdb::KeyBounds) served by this tablet.
   docdb::KeyBounds key_bounds_;
@@ -52,6 +52,7 @@
 #include "yb/consensus/log_reader.h"
 #include "yb/consensus/log_util.h"
 #include "yb/consensus/opid_util.h"
+#include "yb/consensus/quorum_util.h"
 #include "yb/consensus/retryable_requests.h"
 
 #include "yb/docdb/consensus_frontier.h"
@@ -535,6 +536,9 @@ class TabletBootstrap {
 
     const bool has_blocks = VERIFY_RESULT(OpenTablet());
 
+    // Witness does not write to RocksDB, so it should be known before the log is replayed.
+    UpdateWitnessMode();
+
     if (FLAGS_TEST_dump_docdb_before_tablet_bootstrap) {
       LOG_WITH_PREFIX(INFO) << "DEBUG: DocDB dump before tablet bootstrap:";
       tablet_->TEST_DocDBDumpToLog(IncludeIntents::kTrue);
@@ -1474,6 +1478,11 @@ class TabletBootstrap {
     return Status::OK();
   }
 
+  void UpdateWitnessMode() {
+    tablet_->SetWitness(consensus::IsRaftConfigWitness(
+        meta_->fs_manager()->uuid(), cmeta_->committed_config()));
+  }
+
   Status PlayChangeConfigRequest(ReplicateMsg* replicate_msg) {
     ChangeConfigRecordPB* change_config = replicate_msg->mutable_change_config_record();
     RaftConfigPB config = change_config->new_config();
@@ -1490,6 +1499,7 @@ class TabletBootstrap {
                           << cmeta_opid_index
                           << ". Applying this configuration change.";
       cmeta_->set_committed_config(config);
+      UpdateWitnessMode();
       // We flush once at the end of bootstrap.
     } else {
       VLOG_WITH_PREFIX(1) << "WAL replay found Raft configuration with log index "
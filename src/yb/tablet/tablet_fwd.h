@@ -61,6 +61,7 @@ class TransactionStatePB;
 class TruncateOperation;
 class TruncatePB;
 class UpdateTxnOperation;
+class WaitQueue;
 class WriteOperation;
 class WriteQuery;
 class WriteQueryContext;
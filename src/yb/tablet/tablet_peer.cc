@@ -47,6 +47,7 @@
 #include "yb/consensus/log_anchor_registry.h"
 #include "yb/consensus/log_util.h"
 #include "yb/consensus/opid_util.h"
+#include "yb/consensus/quorum_util.h"
 #include "yb/consensus/raft_consensus.h"
 #include "yb/consensus/retryable_requests.h"
 #include "yb/consensus/state_change_context.h"
@@ -290,7 +291,8 @@ Status TabletPeer::InitTabletPeer(
     operation_tracker_.SetPostTracker(
         std::bind(&RaftConsensus::TrackOperationMemory, consensus_.get(), _1));
 
-    prepare_thread_ = std::make_unique<Preparer>(consensus_.get(), tablet_prepare_pool);
+    prepare_thread_ = std::make_unique<Preparer>(
+        consensus_.get(), tablet_prepare_pool, tablet_->GetTabletMetricsEntity());
 
     ChangeConfigReplicated(RaftConfig()); // Set initial flag value.
   }
@@ -381,6 +383,11 @@ void TabletPeer::MajorityReplicated() {
 
 void TabletPeer::ChangeConfigReplicated(const RaftConfigPB& config) {
   tablet_->mvcc_manager()->SetLeaderOnlyMode(config.peers_size() == 1);
+  auto witness = consensus::IsRaftConfigWitness(permanent_uuid(), config);
+  if (witness != tablet_->witness()) {
+    LOG_WITH_PREFIX(INFO) << (witness ? "Became" : "No longer") << " a witness replica";
+    tablet_->SetWitness(witness);
+  }
 }
 
 uint64_t TabletPeer::NumSSTFiles() {
@@ -939,6 +946,16 @@ Result<int64_t> TabletPeer::GetEarliestNeededLogIndex(std::string* details) cons
     *details += Format("Last committed op id: $0\n", last_committed_op_id);
   }
 
+  // Witness does not flush anything, but keeps operations until all data-bearing replicas applied
+  // them, so its log still has them if the leader is lost before that.
+  if (tablet_->witness()) {
+    auto data_replicas_applied_index = consensus_->DataReplicasAppliedIndex();
+    min_index = std::min(min_index, data_replicas_applied_index);
+    if (details) {
+      *details += Format("Data replicas applied index: $0\n", data_replicas_applied_index);
+    }
+  }
+
   if (tablet_->table_type() != TableType::TRANSACTION_STATUS_TABLE_TYPE) {
     tablet_->FlushIntentsDbIfNecessary(latest_log_entry_op_id);
     auto max_persistent_op_id = VERIFY_RESULT(
@@ -322,7 +322,7 @@ class TabletPeer : public consensus::ConsensusContext,
     return clock_;
   }
 
-  void Enqueue(rpc::ThreadPoolTask* task);
+  void Enqueue(rpc::ThreadPoolTask* task) override;
   void StrandEnqueue(rpc::StrandTask* task) override;
 
   const std::shared_future<client::YBClient*>& client_future() const override {
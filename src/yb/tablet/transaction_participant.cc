@@ -29,6 +29,7 @@
 #include "yb/consensus/consensus_util.h"
 
 #include "yb/docdb/docdb_rocksdb_util.h"
+#include "yb/docdb/intent_index.h"
 #include "yb/docdb/transaction_dump.h"
 
 #include "yb/rpc/poller.h"
@@ -44,6 +45,7 @@
 #include "yb/tablet/transaction_loader.h"
 #include "yb/tablet/transaction_participant_context.h"
 #include "yb/tablet/transaction_status_resolver.h"
+#include "yb/tablet/wait_queue.h"
 
 #include "yb/tserver/tserver_service.pb.h"
 
@@ -127,6 +129,8 @@ class TransactionParticipant::Impl
       : RunningTransactionContext(context, applier),
         log_prefix_(context->LogPrefix()),
         loader_(this, entity),
+        wait_queue_(
+            [context](rpc::ThreadPoolTask* task) { context->Enqueue(task); }, log_prefix_),
         poller_(log_prefix_, std::bind(&Impl::Poll, this)) {
     LOG_WITH_PREFIX(INFO) << "Create";
     metric_transactions_running_ = METRIC_transactions_running.Instantiate(entity, 0);
@@ -149,6 +153,7 @@ class TransactionParticipant::Impl
     }
 
     poller_.Shutdown();
+    wait_queue_.StartShutdown();
 
     if (start_latch_.count()) {
       start_latch_.CountDown();
@@ -677,6 +682,11 @@ class TransactionParticipant::Impl
     // We should only load transactions on the initial call to SetDB (when opening the tablet), not
     // in case of truncate/restore.
     if (!had_db) {
+      if (db_.intent_index) {
+        // Intents of transactions that are not loaded yet are not indexed, so keep the index
+        // unusable until loading is finished.
+        db_.intent_index->AddUnindexedTransaction(TransactionId::Nil());
+      }
       loader_.Start(pending_op_counter, db_);
       return;
     }
@@ -709,6 +719,10 @@ class TransactionParticipant::Impl
     }
   }
 
+  WaitQueue& wait_queue() {
+    return wait_queue_;
+  }
+
   TransactionParticipantContext* participant_context() const {
     return &participant_context_;
   }
@@ -1012,6 +1026,9 @@ class TransactionParticipant::Impl
   }
 
   void LoadFinished(const ApplyStatesMap& pending_applies) override {
+    if (db_.intent_index) {
+      db_.intent_index->RemoveTransaction(TransactionId::Nil());
+    }
     start_latch_.Wait();
     std::vector<ScopedRWOperation> operations;
     operations.reserve(pending_applies.size());
@@ -1173,6 +1190,12 @@ class TransactionParticipant::Impl
       const Transactions::iterator& it, RemoveReason reason,
       MinRunningNotifier* min_running_notifier) REQUIRES(mutex_) {
     TransactionId txn_id = (**it).id();
+    // Intents of the transaction are already applied or removed at this point, so transactions
+    // waiting on it could proceed, even if removal itself is postponed.
+    wait_queue_.SignalResolved(txn_id);
+    if (db_.intent_index) {
+      db_.intent_index->RemoveTransaction(txn_id);
+    }
     OpId checkpoint_op_id = GetLatestCheckPoint();
     auto itr = transactions_.find(txn_id);
     OpId op_id = (**itr).GetOpId();
@@ -1279,6 +1302,9 @@ class TransactionParticipant::Impl
       txn->SetLocalCommitData(pending_apply->commit_ht, pending_apply->state.aborted);
       txn->SetApplyData(pending_apply->state);
     }
+    if (db_.intent_index) {
+      db_.intent_index->AddUnindexedTransaction(txn->id());
+    }
     transactions_.insert(txn);
     TransactionsModifiedUnlocked(&min_running_notifier);
   }
@@ -1460,6 +1486,7 @@ class TransactionParticipant::Impl
       CleanTransactionsQueue(&graceful_cleanup_queue_, &min_running_notifier);
     }
     CleanupStatusResolvers();
+    wait_queue_.Poll(CoarseMonoClock::now());
   }
 
   void CheckForAbortedTransactions() REQUIRES(mutex_) {
@@ -1611,6 +1638,8 @@ class TransactionParticipant::Impl
 
   LRUCache<TransactionId> cleanup_cache_{FLAGS_transactions_cleanup_cache_size};
 
+  WaitQueue wait_queue_;
+
   rpc::Poller poller_;
 
   OpId cdc_sdk_min_checkpoint_op_id_ = OpId::Invalid();
@@ -1722,6 +1751,10 @@ TransactionParticipantContext* TransactionParticipant::context() const {
   return impl_->participant_context();
 }
 
+WaitQueue& TransactionParticipant::wait_queue() const {
+  return impl_->wait_queue();
+}
+
 HybridTime TransactionParticipant::MinRunningHybridTime() const {
   return impl_->MinRunningHybridTime();
 }
@@ -177,6 +177,9 @@ class TransactionParticipant : public TransactionStatusManager {
 
   TransactionParticipantContext* context() const;
 
+  // Queue of transactions waiting for conflicting transactions of this tablet to finish.
+  WaitQueue& wait_queue() const;
+
   HybridTime MinRunningHybridTime() const override;
 
   Result<HybridTime> WaitForSafeTime(HybridTime safe_time, CoarseTimePoint deadline) override;
@@ -40,6 +40,9 @@ class TransactionParticipantContext {
 
   // Enqueue task to participant context strand.
   virtual void StrandEnqueue(rpc::StrandTask* task) = 0;
+
+  // Enqueue task to the service thread pool.
+  virtual void Enqueue(rpc::ThreadPoolTask* task) = 0;
   virtual void UpdateClock(HybridTime hybrid_time) = 0;
   virtual bool IsLeader() = 0;
   virtual void SubmitUpdateTransaction(
@@ -0,0 +1,131 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <future>
+
+#include <boost/optional.hpp>
+
+#include "yb/common/transaction_error.h"
+
+#include "yb/rpc/thread_pool.h"
+
+#include "yb/tablet/wait_queue.h"
+
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+using namespace std::literals;
+
+namespace yb {
+namespace tablet {
+
+class WaitQueueTest : public YBTest {
+ public:
+  void SetUp() override {
+    YBTest::SetUp();
+    pool_.emplace("test", 100U /* queue_limit */, 2U /* max_workers */);
+    wait_queue_.emplace(
+        [this](rpc::ThreadPoolTask* task) { pool_->Enqueue(task); }, "T test: ");
+  }
+
+  void TearDown() override {
+    wait_queue_->StartShutdown();
+    pool_->Shutdown();
+    YBTest::TearDown();
+  }
+
+ protected:
+  boost::optional<rpc::ThreadPool> pool_;
+  boost::optional<WaitQueue> wait_queue_;
+};
+
+auto SetPromiseValueFunctor(std::promise<Status>* promise) {
+  return [promise](const Status& status) { promise->set_value(status); };
+}
+
+TEST_F(WaitQueueTest, WakeUpWhenBlockersResolved) {
+  auto waiter = TransactionId::GenerateRandom();
+  auto blocker1 = TransactionId::GenerateRandom();
+  auto blocker2 = TransactionId::GenerateRandom();
+
+  std::promise<Status> promise;
+  auto future = promise.get_future();
+  ASSERT_OK(wait_queue_->WaitOn(
+      waiter, {blocker1, blocker2}, CoarseMonoClock::now() + 1min,
+      SetPromiseValueFunctor(&promise)));
+  ASSERT_EQ(wait_queue_->TEST_NumWaiters(), 1);
+
+  wait_queue_->SignalResolved(blocker1);
+  ASSERT_EQ(future.wait_for(100ms), std::future_status::timeout);
+
+  wait_queue_->SignalResolved(blocker2);
+  ASSERT_OK(future.get());
+  ASSERT_EQ(wait_queue_->TEST_NumWaiters(), 0);
+  ASSERT_EQ(WaitsForGraph::Instance().TEST_NumWaiters(), 0);
+}
+
+TEST_F(WaitQueueTest, RecentlyResolvedBlocker) {
+  auto blocker = TransactionId::GenerateRandom();
+  wait_queue_->SignalResolved(blocker);
+
+  std::promise<Status> promise;
+  auto future = promise.get_future();
+  ASSERT_OK(wait_queue_->WaitOn(
+      TransactionId::GenerateRandom(), {blocker}, CoarseMonoClock::now() + 1min,
+      SetPromiseValueFunctor(&promise)));
+  ASSERT_OK(future.get());
+}
+
+TEST_F(WaitQueueTest, Deadline) {
+  auto deadline = CoarseMonoClock::now() + 50ms;
+  std::promise<Status> promise;
+  auto future = promise.get_future();
+  ASSERT_OK(wait_queue_->WaitOn(
+      TransactionId::GenerateRandom(), {TransactionId::GenerateRandom()}, deadline,
+      SetPromiseValueFunctor(&promise)));
+
+  wait_queue_->Poll(deadline);
+  auto status = future.get();
+  ASSERT_TRUE(status.IsTryAgain()) << status;
+  ASSERT_EQ(TransactionError(status), TransactionErrorCode::kConflict);
+}
+
+TEST_F(WaitQueueTest, Deadlock) {
+  auto txn1 = TransactionId::GenerateRandom();
+  auto txn2 = TransactionId::GenerateRandom();
+  auto txn3 = TransactionId::GenerateRandom();
+
+  std::promise<Status> promise1, promise2;
+  ASSERT_OK(wait_queue_->WaitOn(
+      txn1, {txn2}, CoarseMonoClock::now() + 1min, SetPromiseValueFunctor(&promise1)));
+  ASSERT_OK(wait_queue_->WaitOn(
+      txn2, {txn3}, CoarseMonoClock::now() + 1min, SetPromiseValueFunctor(&promise2)));
+
+  // txn3 -> txn1 -> txn2 -> txn3 would be a cycle.
+  auto status = wait_queue_->WaitOn(
+      txn3, {txn1}, CoarseMonoClock::now() + 1min, [](const Status&) {
+        FAIL() << "Callback should not be invoked";
+      });
+  ASSERT_TRUE(status.IsTryAgain()) << status;
+  ASSERT_EQ(TransactionError(status), TransactionErrorCode::kConflict);
+  ASSERT_EQ(wait_queue_->TEST_NumWaiters(), 2);
+
+  wait_queue_->SignalResolved(txn3);
+  ASSERT_OK(promise2.get_future().get());
+  wait_queue_->SignalResolved(txn2);
+  ASSERT_OK(promise1.get_future().get());
+  ASSERT_EQ(WaitsForGraph::Instance().TEST_NumWaiters(), 0);
+}
+
+} // namespace tablet
+} // namespace yb
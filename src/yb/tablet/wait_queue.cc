@@ -0,0 +1,315 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tablet/wait_queue.h"
+
+#include <algorithm>
+
+#include "yb/common/transaction_error.h"
+
+#include "yb/rpc/thread_pool.h"
+
+#include "yb/util/atomic.h"
+#include "yb/util/flag_tags.h"
+#include "yb/util/logging.h"
+#include "yb/util/status_format.h"
+
+using namespace std::literals;
+
+DEFINE_uint64(wait_queue_recheck_interval_ms, 1000,
+              "Transaction parked in the wait queue is woken up to recheck conflicts after "
+              "this interval, even if none of its blockers was resolved on this tablet.");
+TAG_FLAG(wait_queue_recheck_interval_ms, advanced);
+TAG_FLAG(wait_queue_recheck_interval_ms, runtime);
+
+namespace yb {
+namespace tablet {
+
+namespace {
+
+constexpr size_t kMaxRecentlyResolved = 1024;
+
+} // namespace
+
+Status WaitsForGraph::AddEdges(const TransactionId& waiter, const TransactionIdSet& blockers) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const auto& blocker : blockers) {
+    if (ReachableUnlocked(blocker, waiter)) {
+      return STATUS_EC_FORMAT(
+          TryAgain, TransactionError(TransactionErrorCode::kConflict),
+          "Deadlock detected: $0 waits for $1, that waits for $0", waiter, blocker);
+    }
+  }
+  auto& waiter_edges = edges_[waiter];
+  for (const auto& blocker : blockers) {
+    ++waiter_edges[blocker];
+  }
+  return Status::OK();
+}
+
+void WaitsForGraph::RemoveEdges(const TransactionId& waiter, const TransactionIdSet& blockers) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = edges_.find(waiter);
+  if (it == edges_.end()) {
+    return;
+  }
+  for (const auto& blocker : blockers) {
+    auto edge_it = it->second.find(blocker);
+    if (edge_it != it->second.end() && --edge_it->second == 0) {
+      it->second.erase(edge_it);
+    }
+  }
+  if (it->second.empty()) {
+    edges_.erase(it);
+  }
+}
+
+bool WaitsForGraph::ReachableUnlocked(const TransactionId& from, const TransactionId& to) const {
+  if (from == to) {
+    return true;
+  }
+  std::vector<TransactionId> stack = {from};
+  TransactionIdSet visited = {from};
+  while (!stack.empty()) {
+    auto current = stack.back();
+    stack.pop_back();
+    auto it = edges_.find(current);
+    if (it == edges_.end()) {
+      continue;
+    }
+    for (const auto& edge : it->second) {
+      if (edge.first == to) {
+        return true;
+      }
+      if (visited.insert(edge.first).second) {
+        stack.push_back(edge.first);
+      }
+    }
+  }
+  return false;
+}
+
+size_t WaitsForGraph::TEST_NumWaiters() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return edges_.size();
+}
+
+WaitsForGraph& WaitsForGraph::Instance() {
+  static WaitsForGraph* instance = new WaitsForGraph();
+  return *instance;
+}
+
+struct WaitQueue::Waiter {
+  TransactionId id;
+  // Blockers that are not yet resolved.
+  TransactionIdSet blockers;
+  // Blockers registered in waits-for graph.
+  TransactionIdSet graph_blockers;
+  CoarseTimePoint deadline;
+  CoarseTimePoint recheck_time;
+  WaitDoneCallback callback;
+};
+
+// Invokes waiter callback in thread pool. If the task could not be run, because the pool is
+// shutting down, the callback is invoked with the error.
+class WaitQueue::CallbackTask : public rpc::ThreadPoolTask {
+ public:
+  CallbackTask(WaiterPtr waiter, const Status& status)
+      : waiter_(std::move(waiter)), status_(status) {}
+
+  void Run() override {
+    waiter_->callback(status_);
+  }
+
+  void Done(const Status& status) override {
+    if (!status.ok()) {
+      waiter_->callback(status);
+    }
+    delete this;
+  }
+
+  virtual ~CallbackTask() = default;
+
+ private:
+  WaiterPtr waiter_;
+  Status status_;
+};
+
+WaitQueue::WaitQueue(EnqueueFunctor enqueue, std::string log_prefix)
+    : enqueue_(std::move(enqueue)), log_prefix_(std::move(log_prefix)) {
+}
+
+WaitQueue::~WaitQueue() {
+  StartShutdown();
+}
+
+Status WaitQueue::WaitOn(
+    const TransactionId& waiter_id, const TransactionIdSet& blockers, CoarseTimePoint deadline,
+    WaitDoneCallback callback) {
+  auto waiter = std::make_shared<Waiter>();
+  waiter->id = waiter_id;
+  waiter->deadline = deadline;
+  waiter->recheck_time = std::min(
+      deadline,
+      CoarseMonoClock::now() + 1ms * GetAtomicFlag(&FLAGS_wait_queue_recheck_interval_ms));
+  waiter->callback = std::move(callback);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& blocker : blockers) {
+      if (!recently_resolved_.count(blocker)) {
+        waiter->blockers.insert(blocker);
+      }
+    }
+  }
+
+  if (!waiter->blockers.empty()) {
+    RETURN_NOT_OK(WaitsForGraph::Instance().AddEdges(waiter_id, waiter->blockers));
+    waiter->graph_blockers = waiter->blockers;
+  }
+
+  Status finish_status;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (closing_) {
+      finish_status = STATUS(Aborted, "Wait queue is shutting down");
+    } else {
+      // Blockers could be resolved while we were checking for deadlock.
+      for (auto it = waiter->blockers.begin(); it != waiter->blockers.end();) {
+        if (recently_resolved_.count(*it)) {
+          it = waiter->blockers.erase(it);
+        } else {
+          blocked_by_[*it].push_back(waiter);
+          ++it;
+        }
+      }
+      if (!waiter->blockers.empty()) {
+        VLOG_WITH_PREFIX(4) << waiter_id << " waits for " << AsString(waiter->blockers);
+        waiters_.push_back(waiter);
+        return Status::OK();
+      }
+    }
+  }
+
+  Finish(waiter, finish_status);
+  return Status::OK();
+}
+
+void WaitQueue::SignalResolved(const TransactionId& id) {
+  std::vector<WaiterPtr> ready;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    RecordResolvedUnlocked(id);
+    auto it = blocked_by_.find(id);
+    if (it == blocked_by_.end()) {
+      return;
+    }
+    auto waiters = std::move(it->second);
+    blocked_by_.erase(it);
+    for (auto& waiter : waiters) {
+      waiter->blockers.erase(id);
+      if (waiter->blockers.empty()) {
+        RemoveWaiterUnlocked(waiter);
+        ready.push_back(std::move(waiter));
+      }
+    }
+  }
+  for (const auto& waiter : ready) {
+    VLOG_WITH_PREFIX(4) << waiter->id << " unblocked by " << id;
+    Finish(waiter, Status::OK());
+  }
+}
+
+void WaitQueue::Poll(CoarseTimePoint now) {
+  std::vector<WaiterPtr> expired;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& waiter : waiters_) {
+      if (waiter->recheck_time <= now) {
+        expired.push_back(waiter);
+      }
+    }
+    for (const auto& waiter : expired) {
+      RemoveWaiterUnlocked(waiter);
+    }
+  }
+  for (const auto& waiter : expired) {
+    if (waiter->deadline <= now) {
+      Finish(waiter, STATUS_EC_FORMAT(
+          TryAgain, TransactionError(TransactionErrorCode::kConflict),
+          "$0 timed out waiting for conflicting transactions: $1",
+          waiter->id, AsString(waiter->blockers)));
+    } else {
+      // Let the waiter recheck its blockers, it would be parked again if they are still running.
+      Finish(waiter, Status::OK());
+    }
+  }
+}
+
+void WaitQueue::StartShutdown() {
+  std::vector<WaiterPtr> waiters;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (closing_) {
+      return;
+    }
+    closing_ = true;
+    waiters.swap(waiters_);
+    blocked_by_.clear();
+  }
+  for (const auto& waiter : waiters) {
+    Finish(waiter, STATUS(Aborted, "Wait queue is shutting down"));
+  }
+}
+
+size_t WaitQueue::TEST_NumWaiters() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return waiters_.size();
+}
+
+void WaitQueue::Finish(const WaiterPtr& waiter, const Status& status) {
+  if (!waiter->graph_blockers.empty()) {
+    WaitsForGraph::Instance().RemoveEdges(waiter->id, waiter->graph_blockers);
+  }
+  // Callback would retry conflict resolution, so we don't invoke it while the caller could hold
+  // participant locks, nor on reactor threads.
+  enqueue_(new CallbackTask(waiter, status));
+}
+
+void WaitQueue::RemoveWaiterUnlocked(const WaiterPtr& waiter) {
+  for (const auto& blocker : waiter->blockers) {
+    auto it = blocked_by_.find(blocker);
+    if (it == blocked_by_.end()) {
+      continue;
+    }
+    auto& list = it->second;
+    list.erase(std::remove(list.begin(), list.end(), waiter), list.end());
+    if (list.empty()) {
+      blocked_by_.erase(it);
+    }
+  }
+  waiters_.erase(std::remove(waiters_.begin(), waiters_.end(), waiter), waiters_.end());
+}
+
+void WaitQueue::RecordResolvedUnlocked(const TransactionId& id) {
+  if (!recently_resolved_.insert(id).second) {
+    return;
+  }
+  recently_resolved_queue_.push_back(id);
+  if (recently_resolved_queue_.size() > kMaxRecentlyResolved) {
+    recently_resolved_.erase(recently_resolved_queue_.front());
+    recently_resolved_queue_.pop_front();
+  }
+}
+
+} // namespace tablet
+} // namespace yb
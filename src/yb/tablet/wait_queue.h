@@ -0,0 +1,119 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_TABLET_WAIT_QUEUE_H
+#define YB_TABLET_WAIT_QUEUE_H
+
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+
+#include "yb/common/transaction.h"
+
+#include "yb/rpc/rpc_fwd.h"
+
+#include "yb/util/monotime.h"
+#include "yb/util/status_fwd.h"
+
+namespace yb {
+namespace tablet {
+
+// Graph of waits-for edges between transactions blocked in wait queues of all tablets hosted by
+// this process. Used to detect deadlocks before parking a waiter.
+class WaitsForGraph {
+ public:
+  // Adds edges from waiter to each of blockers.
+  // Returns error if any of the blockers already (transitively) waits for waiter, in this case
+  // the graph is left unchanged.
+  Status AddEdges(const TransactionId& waiter, const TransactionIdSet& blockers);
+
+  // Removes edges previously added by a successful AddEdges call.
+  void RemoveEdges(const TransactionId& waiter, const TransactionIdSet& blockers);
+
+  size_t TEST_NumWaiters();
+
+  static WaitsForGraph& Instance();
+
+ private:
+  bool ReachableUnlocked(const TransactionId& from, const TransactionId& to) const;
+
+  std::mutex mutex_;
+  // Waiter -> blocker -> number of tablets where waiter waits for this blocker.
+  std::unordered_map<
+      TransactionId, std::unordered_map<TransactionId, size_t, TransactionIdHash>,
+      TransactionIdHash> edges_;
+};
+
+// Queue of transactions that are blocked by conflicting intents of other transactions in a
+// single tablet. Instead of failing such a write immediately, the waiter is parked until all of
+// its blockers are committed or aborted on this tablet, after which the waiter retries conflict
+// resolution.
+class WaitQueue {
+ public:
+  using WaitDoneCallback = std::function<void(const Status&)>;
+  // Submits task to the thread pool, where waiter callbacks are invoked.
+  using EnqueueFunctor = std::function<void(rpc::ThreadPoolTask*)>;
+
+  WaitQueue(EnqueueFunctor enqueue, std::string log_prefix);
+  ~WaitQueue();
+
+  // Parks waiter until all blockers are resolved or deadline is reached.
+  // Returns error without invoking callback if waiting would introduce a deadlock.
+  // Otherwise callback is invoked exactly once, never from within this call.
+  Status WaitOn(
+      const TransactionId& waiter, const TransactionIdSet& blockers, CoarseTimePoint deadline,
+      WaitDoneCallback callback);
+
+  // Notifies waiters that the specified transaction was committed or aborted on this tablet.
+  void SignalResolved(const TransactionId& id);
+
+  // Wakes up waiters whose deadline has passed or that were parked for too long, so they could
+  // recheck status of blockers that this tablet did not learn about.
+  void Poll(CoarseTimePoint now);
+
+  void StartShutdown();
+
+  size_t TEST_NumWaiters();
+
+ private:
+  struct Waiter;
+  using WaiterPtr = std::shared_ptr<Waiter>;
+  class CallbackTask;
+
+  void Finish(const WaiterPtr& waiter, const Status& status);
+  void RemoveWaiterUnlocked(const WaiterPtr& waiter);
+  void RecordResolvedUnlocked(const TransactionId& id);
+
+  const std::string& LogPrefix() const {
+    return log_prefix_;
+  }
+
+  const EnqueueFunctor enqueue_;
+  const std::string log_prefix_;
+
+  std::mutex mutex_;
+  bool closing_ = false;
+  std::unordered_map<TransactionId, std::vector<WaiterPtr>, TransactionIdHash> blocked_by_;
+  std::vector<WaiterPtr> waiters_;
+
+  // Transactions that were resolved recently, used to avoid parking a waiter on blocker that
+  // was resolved between conflict detection and WaitOn call.
+  TransactionIdSet recently_resolved_;
+  std::deque<TransactionId> recently_resolved_queue_;
+};
+
+} // namespace tablet
+} // namespace yb
+
+#endif // YB_TABLET_WAIT_QUEUE_H
@@ -38,10 +38,13 @@
 #include "yb/tablet/tablet.h"
 #include "yb/tablet/tablet_metrics.h"
 #include "yb/tablet/transaction_participant.h"
+#include "yb/tablet/wait_queue.h"
 #include "yb/tablet/write_query_context.h"
 
 #include "yb/tserver/tserver.pb.h"
 
+#include "yb/util/atomic.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/logging.h"
 #include "yb/util/metrics.h"
 #include "yb/util/sync_point.h"
@@ -49,6 +52,12 @@
 
 using namespace std::placeholders;
 
+DEFINE_bool(enable_wait_queues, false,
+            "When a transactional write conflicts with running transactions of higher priority, "
+            "wait for them to commit or abort instead of failing with a conflict.");
+TAG_FLAG(enable_wait_queues, advanced);
+TAG_FLAG(enable_wait_queues, runtime);
+
 namespace yb {
 namespace tablet {
 
@@ -480,13 +489,27 @@ Status WriteQuery::DoExecute() {
     }
   }
 
+  StartTransactionalConflictResolution();
+  return Status::OK();
+}
+
+void WriteQuery::StartTransactionalConflictResolution() {
+  docdb::PartialRangeKeyIntents partial_range_key_intents(
+      tablet().metadata()->UsePartialRangeKeyIntents());
+  blockers_.clear();
   docdb::ResolveTransactionConflicts(
-      doc_ops_, write_batch, tablet().clock()->Now(),
+      doc_ops_, request().write_batch(), tablet().clock()->Now(),
       read_time_ ? read_time_.read : HybridTime::kMax,
       tablet().doc_db(), partial_range_key_intents,
-      transaction_participant, tablet().metrics()->transaction_conflicts.get(),
+      tablet().transaction_participant(), tablet().metrics()->transaction_conflicts.get(),
+      GetAtomicFlag(&FLAGS_enable_wait_queues) ? &blockers_ : nullptr,
       [this](const Result<HybridTime>& result) {
         if (!result.ok()) {
+          if (!blockers_.empty()) {
+            WaitForConflictingTransactions();
+            TRACE("WaitForConflictingTransactions");
+            return;
+          }
           ExecuteDone(result.status());
           TRACE("ExecuteDone");
           return;
@@ -494,7 +517,49 @@ Status WriteQuery::DoExecute() {
         TransactionalConflictsResolved();
         TRACE("TransactionalConflictsResolved");
       });
+}
+
+void WriteQuery::WaitForConflictingTransactions() {
+  auto transaction_id = FullyDecodeTransactionId(
+      request().write_batch().transaction().transaction_id());
+  if (!transaction_id.ok()) {
+    ExecuteDone(transaction_id.status());
+    return;
+  }
+
+  // Release locks while waiting, so the transactions we wait for are able to proceed with
+  // their own writes to the same keys.
+  prepare_result_.lock_batch.Reset();
+  request_scope_ = RequestScope();
+
+  auto status = tablet().transaction_participant()->wait_queue().WaitOn(
+      *transaction_id, blockers_, deadline(), [this](const Status& status) {
+        auto retry_status = status.ok() ? RetryTransactionalConflictResolution() : status;
+        if (!retry_status.ok()) {
+          ExecuteDone(retry_status);
+        }
+      });
+  if (!status.ok()) {
+    ExecuteDone(status);
+  }
+}
 
+Status WriteQuery::RetryTransactionalConflictResolution() {
+  TRACE("Retry conflict resolution");
+  const auto& write_batch = request().write_batch();
+  docdb::PartialRangeKeyIntents partial_range_key_intents(
+      tablet().metadata()->UsePartialRangeKeyIntents());
+  auto prepare_result = VERIFY_RESULT(docdb::PrepareDocWriteOperation(
+      doc_ops_, write_batch.read_pairs(), tablet().metrics()->write_lock_latency,
+      isolation_level_, kind(), GetRowMarkTypeFromPB(write_batch),
+      /* transactional_table= */ true, write_batch.has_transaction(), deadline(),
+      partial_range_key_intents, tablet().shared_lock_manager()));
+  // Keep need_read_snapshot from the first attempt, read pairs of serializable transaction were
+  // extended after it.
+  prepare_result_.lock_batch = std::move(prepare_result.lock_batch);
+  request_scope_ = RequestScope(tablet().transaction_participant());
+
+  StartTransactionalConflictResolution();
   return Status::OK();
 }
 
@@ -864,6 +929,23 @@ void WriteQuery::PgsqlExecuteDone(const Status& status) {
     return;
   }
 
+  const auto& pgsql_write_batch = client_request_->pgsql_write_batch();
+  if (!pgsql_write_batch.empty() && pgsql_write_batch.begin()->atomic_within_batch()) {
+    const auto& responses = response_->pgsql_response_batch();
+    auto failed = std::any_of(responses.begin(), responses.end(), [](const auto& resp) {
+      return resp.status() != PgsqlResponsePB::PGSQL_STATUS_OK;
+    });
+    if (failed) {
+      // Nothing of the atomic batch is replicated, operations report their own statuses. So the
+      // batch of a sealed transaction is never replicated and the transaction is aborted.
+      VLOG_WITH_FUNC(2) << "Skip atomic batch with failed operation";
+      auto self = std::move(self_);
+      submit_token_.Reset();
+      Cancel(Status::OK());
+      return;
+    }
+  }
+
   for (auto& doc_op : doc_ops_) {
     // We'll need to return the number of rows inserted, updated, or deleted by each operation.
     std::unique_ptr<docdb::PgsqlWriteOperation> pgsql_write_op(
@@ -141,6 +141,13 @@ class WriteQuery {
 
   void NonTransactionalConflictsResolved(HybridTime now, HybridTime result);
 
+  void StartTransactionalConflictResolution();
+
+  // Parks this query in the tablet wait queue until transactions in blockers_ finish.
+  void WaitForConflictingTransactions();
+
+  Status RetryTransactionalConflictResolution();
+
   void TransactionalConflictsResolved();
 
   Status DoTransactionalConflictsResolved();
@@ -223,6 +230,8 @@ class WriteQuery {
   IsolationLevel isolation_level_;
   docdb::PrepareDocWriteOperationResult prepare_result_;
   RequestScope request_scope_;
+  // Running transactions that caused the last conflict resolution to fail.
+  TransactionIdSet blockers_;
   std::unique_ptr<WriteQuery> self_; // Keep self while Execute is performed.
 };
 
@@ -40,6 +40,7 @@
 #include "yb/tserver/pg_create_table.h"
 #include "yb/tserver/pg_table_cache.h"
 
+#include "yb/util/flag_tags.h"
 #include "yb/util/logging.h"
 #include "yb/util/result.h"
 #include "yb/util/scope_exit.h"
@@ -49,6 +50,11 @@
 
 #include "yb/yql/pggate/util/pg_doc_data.h"
 
+DEFINE_test_flag(bool, fail_pg_regular_commit, false,
+                 "Fail regular commit of plain YSQL transactions, i.e. ones that were not sealed "
+                 "in parallel with their last writes.");
+
+DECLARE_bool(enable_transaction_sealing);
 DECLARE_bool(ysql_serializable_isolation_for_ddl_txn);
 
 namespace yb {
@@ -255,6 +261,32 @@ Status GetTable(const TableId& table_id, PgTableCache* cache, client::YBTablePtr
   return Status::OK();
 }
 
+// Returns true if all operations of the request are writes to the same tablet of the same table,
+// according to the partitions currently known for the table.
+Result<bool> IsSingleTabletWrite(const PgPerformRequestPB& req, PgTableCache* table_cache) {
+  if (req.ops().empty()) {
+    return false;
+  }
+  client::YBTablePtr table;
+  client::VersionedTablePartitionListPtr partitions;
+  size_t partition_index = 0;
+  for (const auto& op : req.ops()) {
+    if (!op.has_write() || (table && table->id() != op.write().table_id())) {
+      return false;
+    }
+    const auto& partition_key = op.write().partition_key();
+    if (!table) {
+      RETURN_NOT_OK(GetTable(op.write().table_id(), table_cache, &table));
+      partitions = table->GetVersionedPartitions();
+      partition_index = client::FindPartitionStartIndex(partitions->keys, partition_key);
+    } else if (client::FindPartitionStartIndex(partitions->keys, partition_key) !=
+                   partition_index) {
+      return false;
+    }
+  }
+  return true;
+}
+
 Result<PgClientSessionOperations> PrepareOperations(
     const PgPerformRequestPB& req, client::YBSession* session, PgTableCache* table_cache) {
   auto write_time = HybridTime::FromPB(req.write_time());
@@ -565,8 +597,24 @@ Status PgClientSession::FinishTransaction(
   }
   const auto txn_value = std::move(txn);
   Session(kind)->SetTransaction(nullptr);
+  auto seal_future = kind == PgClientSessionKind::kPlain
+      ? std::move(seal_future_) : std::future<Status>();
 
   if (req.commit()) {
+    if (seal_future.valid()) {
+      const auto seal_status = seal_future.get();
+      VLOG_WITH_PREFIX_AND_FUNC(2)
+          << "txn: " << txn_value->id() << ", seal: " << seal_status
+          << ", sealed: " << txn_value->IsSealed();
+      // Transaction sealed in parallel with its last writes is committed if sealing succeeded, and
+      // could not be committed otherwise. If sealing was not started, commit it regularly.
+      if (txn_value->IsSealed()) {
+        return seal_status;
+      }
+    }
+    if (PREDICT_FALSE(FLAGS_TEST_fail_pg_regular_commit) && kind == PgClientSessionKind::kPlain) {
+      return STATUS(IllegalState, "Regular commit of plain transaction is disabled");
+    }
     const auto commit_status = txn_value->CommitFuture().get();
     VLOG_WITH_PREFIX_AND_FUNC(2)
         << "ddl: " << req.ddl_mode() << ", txn: " << txn_value->id()
@@ -585,6 +633,9 @@ Status PgClientSession::Perform(
   auto session_info = VERIFY_RESULT(SetupSession(req, context->GetClientDeadline()));
   auto* session = session_info.first;
   auto ops = VERIFY_RESULT(PrepareOperations(req, session, &table_cache_));
+  if (req.options().parallel_commit()) {
+    SealTransactionOnFlush(req, session);
+  }
   auto data = std::make_shared<PerformData>(PerformData {
     .session_id = id_,
     .req = &req,
@@ -600,6 +651,32 @@ Status PgClientSession::Perform(
   return Status::OK();
 }
 
+void PgClientSession::SealTransactionOnFlush(
+    const PgPerformRequestPB& req, client::YBSession* session) {
+  const auto& options = req.options();
+  if (options.use_catalog_session() || options.ddl_mode() || !FLAGS_enable_transaction_sealing ||
+      !Transaction(PgClientSessionKind::kPlain)) {
+    return;
+  }
+  for (const auto& op : req.ops()) {
+    if (!op.has_write()) {
+      return;
+    }
+  }
+  // Sealed transaction is committed as soon as all its batches are replicated, so a batch should
+  // not be written partially, i.e. without the rows that failed with duplicate key.
+  for (const auto& op : req.ops()) {
+    const_cast<PgsqlWriteRequestPB&>(op.write()).set_atomic_within_batch(true);
+  }
+  auto promise = std::make_shared<std::promise<Status>>();
+  seal_future_ = promise->get_future();
+  VLOG_WITH_PREFIX(2) << "Seal transaction " << Transaction(PgClientSessionKind::kPlain)->id()
+                      << " with " << req.ops().size() << " last writes";
+  session->SealTransactionOnFlush([promise](const Status& status) {
+    promise->set_value(status);
+  });
+}
+
 void PgClientSession::ProcessReadTimeManipulation(ReadTimeManipulation manipulation) {
   switch (manipulation) {
     case ReadTimeManipulation::RESET: {
@@ -639,7 +716,26 @@ PgClientSession::SetupSession(const PgPerformRequestPB& req, CoarseTimePoint dea
     RETURN_NOT_OK(GetDdlTransactionMetadata(true /* use_transaction */, deadline));
   } else {
     kind = PgClientSessionKind::kPlain;
-    RETURN_NOT_OK(BeginTransactionIfNecessary(options, deadline));
+    bool single_tablet_write = false;
+    if (options.single_tablet_fast_path() && !Transaction(kind) &&
+        txn_serial_no_ != options.txn_serial_no()) {
+      single_tablet_write = VERIFY_RESULT(IsSingleTabletWrite(req, &table_cache_));
+    }
+    if (single_tablet_write) {
+      // The whole transaction is a single batch of writes to one tablet, so it could be applied
+      // atomically without a distributed transaction. FinishTransaction will find no transaction.
+      VLOG_WITH_PREFIX(2) << "Apply " << req.ops().size() << " writes of single tablet "
+                          << "transaction " << options.txn_serial_no() << " without transaction";
+      for (const auto& op : req.ops()) {
+        const_cast<PgsqlWriteRequestPB&>(op.write()).set_atomic_within_batch(true);
+      }
+      EnsureSession(kind);
+    } else {
+      RETURN_NOT_OK(BeginTransactionIfNecessary(options, deadline));
+    }
+    // Partitions used by the check above could be outdated, so fail the flush instead of writing
+    // to several tablets without transaction if the table was split in the meantime.
+    Session(kind)->SetRequireSingleTablet(client::RequireSingleTablet(single_tablet_write));
   }
 
   auto session = Session(kind).get();
@@ -726,6 +822,7 @@ Status PgClientSession::BeginTransactionIfNecessary(
     txn->Abort();
     session->SetTransaction(nullptr);
     txn = nullptr;
+    seal_future_ = std::future<Status>();
   }
 
   if (isolation == IsolationLevel::NON_TRANSACTIONAL) {
@@ -18,6 +18,7 @@
 
 #include <array>
 #include <functional>
+#include <future>
 #include <memory>
 #include <string>
 #include <type_traits>
@@ -112,6 +113,8 @@ class PgClientSession : public std::enable_shared_from_this<PgClientSession> {
       const PgClientSessionOperations& operations, const PgPerformRequestPB& req,
       PgPerformResponsePB* resp, rpc::RpcContext* context);
   void ProcessReadTimeManipulation(ReadTimeManipulation manipulation);
+  // Seal the plain session transaction in parallel with its last writes.
+  void SealTransactionOnFlush(const PgPerformRequestPB& req, client::YBSession* session);
 
   client::YBClient& client();
   client::YBSessionPtr& EnsureSession(PgClientSessionKind kind);
@@ -135,6 +138,8 @@ class PgClientSession : public std::enable_shared_from_this<PgClientSession> {
   boost::optional<uint64_t> saved_priority_;
   TransactionMetadata ddl_txn_metadata_;
   UsedReadTime plain_session_used_read_time_;
+  // Result of sealing the plain session transaction by the flush of its last writes.
+  std::future<Status> seal_future_;
 };
 
 }  // namespace tserver
@@ -123,6 +123,10 @@ class ReadQuery : public std::enable_shared_from_this<ReadQuery>, public rpc::Th
   bool IsForBackfill() const;
   bool IsPgsqlFollowerReadAtAFollower() const;
 
+  // Rejects a CONSISTENT_PREFIX read served by a follower, whose safe time does not satisfy
+  // max_staleness_ms specified in the request.
+  Status CheckStaleness(server::Clock* clock);
+
   // Read implementation. If restart is required returns restart time, in case of success
   // returns invalid ReadHybridTime. Otherwise returns error status.
   Result<ReadHybridTime> DoRead();
@@ -402,6 +406,7 @@ Status ReadQuery::DoPerform() {
 Status ReadQuery::DoPickReadTime(server::Clock* clock) {
   if (!read_time_) {
     safe_ht_to_read_ = VERIFY_RESULT(abstract_tablet_->SafeTime(require_lease_));
+    RETURN_NOT_OK(CheckStaleness(clock));
     // If the read time is not specified, then it is a single-shard read.
     // So we should restart it in server in case of failure.
     read_time_.read = safe_ht_to_read_;
@@ -435,6 +440,26 @@ Status ReadQuery::DoPickReadTime(server::Clock* clock) {
   return Status::OK();
 }
 
+Status ReadQuery::CheckStaleness(server::Clock* clock) {
+  if (!reading_from_non_leader_ || !req_->max_staleness_ms() ||
+      req_->consistency_level() != YBConsistencyLevel::CONSISTENT_PREFIX) {
+    return Status::OK();
+  }
+  auto now = clock->Now();
+  if (safe_ht_to_read_ >= now.AddMilliseconds(-static_cast<int64_t>(req_->max_staleness_ms()))) {
+    return Status::OK();
+  }
+  // Let the client know how stale this replica is, so it is not selected for bounded staleness
+  // reads until it catches up. STALE_FOLLOWER makes the client retry the read on another replica
+  // without marking this one as failed.
+  resp_->set_safe_time(safe_ht_to_read_.ToUint64());
+  resp_->set_propagated_hybrid_time(now.ToUint64());
+  return STATUS_EC_FORMAT(
+      IllegalState, TabletServerError(TabletServerErrorPB::STALE_FOLLOWER),
+      "Safe time $0 at this follower is more than $1ms behind $2",
+      safe_ht_to_read_, req_->max_staleness_ms(), now);
+}
+
 bool ReadQuery::IsPgsqlFollowerReadAtAFollower() const {
   return reading_from_non_leader_ &&
          (!req_->pgsql_batch().empty() &&
@@ -494,6 +519,10 @@ Status ReadQuery::Complete() {
     used_read_time_.ToPB(resp_->mutable_used_read_time());
   }
 
+  if (req_->consistency_level() == YBConsistencyLevel::CONSISTENT_PREFIX) {
+    resp_->set_safe_time(safe_ht_to_read_.ToUint64());
+  }
+
   // Useful when debugging transactions
 #if defined(DUMP_READ)
   if (read_context->req->has_transaction() && read_context->req->pgsql_batch().size() == 1 &&
@@ -38,6 +38,7 @@
 #include "yb/consensus/consensus.h"
 #include "yb/consensus/log.h"
 #include "yb/consensus/opid_util.h"
+#include "yb/consensus/quorum_util.h"
 
 #include "yb/gutil/casts.h"
 #include "yb/gutil/strings/substitute.h"
@@ -133,6 +134,10 @@ Status RemoteBootstrapSession::ChangeRole() {
     }
 
     switch(peer_pb.member_type()) {
+      case PeerMemberType::WITNESS:
+        // Witness is added to the config with its final member type, there is nothing to change.
+        return Status::OK();
+
       case PeerMemberType::OBSERVER: FALLTHROUGH_INTENDED;
       case PeerMemberType::VOTER:
         LOG(ERROR) << "Peer " << peer_pb.permanent_uuid() << " is a "
@@ -259,16 +264,24 @@ Status RemoteBootstrapSession::Init() {
   // Clear any previous RocksDB files in the superblock. Each session should create a new list
   // based the checkpoint directory files.
   kv_store->clear_rocksdb_files();
-  auto status = tablet->snapshots().CreateCheckpoint(checkpoint_dir_);
-  if (status.ok()) {
-    *kv_store->mutable_rocksdb_files() = VERIFY_RESULT(ListFiles(checkpoint_dir_));
-  } else if (!status.IsNotSupported()) {
-    RETURN_NOT_OK(status);
-  }
+  if (consensus::IsRaftConfigWitness(requestor_uuid_, tablet_peer_->RaftConfig())) {
+    // Witness only needs the log, so neither RocksDB nor snapshot files are copied to it.
+    LOG(INFO) << "Peer " << requestor_uuid_ << " is a witness, only log segments will be copied "
+              << "in bootstrap session " << session_id_;
+    kv_store->clear_snapshot_files();
+    checkpoint_dir_.clear();
+  } else {
+    auto status = tablet->snapshots().CreateCheckpoint(checkpoint_dir_);
+    if (status.ok()) {
+      *kv_store->mutable_rocksdb_files() = VERIFY_RESULT(ListFiles(checkpoint_dir_));
+    } else if (!status.IsNotSupported()) {
+      RETURN_NOT_OK(status);
+    }
 
-  for (const auto& source : sources_) {
-    if (source) {
-      RETURN_NOT_OK(source->Init());
+    for (const auto& source : sources_) {
+      if (source) {
+        RETURN_NOT_OK(source->Init());
+      }
     }
   }
 
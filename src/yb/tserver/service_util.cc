@@ -127,6 +127,15 @@ Result<int64_t> LeaderTerm(const tablet::TabletPeer& tablet_peer) {
     return STATUS(Aborted, "Tablet peer was closed");
   }
   auto leader_state = consensus->GetLeaderState();
+  if (leader_state.status == consensus::LeaderStatus::LEADER_BUT_NO_MAJORITY_REPLICATED_LEASE &&
+      consensus->WakeIfQuiescent()) {
+    // Leader of an idle tablet let its lease lapse. Heartbeats are resumed in background, so don't
+    // block the handler thread waiting for the lease. The client retries the same server, instead
+    // of looking up the leader.
+    VLOG(1) << "Resuming heartbeats of quiescent tablet " << tablet_peer.tablet_id();
+    return leader_state.CreateStatus().CloneAndAddErrorCode(
+        TabletServerError(TabletServerErrorPB::LEADER_NOT_READY_TO_SERVE));
+  }
 
   VLOG(1) << Format(
       "Check for tablet $0 peer $1. Peer role is $2. Leader status is $3.",
@@ -284,6 +293,14 @@ Result<std::shared_ptr<tablet::AbstractTablet>> GetTablet(
 
   RETURN_NOT_OK(CheckPeerIsReady(*tablet_peer, allow_split_tablet));
 
+  if (PREDICT_FALSE(tablet_ptr->witness())) {
+    // A witness is never the leader. NOT_THE_LEADER makes the client retry on another replica
+    // without marking this one as failed.
+    return STATUS_EC_FORMAT(
+        IllegalState, TabletServerError(TabletServerErrorPB::NOT_THE_LEADER),
+        "Tablet $0 at this server is a witness, it does not serve reads", tablet_id);
+  }
+
   // Check for leader only in strong consistency level.
   if (consistency_level == YBConsistencyLevel::STRONG) {
     if (PREDICT_FALSE(FLAGS_TEST_assert_reads_from_follower_rejected_because_of_staleness)) {
@@ -50,6 +50,7 @@
 #include "yb/common/wire_protocol.h"
 #include "yb/consensus/leader_lease.h"
 #include "yb/consensus/consensus.pb.h"
+#include "yb/consensus/multi_raft_batcher.h"
 #include "yb/consensus/raft_consensus.h"
 
 #include "yb/docdb/cql_operation.h"
@@ -1784,6 +1785,20 @@ void ConsensusServiceImpl::MultiRaftUpdateConsensus(
       consensus::MultiRaftConsensusResponsePB *resp,
       rpc::RpcContext context) {
     DVLOG(3) << "Received Batch Consensus Update RPC: " << req->ShortDebugString();
+    if (req->has_liveness_epoch()) {
+      consensus::RaftLivenessTracker::Instance().Record(
+          req->liveness_dest_uuid(), req->liveness_caller_uuid(), req->liveness_epoch());
+    }
+    for (const auto& tablet_id : req->liveness_revoked_tablet_ids()) {
+      auto peer_tablet_res = LookupTabletPeer(tablet_manager_, tablet_id);
+      if (!peer_tablet_res.ok()) {
+        continue;
+      }
+      auto consensus_res = GetConsensus(peer_tablet_res->tablet_peer);
+      if (consensus_res.ok()) {
+        (**consensus_res).EndFollowerQuiescence(req->liveness_caller_uuid());
+      }
+    }
     // Effectively performs ConsensusServiceImpl::UpdateConsensus for
     // each ConsensusRequestPB in the batch but does not fail the entire
     // batch if a single request fails.
@@ -2023,7 +2038,10 @@ void ConsensusServiceImpl::RunLeaderElection(const RunLeaderElectionRequestPB* r
     .must_be_committed_opid = OpId::FromPB(req->committed_index()),
     .originator_uuid = req->has_originator_uuid() ? req->originator_uuid() : std::string(),
     .suppress_vote_request = consensus::TEST_SuppressVoteRequest(req->suppress_vote_request()),
-    .initial_election = req->initial_election() });
+    .initial_election = req->initial_election(),
+    .lease_transfer_ht = req->has_leader_lease_transfer_ht()
+        ? HybridTime(req->leader_lease_transfer_ht()) : HybridTime::kInvalid,
+    .originator_term = req->has_originator_term() ? req->originator_term() : OpId::kUnknownTerm });
   scope.CheckStatus(s, resp);
 }
 
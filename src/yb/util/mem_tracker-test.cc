@@ -33,6 +33,7 @@
 #include "yb/util/mem_tracker.h"
 
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -43,12 +44,14 @@
 
 #include "yb/util/result.h"
 #include "yb/util/size_literals.h"
+#include "yb/util/stopwatch.h"
 #include "yb/util/test_macros.h"
 #include "yb/util/test_util.h"
 
 DECLARE_int32(memory_limit_soft_percentage);
 DECLARE_int64(mem_tracker_update_consumption_interval_us);
 DECLARE_int64(mem_tracker_tcmalloc_gc_release_bytes);
+DECLARE_int64(mem_tracker_thread_local_batch_bytes);
 
 namespace yb {
 
@@ -389,4 +392,85 @@ TEST(MemTrackerTest, UnregisterFromParent) {
   shared_ptr<MemTracker> c2 = MemTracker::CreateTracker("child", p);
 }
 
+TEST(MemTrackerTest, ThreadLocalBatching) {
+  FLAGS_mem_tracker_thread_local_batch_bytes = 1000;
+  auto parent = MemTracker::CreateTracker("parent");
+  auto child = MemTracker::CreateTracker("child", parent);
+  FLAGS_mem_tracker_thread_local_batch_bytes = 0;
+
+  child->Consume(100);
+  ASSERT_EQ(child->consumption(), 0);
+  ASSERT_EQ(parent->consumption(), 0);
+
+  child->Consume(900);
+  ASSERT_EQ(child->consumption(), 1000);
+  ASSERT_EQ(parent->consumption(), 1000);
+
+  child->Release(500);
+  ASSERT_EQ(child->consumption(), 1000);
+  MemTracker::FlushThreadLocalConsumption();
+  ASSERT_EQ(child->consumption(), 500);
+  ASSERT_EQ(parent->consumption(), 500);
+
+  // Changes cached by a thread are applied when it exits.
+  std::thread([child] { child->Consume(10); }).join();
+  ASSERT_EQ(child->consumption(), 510);
+
+  // Changes cached for a destroyed tracker are dropped, and its remaining consumption is released
+  // from ancestors.
+  child->Consume(20);
+  ASSERT_EQ(parent->consumption(), 510);
+  child->Release(530);
+  child.reset();
+  ASSERT_EQ(parent->consumption(), 0);
+  // Entry of the destroyed tracker should not be applied on flush.
+  MemTracker::FlushThreadLocalConsumption();
+  ASSERT_EQ(parent->consumption(), 0);
+}
+
+// Compares exact accounting with thread local batched accounting, when many threads update
+// separate trackers sharing the same parent.
+TEST(MemTrackerTest, BenchmarkThreadLocalBatching) {
+  if (!AllowSlowTests()) {
+    LOG(INFO) << "Skipping benchmark in fast-test mode";
+    return;
+  }
+  const size_t kNumThreads = std::max(4U, std::thread::hardware_concurrency());
+  const size_t kNumOps = 10000000;
+  for (int64_t batch_bytes : {0_KB, 64_KB}) {
+    FLAGS_mem_tracker_thread_local_batch_bytes = batch_bytes;
+    auto parent = MemTracker::CreateTracker("parent");
+    vector<shared_ptr<MemTracker>> children;
+    for (size_t i = 0; i != kNumThreads; ++i) {
+      children.push_back(MemTracker::CreateTracker(Format("child-$0", i), parent));
+    }
+    FLAGS_mem_tracker_thread_local_batch_bytes = 0;
+
+    Stopwatch sw;
+    sw.start();
+    vector<std::thread> threads;
+    for (const auto& child : children) {
+      threads.emplace_back([child, kNumOps] {
+        for (size_t op = 0; op != kNumOps; ++op) {
+          if (op & 1) {
+            child->Release(128);
+          } else {
+            child->Consume(128);
+          }
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    sw.stop();
+
+    ASSERT_EQ(parent->consumption(), 0);
+    LOG(INFO) << "Batch bytes: " << batch_bytes << ", threads: " << kNumThreads
+              << ", ops per thread: " << kNumOps << ", time: " << sw.elapsed().wall_seconds()
+              << "s, ops per second: "
+              << kNumThreads * kNumOps / sw.elapsed().wall_seconds();
+  }
+}
+
 } // namespace yb
@@ -33,6 +33,7 @@
 #include "yb/util/mem_tracker.h"
 
 #include <algorithm>
+#include <array>
 #include <limits>
 #include <list>
 #include <memory>
@@ -120,6 +121,14 @@ DEFINE_int64(mem_tracker_tcmalloc_gc_release_bytes, -1,
              "overhead, but more efficient in terms of runtime.");
 TAG_FLAG(mem_tracker_tcmalloc_gc_release_bytes, runtime);
 
+DEFINE_int64(mem_tracker_thread_local_batch_bytes, 0,
+             "When positive, consumption changes of memory trackers are cached per thread and "
+             "applied to the tracker and its ancestors once they reach this many bytes. Reduces "
+             "contention on trackers shared by many threads, at the cost of consumption and limit "
+             "checks lagging by up to this amount per thread and tracker. Applies to trackers "
+             "created after the change.");
+TAG_FLAG(mem_tracker_thread_local_batch_bytes, advanced);
+
 namespace yb {
 
 // NOTE: this class has been adapted from Impala, so the code style varies
@@ -356,7 +365,10 @@ MemTracker::MemTracker(int64_t byte_limit, const string& id,
       rand_(GetRandomSeed32()),
       enable_logging_(FLAGS_mem_tracker_logging),
       log_stack_(FLAGS_mem_tracker_log_stack_trace),
-      add_to_parent_(add_to_parent) {
+      add_to_parent_(add_to_parent),
+      batch_bytes_(
+          consumption_functor_ ? 0 : std::max<int64_t>(
+              FLAGS_mem_tracker_thread_local_batch_bytes, 0)) {
   VLOG(1) << "Creating tracker " << ToString();
   UpdateConsumption();
 
@@ -382,14 +394,139 @@ MemTracker::MemTracker(int64_t byte_limit, const string& id,
   }
 }
 
+// Consumption changes of batched trackers cached by a single thread.
+// Entries are accessed only by the owning thread, so no synchronization is required. Entries keep
+// weak references to trackers, so changes cached for a destroyed tracker are dropped instead of
+// being applied. The tracker destructor releases its remaining consumption from ancestors, that
+// accounts for changes cached by all threads.
+class MemTracker::ThreadLocalConsumption {
+ public:
+  ~ThreadLocalConsumption() {
+    // Applying changes could destroy trackers, whose destructors update consumption of parents.
+    // Such updates should bypass this cache.
+    destroyed_ = true;
+    FlushAll();
+  }
+
+  void Update(MemTracker* tracker, int64_t delta) {
+    Entry evicted;
+    auto* entry = FindEntry(tracker);
+    if (!entry) {
+      entry = AllocateEntry(tracker, &evicted);
+      if (!entry) {
+        // Tracker is not owned by a shared_ptr, so we cannot track its lifetime.
+        tracker->ApplyDelta(delta);
+        return;
+      }
+    }
+    entry->pending += delta;
+    if (std::abs(entry->pending) >= tracker->batch_bytes_) {
+      tracker->ApplyDelta(std::exchange(entry->pending, 0));
+    }
+    // Applied last, since it could destroy tracker and reenter this cache.
+    Apply(&evicted);
+  }
+
+  void Flush(MemTracker* tracker) {
+    auto* entry = FindEntry(tracker);
+    if (entry) {
+      auto pending = entry->pending;
+      *entry = Entry();
+      tracker->ApplyDelta(pending);
+    }
+  }
+
+  void FlushAll() {
+    for (auto& entry : entries_) {
+      Entry flushed = std::move(entry);
+      entry = Entry();
+      Apply(&flushed);
+    }
+  }
+
+  // Returns nullptr when cache of the current thread was already destroyed, i.e. during thread
+  // exit. Changes should be applied directly in this case.
+  static ThreadLocalConsumption* Current() {
+    if (PREDICT_FALSE(destroyed_)) {
+      return nullptr;
+    }
+    static thread_local ThreadLocalConsumption instance;
+    return &instance;
+  }
+
+ private:
+  struct Entry {
+    // Used only for lookup, could point to destroyed tracker.
+    MemTracker* tracker = nullptr;
+    std::weak_ptr<MemTracker> weak_tracker;
+    int64_t pending = 0;
+  };
+
+  Entry* FindEntry(MemTracker* tracker) {
+    for (auto& entry : entries_) {
+      if (entry.tracker == tracker) {
+        if (entry.weak_tracker.expired()) {
+          // Cached tracker was destroyed and a new one was allocated at the same address.
+          entry = Entry();
+          return nullptr;
+        }
+        return &entry;
+      }
+    }
+    return nullptr;
+  }
+
+  Entry* AllocateEntry(MemTracker* tracker, Entry* evicted) {
+    auto weak_tracker = tracker->weak_from_this();
+    if (weak_tracker.expired()) {
+      return nullptr;
+    }
+    Entry* result = nullptr;
+    for (auto& entry : entries_) {
+      if (!entry.tracker) {
+        result = &entry;
+        break;
+      }
+    }
+    if (!result) {
+      result = &entries_[next_victim_++ % entries_.size()];
+      *evicted = std::move(*result);
+    }
+    result->tracker = tracker;
+    result->weak_tracker = std::move(weak_tracker);
+    result->pending = 0;
+    return result;
+  }
+
+  static void Apply(Entry* entry) {
+    if (!entry->tracker || entry->pending == 0) {
+      return;
+    }
+    if (auto tracker = entry->weak_tracker.lock()) {
+      tracker->ApplyDelta(entry->pending);
+    }
+  }
+
+  static thread_local bool destroyed_;
+
+  std::array<Entry, 8> entries_;
+  size_t next_victim_ = 0;
+};
+
+thread_local bool MemTracker::ThreadLocalConsumption::destroyed_ = false;
+
 MemTracker::~MemTracker() {
   VLOG(1) << "Destroying tracker " << ToString();
-  if (!consumption_functor_) {
+  // Consumption of a batched tracker does not include changes cached by threads, those are dropped
+  // and remaining consumption is released from parent below.
+  if (!consumption_functor_ && batch_bytes_ == 0) {
     DCHECK_EQ(consumption(), 0) << "Memory tracker " << ToString();
   }
   if (parent_) {
     if (add_to_parent_) {
-      parent_->Release(consumption());
+      // Bypass thread local cache of parent, so changes of this tracker cached by other threads are
+      // compensated in ancestors right away.
+      parent_->DoRelease(consumption());
     }
   }
 }
@@ -516,6 +653,20 @@ void MemTracker::Consume(int64_t bytes) {
     return;
   }
 
+  if (batched()) {
+    if (bytes == 0) {
+      return;
+    }
+    if (auto* cache = ThreadLocalConsumption::Current()) {
+      cache->Update(this, bytes);
+      return;
+    }
+  }
+
+  DoConsume(bytes);
+}
+
+void MemTracker::DoConsume(int64_t bytes) {
   if (UpdateConsumption()) {
     return;
   }
@@ -528,12 +679,22 @@ void MemTracker::Consume(int64_t bytes) {
   for (auto& tracker : all_trackers_) {
     if (!tracker->UpdateConsumption()) {
       IncrementBy(bytes, &tracker->consumption_, tracker->metrics_);
-      DCHECK_GE(tracker->consumption_.current_value(), 0);
+      DCHECK(batch_bytes_ > 0 || tracker->consumption_.current_value() >= 0);
     }
   }
 }
 
 bool MemTracker::TryConsume(int64_t bytes, MemTracker** blocking_mem_tracker) {
+  auto* cache = batched() && bytes > 0 ? ThreadLocalConsumption::Current() : nullptr;
+  if (cache) {
+    // Limits are checked against consumption that could lag by up to batch_bytes_ per thread.
+    if (bytes < batch_bytes_ && SpareCapacity() >= bytes) {
+      cache->Update(this, bytes);
+      return true;
+    }
+    cache->Flush(this);
+  }
+
   UpdateConsumption();
   if (bytes <= 0) {
     return true;
@@ -594,6 +755,20 @@ void MemTracker::Release(int64_t bytes) {
     return;
   }
 
+  if (batched()) {
+    if (bytes == 0) {
+      return;
+    }
+    if (auto* cache = ThreadLocalConsumption::Current()) {
+      cache->Update(this, -bytes);
+      return;
+    }
+  }
+
+  DoRelease(bytes);
+}
+
+void MemTracker::DoRelease(int64_t bytes) {
   if (PREDICT_FALSE(base::subtle::Barrier_AtomicIncrement(&released_memory_since_gc, bytes) >
                     GetAtomicFlag(&FLAGS_mem_tracker_tcmalloc_gc_release_bytes))) {
     GcTcmalloc();
@@ -619,11 +794,28 @@ void MemTracker::Release(int64_t bytes) {
       // metric. Don't blow up in this case. (Note that this doesn't affect non-process
       // trackers since we can enforce that the reported memory usage is internally
       // consistent.)
-      DCHECK_GE(tracker->consumption_.current_value(), 0) << "Tracker: " << tracker->ToString();
+      // With batching, memory consumed by one thread could be released by another one, whose
+      // cached changes are applied first.
+      DCHECK(batch_bytes_ > 0 || tracker->consumption_.current_value() >= 0)
+          << "Tracker: " << tracker->ToString();
     }
   }
 }
 
+void MemTracker::ApplyDelta(int64_t delta) {
+  if (delta > 0) {
+    DoConsume(delta);
+  } else if (delta < 0) {
+    DoRelease(-delta);
+  }
+}
+
+void MemTracker::FlushThreadLocalConsumption() {
+  if (auto* cache = ThreadLocalConsumption::Current()) {
+    cache->FlushAll();
+  }
+}
+
 bool MemTracker::AnyLimitExceeded() {
   for (const auto& tracker : limit_trackers_) {
     if (tracker->LimitExceeded()) {
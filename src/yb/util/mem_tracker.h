@@ -293,6 +293,10 @@ class MemTracker : public std::enable_shared_from_this<MemTracker> {
   // Decreases consumption of this tracker and its ancestors by 'bytes'.
   void Release(int64_t bytes);
 
+  // Applies consumption changes cached by the calling thread, see
+  // mem_tracker_thread_local_batch_bytes.
+  static void FlushThreadLocalConsumption();
+
   // Returns true if a valid limit of this tracker or one of its ancestors is
   // exceeded.
   bool AnyLimitExceeded();
@@ -404,6 +408,17 @@ class MemTracker : public std::enable_shared_from_this<MemTracker> {
   // Logs the stack of the current consume/release. Used for debugging only.
   void LogUpdate(bool is_consume, int64_t bytes) const;
 
+  class ThreadLocalConsumption;
+
+  bool batched() const {
+    return batch_bytes_ > 0 && !enable_logging_;
+  }
+
+  // Applies consumption change to this tracker and its ancestors, bypassing thread local cache.
+  void ApplyDelta(int64_t delta);
+  void DoConsume(int64_t bytes);
+  void DoRelease(int64_t bytes);
+
   // Variant of CreateTracker() that:
   // 1. Must be called with a non-NULL parent, and
   // 2. Must be called with parent->child_trackers_lock_ held.
@@ -464,6 +479,10 @@ class MemTracker : public std::enable_shared_from_this<MemTracker> {
   bool log_stack_;
 
   AddToParent add_to_parent_;
+
+  // Max absolute consumption change of this tracker that could be cached by a thread before it is
+  // applied to this tracker and its ancestors. 0 if changes are applied immediately.
+  const int64_t batch_bytes_;
 };
 
 // An std::allocator that manipulates a MemTracker during allocation
@@ -0,0 +1,80 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "yb/util/env.h"
+#include "yb/util/numa.h"
+#include "yb/util/result.h"
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+DECLARE_bool(numa_aware_thread_placement);
+
+namespace yb {
+
+class NumaTest : public YBTest {
+};
+
+TEST_F(NumaTest, ParseCpuList) {
+  ASSERT_EQ(ASSERT_RESULT(ParseCpuList("")), std::vector<int>());
+  ASSERT_EQ(ASSERT_RESULT(ParseCpuList("5\n")), std::vector<int>({5}));
+  ASSERT_EQ(ASSERT_RESULT(ParseCpuList("0-3,8,10-11")),
+            std::vector<int>({0, 1, 2, 3, 8, 10, 11}));
+  ASSERT_NOK(ParseCpuList("3-1"));
+  ASSERT_NOK(ParseCpuList("a-b"));
+  ASSERT_NOK(ParseCpuList("1:2"));
+}
+
+TEST_F(NumaTest, LoadNodes) {
+  const auto dir = GetTestPath("node");
+  ASSERT_OK(env_->CreateDir(dir));
+  ASSERT_EQ(ASSERT_RESULT(LoadNumaNodes(dir)).size(), 0);
+
+  // Node ids are sparse, node 3 is online but has no CPUs.
+  ASSERT_OK(WriteStringToFile(env_.get(), "0,2-3\n", dir + "/online"));
+  for (auto [id, cpus] : {std::make_pair(0, "0-1,4"), std::make_pair(2, "2,3"),
+                          std::make_pair(3, "\n"), std::make_pair(5, "5")}) {
+    const auto node_dir = Format("$0/node$1", dir, id);
+    ASSERT_OK(env_->CreateDir(node_dir));
+    ASSERT_OK(WriteStringToFile(env_.get(), cpus, node_dir + "/cpulist"));
+  }
+  auto nodes = ASSERT_RESULT(LoadNumaNodes(dir));
+  ASSERT_EQ(nodes.size(), 2);
+  ASSERT_EQ(nodes[0].id, 0);
+  ASSERT_EQ(nodes[0].cpus, std::vector<int>({0, 1, 4}));
+  ASSERT_EQ(nodes[1].id, 2);
+  ASSERT_EQ(nodes[1].cpus, std::vector<int>({2, 3}));
+}
+
+TEST_F(NumaTest, BindThread) {
+  FLAGS_numa_aware_thread_placement = true;
+  const auto& nodes = NumaNodes();
+  LOG(INFO) << "NUMA nodes: " << nodes.size();
+  for (size_t i = 0; i != 2 * nodes.size(); ++i) {
+    std::thread thread([i, &nodes] {
+      auto node_index = MaybeBindCurrentThreadToNumaNode(i);
+      ASSERT_EQ(node_index, CurrentThreadNumaNodeIndex());
+      if (nodes.size() < 2) {
+        ASSERT_EQ(node_index, -1);
+      } else {
+        ASSERT_EQ(node_index, static_cast<int>(i % nodes.size()));
+      }
+    });
+    thread.join();
+  }
+}
+
+} // namespace yb
@@ -0,0 +1,164 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/util/numa.h"
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <fstream>
+#include <sstream>
+
+#include <boost/algorithm/string.hpp>
+
+#include "yb/util/errno.h"
+#include "yb/util/flag_tags.h"
+#include "yb/util/logging.h"
+#include "yb/util/result.h"
+#include "yb/util/status_format.h"
+
+DEFINE_bool(numa_aware_thread_placement, false,
+            "Bind RPC reactor and worker threads to NUMA nodes in round robin manner, so "
+            "connections and buffers they allocate stay local to a node. Inbound calls are "
+            "processed by workers on the node of the reactor that received them.");
+TAG_FLAG(numa_aware_thread_placement, advanced);
+
+namespace yb {
+
+namespace {
+
+const std::string kSysfsNodeDir = "/sys/devices/system/node";
+
+thread_local int current_thread_numa_node_index = -1;
+
+// Returns false if the file does not exist.
+bool ReadFirstLine(const std::string& path, std::string* line) {
+  std::ifstream input(path);
+  if (!input) {
+    return false;
+  }
+  std::getline(input, *line);
+  return true;
+}
+
+std::vector<NumaNode> LoadSystemNumaNodes() {
+#if defined(__linux__)
+  auto result = LoadNumaNodes(kSysfsNodeDir);
+  if (!result.ok()) {
+    LOG(WARNING) << "Failed to load NUMA topology: " << result.status();
+    return {};
+  }
+  return std::move(*result);
+#else
+  return {};
+#endif
+}
+
+} // namespace
+
+const std::vector<NumaNode>& NumaNodes() {
+  static const std::vector<NumaNode> result = LoadSystemNumaNodes();
+  return result;
+}
+
+Result<std::vector<NumaNode>> LoadNumaNodes(const std::string& sysfs_node_dir) {
+  std::vector<NumaNode> result;
+  std::string node_list;
+  if (!ReadFirstLine(sysfs_node_dir + "/online", &node_list)) {
+    return result;
+  }
+  for (auto id : VERIFY_RESULT(ParseCpuList(node_list))) {
+    std::string cpu_list;
+    if (!ReadFirstLine(Format("$0/node$1/cpulist", sysfs_node_dir, id), &cpu_list)) {
+      continue;
+    }
+    auto cpus = VERIFY_RESULT_PREPEND(
+        ParseCpuList(cpu_list), Format("Bad cpus of NUMA node $0", id));
+    if (!cpus.empty()) {
+      result.push_back(NumaNode {
+        .id = id,
+        .cpus = std::move(cpus),
+      });
+    }
+  }
+  return result;
+}
+
+Result<std::vector<int>> ParseCpuList(const std::string& cpu_list) {
+  std::vector<int> result;
+  std::vector<std::string> ranges;
+  auto trimmed = boost::trim_copy(cpu_list);
+  if (trimmed.empty()) {
+    return result;
+  }
+  boost::split(ranges, trimmed, boost::is_any_of(","));
+  for (const auto& range : ranges) {
+    int first, last;
+    char dash;
+    std::istringstream in(range);
+    if (!(in >> first)) {
+      return STATUS_FORMAT(InvalidArgument, "Bad cpu range '$0' in '$1'", range, cpu_list);
+    }
+    last = first;
+    if (in >> dash) {
+      if (dash != '-' || !(in >> last) || last < first) {
+        return STATUS_FORMAT(InvalidArgument, "Bad cpu range '$0' in '$1'", range, cpu_list);
+      }
+    }
+    for (int cpu = first; cpu <= last; ++cpu) {
+      result.push_back(cpu);
+    }
+  }
+  return result;
+}
+
+size_t NumNumaPlacementNodes() {
+  if (!FLAGS_numa_aware_thread_placement) {
+    return 1;
+  }
+  return std::max<size_t>(NumaNodes().size(), 1);
+}
+
+int MaybeBindCurrentThreadToNumaNode(size_t index) {
+  auto num_nodes = NumNumaPlacementNodes();
+  if (num_nodes < 2) {
+    return -1;
+  }
+  auto node_index = index % num_nodes;
+  const auto& node = NumaNodes()[node_index];
+#if defined(__linux__)
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (auto cpu : node.cpus) {
+    CPU_SET(cpu, &cpu_set);
+  }
+  int err = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+  if (err != 0) {
+    YB_LOG_EVERY_N_SECS(WARNING, 60)
+        << "Failed to bind thread to NUMA node " << node.id << ": " << ErrnoToString(err);
+    return -1;
+  }
+  current_thread_numa_node_index = static_cast<int>(node_index);
+  return current_thread_numa_node_index;
+#else
+  return -1;
+#endif
+}
+
+int CurrentThreadNumaNodeIndex() {
+  return current_thread_numa_node_index;
+}
+
+} // namespace yb
@@ -0,0 +1,57 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_UTIL_NUMA_H
+#define YB_UTIL_NUMA_H
+
+#include <string>
+#include <vector>
+
+#include "yb/util/status_fwd.h"
+
+namespace yb {
+
+struct NumaNode {
+  // Node id assigned by the kernel. Ids could be sparse, e.g. when some nodes are offline.
+  int id = -1;
+  std::vector<int> cpus;
+};
+
+// Online NUMA nodes of this machine that have CPUs, ordered by id. Empty when NUMA topology is not
+// available, for instance on non Linux platforms.
+const std::vector<NumaNode>& NumaNodes();
+
+// Loads NUMA topology from the sysfs node directory, i.e. /sys/devices/system/node.
+Result<std::vector<NumaNode>> LoadNumaNodes(const std::string& sysfs_node_dir);
+
+// Parses cpu or node list in the sysfs format, i.e. "0-3,8,10-11".
+Result<std::vector<int>> ParseCpuList(const std::string& cpu_list);
+
+// Number of NUMA nodes that threads are spread over. 1 unless --numa_aware_thread_placement is set
+// and the machine has several NUMA nodes.
+size_t NumNumaPlacementNodes();
+
+// Binds the current thread to the CPUs of the NUMA node with position (index % number of nodes)
+// in NumaNodes(), when NumNumaPlacementNodes() is above 1.
+// Memory is allocated on the node of the thread that first touches it, so data structures
+// created and used by this thread stay local to the node.
+// Returns the position of the node the thread was bound to, or -1 if it was not bound.
+int MaybeBindCurrentThreadToNumaNode(size_t index);
+
+// Position in NumaNodes() of the node the current thread was bound to by
+// MaybeBindCurrentThreadToNumaNode, or -1.
+int CurrentThreadNumaNodeIndex();
+
+} // namespace yb
+
+#endif // YB_UTIL_NUMA_H
@@ -17,6 +17,11 @@
 #include <sys/timex.h>
 #endif
 
+#include <fstream>
+
+#include <boost/optional.hpp>
+
+#include "yb/gutil/cycleclock-inl.h"
 #include "yb/gutil/walltime.h"
 
 #include "yb/util/atomic.h"
@@ -40,6 +45,16 @@ DEFINE_uint64(max_clock_skew_usec, 500 * 1000,
               "Transaction read clock skew in usec. "
               "This is the maximum allowed time delta between servers of a single cluster.");
 
+DEFINE_uint64(tsc_clock_refresh_interval_usec, 1000,
+              "How often the TSC clock re-reads time from the underlying clock.");
+TAG_FLAG(tsc_clock_refresh_interval_usec, advanced);
+TAG_FLAG(tsc_clock_refresh_interval_usec, runtime);
+
+DEFINE_uint64(tsc_clock_max_drift_ppm, 200,
+              "Max drift of the TSC relative to the underlying clock, in parts per million. "
+              "Time extrapolated by the TSC clock has its max error increased accordingly.");
+TAG_FLAG(tsc_clock_max_drift_ppm, advanced);
+
 namespace yb {
 
 namespace {
@@ -120,8 +135,151 @@ class AdjTimeClockImpl : public PhysicalClock {
 
 #endif
 
+#if defined(__x86_64__)
+
+bool HasInvariantTsc() {
+  std::ifstream cpuinfo("/proc/cpuinfo");
+  std::string line;
+  while (std::getline(cpuinfo, line)) {
+    if (line.compare(0, 5, "flags") == 0) {
+      return line.find(" constant_tsc") != std::string::npos &&
+             line.find(" nonstop_tsc") != std::string::npos;
+    }
+  }
+  return false;
+}
+
+class TscClockImpl : public PhysicalClock {
+ public:
+  explicit TscClockImpl(PhysicalClockPtr underlying)
+      : underlying_(std::move(underlying)) {
+  }
+
+  Result<PhysicalTime> Now() override {
+    auto result = ReadPage(CycleClock::Now());
+    if (result) {
+      return *result;
+    }
+    return Refresh();
+  }
+
+  MicrosTime MaxGlobalTime(PhysicalTime time) override {
+    return underlying_->MaxGlobalTime(time);
+  }
+
+ private:
+  // Time page is a seqlock: 'sequence' is odd while the page is being updated and 0 before the
+  // first update.
+  struct TimePage {
+    std::atomic<uint64_t> sequence{0};
+    std::atomic<int64_t> base_cycles{0};
+    std::atomic<MicrosTime> base_micros{0};
+    std::atomic<MicrosTime> base_error{0};
+    std::atomic<double> cycles_per_us{0};
+  };
+
+  boost::optional<PhysicalTime> ReadPage(int64_t cycles) {
+    auto sequence = page_.sequence.load(std::memory_order_acquire);
+    if (sequence == 0 || (sequence & 1)) {
+      return boost::none;
+    }
+    auto base_cycles = page_.base_cycles.load(std::memory_order_relaxed);
+    auto base_micros = page_.base_micros.load(std::memory_order_relaxed);
+    auto base_error = page_.base_error.load(std::memory_order_relaxed);
+    auto cycles_per_us = page_.cycles_per_us.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (page_.sequence.load(std::memory_order_relaxed) != sequence) {
+      return boost::none;
+    }
+
+    // TSC of different cores could be slightly out of sync, never go before the page base.
+    auto elapsed_us = static_cast<MicrosTime>(std::max<int64_t>(cycles - base_cycles, 0) /
+                                              cycles_per_us);
+    if (elapsed_us >= GetAtomicFlag(&FLAGS_tsc_clock_refresh_interval_usec)) {
+      return boost::none;
+    }
+    auto drift_us = elapsed_us * GetAtomicFlag(&FLAGS_tsc_clock_max_drift_ppm) / 1000000 + 1;
+    return PhysicalTime { base_micros + elapsed_us, base_error + drift_us };
+  }
+
+  Result<PhysicalTime> Refresh() {
+    auto time = VERIFY_RESULT(underlying_->Now());
+    auto cycles = CycleClock::Now();
+
+    // Only one thread updates the page, others just use the time they have read.
+    bool expected = false;
+    if (!refreshing_.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+      return time;
+    }
+
+    // Calibrate TSC frequency against the underlying clock. The first calibration uses a short
+    // interval, after that the frequency is recalibrated over intervals of at least a second.
+    // Until the first calibration completes the page is not published, so all readers use the
+    // underlying clock.
+    constexpr MicrosTime kInitialCalibrationIntervalUs = 100000;
+    constexpr MicrosTime kCalibrationIntervalUs = 1000000;
+    if (calibration_micros_ == 0 || time.time_point < calibration_micros_ ||
+        cycles <= calibration_cycles_) {
+      calibration_cycles_ = cycles;
+      calibration_micros_ = time.time_point;
+    } else if (time.time_point - calibration_micros_ >=
+                   (calibrated_cycles_per_us_ > 0 ? kCalibrationIntervalUs
+                                                  : kInitialCalibrationIntervalUs)) {
+      calibrated_cycles_per_us_ =
+          static_cast<double>(cycles - calibration_cycles_) /
+          (time.time_point - calibration_micros_);
+      calibration_cycles_ = cycles;
+      calibration_micros_ = time.time_point;
+    }
+
+    if (calibrated_cycles_per_us_ <= 0) {
+      refreshing_.store(false, std::memory_order_release);
+      return time;
+    }
+
+    auto sequence = page_.sequence.load(std::memory_order_relaxed);
+    page_.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    page_.base_cycles.store(cycles, std::memory_order_relaxed);
+    page_.base_micros.store(time.time_point, std::memory_order_relaxed);
+    page_.base_error.store(time.max_error, std::memory_order_relaxed);
+    page_.cycles_per_us.store(calibrated_cycles_per_us_, std::memory_order_relaxed);
+    page_.sequence.store(sequence + 2, std::memory_order_release);
+
+    refreshing_.store(false, std::memory_order_release);
+    return time;
+  }
+
+  const PhysicalClockPtr underlying_;
+  TimePage page_;
+
+  // Fields below are accessed only by the thread that holds 'refreshing_'.
+  std::atomic<bool> refreshing_{false};
+  double calibrated_cycles_per_us_ = 0;
+  int64_t calibration_cycles_ = 0;
+  MicrosTime calibration_micros_ = 0;
+};
+
+#endif
+
 } // namespace
 
+PhysicalClockPtr CreateTscClock(PhysicalClockPtr underlying) {
+#if defined(__x86_64__)
+  static const bool has_invariant_tsc = HasInvariantTsc();
+  if (has_invariant_tsc) {
+    return std::make_shared<TscClockImpl>(std::move(underlying));
+  }
+  YB_LOG_FIRST_N(WARNING, 1) << "TSC is not invariant, TSC clock is not used";
+#endif
+  return underlying;
+}
+
+const PhysicalClockPtr& TscWallClock() {
+  static PhysicalClockPtr instance = CreateTscClock(WallClock());
+  return instance;
+}
+
 std::string PhysicalTime::ToString() const {
   return YB_STRUCT_TO_STRING(time_point, max_error);
 }
@@ -67,6 +67,15 @@ class MockClock : public PhysicalClock {
 
 const PhysicalClockPtr& WallClock();
 
+// Clock that reads a process-wide time page, periodically refreshed from the 'underlying' clock,
+// and extrapolates from it using the CPU time stamp counter. Reported max_error is increased by the
+// allowed TSC drift since the last refresh. The underlying clock is called only when the page
+// expires. If the TSC is not invariant on this machine, the underlying clock is returned as is.
+PhysicalClockPtr CreateTscClock(PhysicalClockPtr underlying);
+
+// TSC clock on top of WallClock().
+const PhysicalClockPtr& TscWallClock();
+
 #if !defined(__APPLE__)
 const PhysicalClockPtr& AdjTimeClock();
 #endif
@@ -279,9 +279,7 @@ void CQLProcessor::SendResponse(const CQLResponse& response) {
   MonoTime response_begin = MonoTime::Now();
   const auto& context = static_cast<const CQLConnectionContext&>(call_->connection()->context());
   const auto compression_scheme = context.compression_scheme();
-  faststring msg;
-  response.Serialize(compression_scheme, &msg);
-  call_->RespondSuccess(RefCntBuffer(msg));
+  call_->RespondSuccess(response.SerializeToBuffer(compression_scheme));
 
   MonoTime response_done = MonoTime::Now();
   cql_metrics_->time_to_process_request_->Increment(
@@ -414,6 +414,27 @@ class TnodeContext {
     max_hash_code_from_partition_key_ops_ = max_hash_code;
   }
 
+  // Token range of a single tablet.
+  struct TabletHashRange {
+    uint16_t hash_code;
+    uint16_t max_hash_code;
+  };
+
+  // Used for full-table aggregate scans that read several tablets in parallel. Holds token ranges
+  // of the tablets that are not being read yet, the next one to read is at the back.
+  std::vector<TabletHashRange>& pending_tablet_ranges() {
+    return pending_tablet_ranges_;
+  }
+
+  // Whether this SELECT is a full-table aggregate scan whose ops read tablets in parallel.
+  bool parallel_aggregate_scan() const {
+    return parallel_aggregate_scan_;
+  }
+
+  void set_parallel_aggregate_scan() {
+    parallel_aggregate_scan_ = true;
+  }
+
  private:
   // Tree node of the statement being executed.
   const TreeNode* tnode_ = nullptr;
@@ -455,6 +476,9 @@ class TnodeContext {
 
   boost::optional<uint32_t> hash_code_from_partition_key_ops_;
   boost::optional<uint32_t> max_hash_code_from_partition_key_ops_;
+
+  std::vector<TabletHashRange> pending_tablet_ranges_;
+  bool parallel_aggregate_scan_ = false;
 };
 
 // The context for execution of a statement. Inside the statement parse tree, there may be one or
@@ -28,6 +28,7 @@
 #include "yb/common/consistent_read_point.h"
 #include "yb/common/index.h"
 #include "yb/common/index_column.h"
+#include "yb/common/partition.h"
 #include "yb/common/ql_protocol_util.h"
 #include "yb/common/ql_rowblock.h"
 #include "yb/common/ql_value.h"
@@ -39,6 +40,7 @@
 #include "yb/rpc/thread_pool.h"
 
 #include "yb/util/decimal.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/metrics.h"
 #include "yb/util/random_util.h"
 #include "yb/util/result.h"
@@ -110,6 +112,18 @@ DEFINE_bool(ycql_serial_operation_in_transaction_block, true,
             "If true, operations within a transaction block must be executed in order, "
             "at least semantically speaking.");
 
+DEFINE_int32(ycql_max_parallel_aggregate_scan_tablets, 16,
+             "Maximum number of tablets read in parallel by a full-table scan that computes "
+             "aggregates. Set to 1 to read tablets one after another. Full-table scans that "
+             "return rows always read tablets one after another.");
+
+DEFINE_int32(ycql_consistent_prefix_max_staleness_ms, 0,
+             "Maximum staleness of data returned by YCQL reads with consistency level ONE. Such "
+             "reads are served by the closest follower that is known to satisfy the bound, or by "
+             "the leader. 0 means that any staleness is acceptable.");
+TAG_FLAG(ycql_consistent_prefix_max_staleness_ms, advanced);
+TAG_FLAG(ycql_consistent_prefix_max_staleness_ms, runtime);
+
 extern ErrorCode QLStatusToErrorCode(QLResponsePB::QLStatus status);
 
 Executor::Executor(QLEnv* ql_env, AuditLogger* audit_logger, Rescheduler* rescheduler,
@@ -1055,6 +1069,10 @@ Status Executor::ExecPTNode(const PTSelectStmt *tnode, TnodeContext* tnode_conte
   // Set the consistency level for the operation. Always use strong consistency for system tables.
   select_op->set_yb_consistency_level(tnode->is_system() ? YBConsistencyLevel::STRONG
                                                          : params.yb_consistency_level());
+  const auto max_staleness_ms = FLAGS_ycql_consistent_prefix_max_staleness_ms;
+  if (max_staleness_ms > 0) {
+    select_op->set_max_staleness(MonoDelta::FromMilliseconds(max_staleness_ms));
+  }
 
   // Save the hash_code and max_hash_code limits computed from the request's partition_key_ops in
   // WhereClauseToPB(). These will be used later to be set in the request protobuf in
@@ -1089,6 +1107,7 @@ Status Executor::ExecPTNode(const PTSelectStmt *tnode, TnodeContext* tnode_conte
         YBqlReadOpPtr op(table->NewQLSelect());
         op->mutable_request()->CopyFrom(select_op->request());
         op->set_yb_consistency_level(select_op->yb_consistency_level());
+        op->set_max_staleness(select_op->max_staleness());
         tnode_context->AdvanceToNextPartition(op->mutable_request());
         AddOperation(op, tnode_context);
         select_op = op; // Use new op as base for the next one, if any.
@@ -1097,6 +1116,13 @@ Status Executor::ExecPTNode(const PTSelectStmt *tnode, TnodeContext* tnode_conte
     }
   }
 
+  // Partial aggregates of a full-table scan could arrive in any order, so such a scan reads
+  // several tablets in parallel.
+  if (!continue_user_request &&
+      VERIFY_RESULT(AddParallelAggregateScanOps(tnode, select_op, tnode_context))) {
+    return Status::OK();
+  }
+
   // If this select statement uses an uncovered index underneath, save this op as a template to
   // read from the table once the primary keys are returned from the uncovered index. The paging
   // state should be used by the underlying select from the index only which decides where to
@@ -1161,6 +1187,79 @@ Result<QueryPagingState*> Executor::LoadPagingStateFromUser(const PTSelectStmt*
   return query_state;
 }
 
+namespace {
+
+// Points the request to the next tablet of a parallel full-table scan.
+void ReadNextTabletRange(QLReadRequestPB* req, TnodeContext* tnode_context) {
+  auto& ranges = tnode_context->pending_tablet_ranges();
+  req->set_hash_code(ranges.back().hash_code);
+  req->set_max_hash_code(ranges.back().max_hash_code);
+  req->clear_paging_state();
+  ranges.pop_back();
+}
+
+} // namespace
+
+// Only aggregate scans are split. Scans that return rows keep reading tablets one after another:
+// their pages must come back in token order with a single resumable paging state, so reading
+// tablets ahead would need an ordered merge of the results and would discard rows that do not fit
+// into the page.
+Result<bool> Executor::AddParallelAggregateScanOps(const PTSelectStmt* tnode,
+                                                   const YBqlReadOpPtr& select_op,
+                                                   TnodeContext* tnode_context) {
+  const auto max_parallel_tablets = FLAGS_ycql_max_parallel_aggregate_scan_tablets;
+  const QLReadRequestPB& req = select_op->request();
+  if (max_parallel_tablets <= 1 || !tnode->is_aggregate() || tnode->child_select() ||
+      tnode->limit() || !req.hashed_column_values().empty() || req.has_offset() ||
+      !select_op->table()->IsHashPartitioned()) {
+    return false;
+  }
+
+  // Intersect tablet ranges with the token range requested by the user.
+  constexpr uint32_t kMaxHashCode = PartitionSchema::kMaxPartitionKey;
+  const uint32_t min_hash_code = req.has_hash_code() ? req.hash_code() : 0;
+  const uint32_t max_hash_code = req.has_max_hash_code() ? req.max_hash_code() : kMaxHashCode;
+  const auto partitions = select_op->table()->GetPartitionsShared();
+  auto& ranges = tnode_context->pending_tablet_ranges();
+  ranges.clear();
+  for (auto it = partitions->begin(); it != partitions->end(); ++it) {
+    const auto next = std::next(it);
+    uint32_t start = it->empty() ? 0 : PartitionSchema::DecodeMultiColumnHashValue(*it);
+    uint32_t end = next == partitions->end()
+        ? kMaxHashCode : PartitionSchema::DecodeMultiColumnHashValue(*next) - 1u;
+    start = std::max(start, min_hash_code);
+    end = std::min(end, max_hash_code);
+    if (start <= end) {
+      ranges.push_back({ static_cast<uint16_t>(start), static_cast<uint16_t>(end) });
+    }
+  }
+  // Each tablet returns a row with its partial aggregate. If these rows do not fit into one page,
+  // the scan is left to the serial path, which resumes the next page from the user's paging state.
+  const auto fetch_limit = static_cast<int64_t>(tnode_context->query_state()->max_fetch_size());
+  if (ranges.size() <= 1 ||
+      (fetch_limit >= 0 && ranges.size() > static_cast<size_t>(fetch_limit))) {
+    ranges.clear();
+    return false;
+  }
+  std::reverse(ranges.begin(), ranges.end());
+  tnode_context->set_parallel_aggregate_scan();
+
+  // The rest of the tablets are read by the ops as they finish, see FetchMoreRows.
+  const auto num_ops = std::min<size_t>(ranges.size(), max_parallel_tablets);
+  for (size_t i = 0; i != num_ops; ++i) {
+    YBqlReadOpPtr op = select_op;
+    if (i != 0) {
+      op.reset(select_op->table()->NewQLSelect());
+      op->mutable_request()->CopyFrom(select_op->request());
+      op->set_yb_consistency_level(select_op->yb_consistency_level());
+      op->set_max_staleness(select_op->max_staleness());
+    }
+    ReadNextTabletRange(op->mutable_request(), tnode_context);
+    AddOperation(op, tnode_context);
+  }
+  return true;
+}
+
 Status Executor::GenerateEmptyResult(const PTSelectStmt* tnode) {
   YBqlReadOpPtr select_op(tnode->table()->NewQLSelect());
   QLRowBlock empty_row_block(tnode->table()->InternalSchema(), {});
@@ -1187,6 +1286,29 @@ Result<bool> Executor::FetchMoreRows(const PTSelectStmt* tnode,
     return false;
   }
 
+  // Ops of a parallel full-table scan continue independently of each other, so each of them uses
+  // the paging state of its own response instead of the one shared by the statement. E.g. if a
+  // tablet was split after the partitions were fetched, the op continues to the next part of its
+  // range. When the op finishes its tablet, it starts reading the next pending one.
+  if (tnode_context->parallel_aggregate_scan()) {
+    const QLPagingStatePB& response_paging_state = op->response().paging_state();
+    if (!response_paging_state.next_partition_key().empty() ||
+        !response_paging_state.next_row_key().empty()) {
+      QLPagingStatePB* paging_state = op->mutable_request()->mutable_paging_state();
+      paging_state->set_next_partition_key(response_paging_state.next_partition_key());
+      paging_state->set_next_row_key(response_paging_state.next_row_key());
+      return true;
+    }
+    if (!tnode_context->pending_tablet_ranges().empty()) {
+      ReadNextTabletRange(op->mutable_request(), tnode_context);
+      return true;
+    }
+    // The shared paging state could still hold the position of another op. The last op to finish
+    // clears it, so no paging state is returned to the user.
+    RETURN_NOT_OK(tnode_context->ClearQueryState());
+    return false;
+  }
+
   //------------------------------------------------------------------------------------------------
   // Check if we should fetch more rows.
 
@@ -1265,6 +1387,7 @@ Result<bool> Executor::FetchRowsByKeys(const PTSelectStmt* tnode,
   for (const QLRow& key : keys.rows()) {
     YBqlReadOpPtr op(tnode->table()->NewQLSelect());
     op->set_yb_consistency_level(select_op->yb_consistency_level());
+    op->set_max_staleness(select_op->max_staleness());
     QLReadRequestPB* req = op->mutable_request();
     req->CopyFrom(select_op->request());
     RETURN_NOT_OK(WhereKeyToPB(req, schema, key));
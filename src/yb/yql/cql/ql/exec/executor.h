@@ -248,6 +248,13 @@ class Executor : public QLExprExecutor {
   // When request does not need to be executed, create and return empty result (0 row) to users.
   Status GenerateEmptyResult(const PTSelectStmt* tnode);
 
+  // Split a full-table aggregate scan into ops that read tablets in parallel, at most
+  // ycql_max_parallel_aggregate_scan_tablets at a time. Returns false if the scan should not be
+  // split. Scans that return rows are never split, see the implementation.
+  Result<bool> AddParallelAggregateScanOps(const PTSelectStmt* tnode,
+                                           const client::YBqlReadOpPtr& select_op,
+                                           TnodeContext* tnode_context);
+
   // Continue a multi-partition select (e.g. table scan or query with 'IN' condition on hash cols).
   Result<bool> FetchMoreRows(const PTSelectStmt* tnode,
                              const client::YBqlReadOpPtr& op,
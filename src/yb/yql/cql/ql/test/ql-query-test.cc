@@ -43,6 +43,8 @@ using std::unique_ptr;
 using std::shared_ptr;
 using strings::Substitute;
 
+DECLARE_int32(ycql_consistent_prefix_max_staleness_ms);
+
 namespace yb {
 namespace ql {
 
@@ -920,6 +922,40 @@ void RunPaginationWithDescTest(
   CHECK_GE(page_count, (values.size() - 2) / kPageSize);
 }
 
+TEST_F(TestQLQuery, TestBoundedStalenessRead) {
+  FLAGS_ycql_consistent_prefix_max_staleness_ms = 50;
+
+  // Init the simulated cluster.
+  ASSERT_NO_FATALS(CreateSimulatedCluster(3));
+
+  // Get a processor.
+  TestQLProcessor *processor = GetQLProcessor();
+
+  CHECK_VALID_STMT("CREATE TABLE t (h int, r int, v int, primary key((h), r));");
+
+  static constexpr int kNumRows = 10;
+  for (int i = 1; i <= kNumRows; i++) {
+    CHECK_VALID_STMT(Substitute("INSERT INTO t (h, r, v) VALUES ($0, $1, $2);", 1, i, 100 + i));
+  }
+
+  // The rows were written before the staleness bound, so reads with consistency level ONE have to
+  // see them, no matter which replica serves the read.
+  SleepFor(MonoDelta::FromMilliseconds(100));
+
+  StatementParameters params;
+  params.set_yb_consistency_level(YBConsistencyLevel::CONSISTENT_PREFIX);
+  for (int iter = 0; iter != 20; ++iter) {
+    ASSERT_OK(processor->Run("SELECT h, r, v FROM t WHERE h = 1;", params));
+    std::shared_ptr<QLRowBlock> row_block = processor->row_block();
+    ASSERT_EQ(row_block->row_count(), kNumRows);
+    for (int i = 0; i != kNumRows; ++i) {
+      const QLRow& row = row_block->row(i);
+      ASSERT_EQ(row.column(1).int32_value(), i + 1);
+      ASSERT_EQ(row.column(2).int32_value(), 101 + i);
+    }
+  }
+}
+
 TEST_F(TestQLQuery, TestPaginationWithDescSort) {
 
   // Init the simulated cluster.
@@ -0,0 +1,161 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "yb/client/yb_table_name.h"
+
+#include "yb/common/ql_protocol.pb.h"
+#include "yb/common/ql_rowblock.h"
+#include "yb/common/schema.h"
+
+#include "yb/gutil/casts.h"
+#include "yb/gutil/endian.h"
+
+#include "yb/util/cast.h"
+#include "yb/util/faststring.h"
+#include "yb/util/ref_cnt_buffer.h"
+#include "yb/util/test_util.h"
+
+#include "yb/yql/cql/ql/util/cql_message.h"
+#include "yb/yql/cql/ql/util/statement_result.h"
+
+namespace yb {
+namespace ql {
+
+namespace {
+
+void AppendShort(uint16_t value, std::string* out) {
+  uint8_t buffer[sizeof(value)];
+  NetworkByteOrder::Store16(buffer, value);
+  out->append(pointer_cast<const char*>(buffer), sizeof(buffer));
+}
+
+void AppendInt(uint32_t value, std::string* out) {
+  uint8_t buffer[sizeof(value)];
+  NetworkByteOrder::Store32(buffer, value);
+  out->append(pointer_cast<const char*>(buffer), sizeof(buffer));
+}
+
+// Builds and parses a QUERY request frame with the given header and query parameter flags.
+std::unique_ptr<QueryRequest> ParseQueryRequest(
+    CQLMessage::Flags header_flags, CQLMessage::QueryParameters::Flags query_flags) {
+  const std::string query = "SELECT * FROM test_ks.test_table";
+
+  std::string body;
+  if (header_flags & CQLMessage::kMetadataFlag) {
+    body.append(CQLMessage::kMetadataSize, '\0');
+  }
+  AppendInt(narrow_cast<uint32_t>(query.size()), &body);
+  body += query;
+  AppendShort(static_cast<uint16_t>(CQLMessage::Consistency::ONE), &body);
+  body.push_back(static_cast<char>(query_flags));
+
+  std::string frame;
+  frame.push_back(static_cast<char>(CQLMessage::kV4Version));
+  frame.push_back(static_cast<char>(header_flags));
+  AppendShort(/* stream_id = */ 42, &frame);
+  frame.push_back(static_cast<char>(CQLMessage::Opcode::QUERY));
+  AppendInt(narrow_cast<uint32_t>(body.size()), &frame);
+  frame += body;
+
+  std::unique_ptr<CQLRequest> request;
+  std::unique_ptr<CQLResponse> error_response;
+  EXPECT_TRUE(CQLRequest::ParseRequest(
+      frame, CQLMessage::CompressionScheme::kNone, &request, &error_response));
+  if (!request) {
+    return nullptr;
+  }
+  return std::unique_ptr<QueryRequest>(down_cast<QueryRequest*>(request.release()));
+}
+
+RowsResult::SharedPtr MakeRowsResult(const std::string& rows_data) {
+  auto column_schemas = std::make_shared<std::vector<ColumnSchema>>();
+  column_schemas->emplace_back("k", DataType::INT32);
+  column_schemas->emplace_back("v", DataType::STRING);
+  return std::make_shared<RowsResult>(
+      client::YBTableName(YQL_DATABASE_CQL, "test_ks", "test_table"), column_schemas, rows_data);
+}
+
+// Rows data for a single (1, "one") row, in the format produced by tablets.
+std::string OneRowData() {
+  std::string result;
+  AppendInt(1, &result);  // rows_count
+  AppendInt(4, &result);
+  AppendInt(1, &result);
+  AppendInt(3, &result);
+  result += "one";
+  return result;
+}
+
+void CheckSerializeToBuffer(const RowsResultResponse& response) {
+  faststring expected;
+  response.Serialize(CQLMessage::CompressionScheme::kNone, &expected);
+  const auto buffer = response.SerializeToBuffer(CQLMessage::CompressionScheme::kNone);
+  ASSERT_EQ(Slice(expected.data(), expected.size()).ToDebugHexString(),
+            buffer.AsSlice().ToDebugHexString());
+}
+
+} // namespace
+
+class CQLMessageTest : public YBTest {
+};
+
+TEST_F(CQLMessageTest, RowsResultSerializeToBuffer) {
+  auto request = ParseQueryRequest(/* header_flags = */ 0, /* query_flags = */ 0);
+  ASSERT_NE(request, nullptr);
+  ASSERT_NO_FATALS(CheckSerializeToBuffer(RowsResultResponse(*request, MakeRowsResult(
+      OneRowData()))));
+}
+
+TEST_F(CQLMessageTest, RowsResultSerializeToBufferEmpty) {
+  auto request = ParseQueryRequest(/* header_flags = */ 0, /* query_flags = */ 0);
+  ASSERT_NE(request, nullptr);
+  ASSERT_NO_FATALS(CheckSerializeToBuffer(RowsResultResponse(*request, MakeRowsResult(
+      QLRowBlock::ZeroRowsData(YQL_CLIENT_CQL)))));
+}
+
+TEST_F(CQLMessageTest, RowsResultSerializeToBufferPaged) {
+  auto request = ParseQueryRequest(/* header_flags = */ 0, /* query_flags = */ 0);
+  ASSERT_NE(request, nullptr);
+  auto result = MakeRowsResult(OneRowData());
+  QLPagingStatePB paging_state;
+  paging_state.set_table_id("test_table_id");
+  paging_state.set_next_partition_key("next_partition_key");
+  paging_state.set_next_row_key("next_row_key");
+  paging_state.set_total_num_rows_read(1);
+  result->SetPagingState(paging_state);
+  ASSERT_NO_FATALS(CheckSerializeToBuffer(RowsResultResponse(*request, result)));
+}
+
+TEST_F(CQLMessageTest, RowsResultSerializeToBufferSkipMetadata) {
+  auto request = ParseQueryRequest(
+      /* header_flags = */ 0, CQLMessage::QueryParameters::kSkipMetadataFlag);
+  ASSERT_NE(request, nullptr);
+  ASSERT_NO_FATALS(CheckSerializeToBuffer(RowsResultResponse(*request, MakeRowsResult(
+      OneRowData()))));
+}
+
+// Response header carries the RPC queue position when the request has the metadata flag.
+TEST_F(CQLMessageTest, RowsResultSerializeToBufferHeaderMetadata) {
+  auto request = ParseQueryRequest(CQLMessage::kMetadataFlag, /* query_flags = */ 0);
+  ASSERT_NE(request, nullptr);
+  RowsResultResponse response(*request, MakeRowsResult(OneRowData()));
+  response.set_rpc_queue_position(7);
+  ASSERT_NO_FATALS(CheckSerializeToBuffer(response));
+}
+
+} // namespace ql
+} // namespace yb
@@ -1019,11 +1019,6 @@ void CQLResponse::Serialize(const CompressionScheme compression_scheme, faststri
   const size_t start_pos = mesg->size(); // save the start position
   const bool compress = (compression_scheme != CQLMessage::CompressionScheme::kNone);
   SerializeHeader(compress, mesg);
-  if (flags() & kMetadataFlag) {
-    uint8_t buffer[kMetadataSize] = {0};
-    SERIALIZE_SHORT(buffer, kMetadataQueuePosOffset, static_cast<uint16_t>(rpc_queue_position_));
-    mesg->append(buffer, sizeof(buffer));
-  }
   if (compress) {
     faststring body;
     SerializeBody(&body);
@@ -1062,6 +1057,12 @@ void CQLResponse::Serialize(const CompressionScheme compression_scheme, faststri
       mesg->data(), start_pos + kHeaderPosLength, mesg->size() - start_pos - kMessageHeaderLength);
 }
 
+RefCntBuffer CQLResponse::SerializeToBuffer(const CompressionScheme compression_scheme) const {
+  faststring mesg;
+  Serialize(compression_scheme, &mesg);
+  return RefCntBuffer(mesg);
+}
+
 void CQLResponse::SerializeHeader(const bool compress, faststring* mesg) const {
   uint8_t buffer[kMessageHeaderLength];
   SERIALIZE_BYTE(buffer, kHeaderPosVersion, version());
@@ -1070,6 +1071,11 @@ void CQLResponse::SerializeHeader(const bool compress, faststring* mesg) const {
   SERIALIZE_INT(buffer, kHeaderPosLength, 0);
   SERIALIZE_BYTE(buffer, kHeaderPosOpcode, opcode());
   mesg->append(buffer, sizeof(buffer));
+  if (flags() & kMetadataFlag) {
+    uint8_t metadata[kMetadataSize] = {0};
+    SERIALIZE_SHORT(metadata, kMetadataQueuePosOffset, static_cast<uint16_t>(rpc_queue_position_));
+    mesg->append(metadata, sizeof(metadata));
+  }
 }
 
 #undef SERIALIZE_BYTE
@@ -1606,16 +1612,46 @@ RowsResultResponse::~RowsResultResponse() {
 
 void RowsResultResponse::SerializeResultBody(faststring* mesg) const {
   // CQL ROWS Response = <metadata><rows_count><rows_content>
+  SerializeMetadata(mesg);
+  mesg->append(rows_data());
+}
+
+RefCntBuffer RowsResultResponse::SerializeToBuffer(
+    const CompressionScheme compression_scheme) const {
+  if (compression_scheme != CompressionScheme::kNone) {
+    return ResultResponse::SerializeToBuffer(compression_scheme);
+  }
+
+  // Rows data is already encoded in the CQL wire format by the tablets, so copy it to the response
+  // buffer only once, instead of appending it to the message and then copying the whole message.
+  faststring prefix;
+  SerializeHeader(/* compress = */ false, &prefix);
+  SerializeInt(static_cast<int32_t>(Kind::ROWS), &prefix);
+  SerializeMetadata(&prefix);
+
+  const auto& data = rows_data();
+  RefCntBuffer buffer(prefix.size() + data.size());
+  memcpy(buffer.udata(), prefix.data(), prefix.size());
+  memcpy(buffer.udata() + prefix.size(), data.data(), data.size());
+  NetworkByteOrder::Store32(
+      buffer.udata() + kHeaderPosLength,
+      static_cast<int32_t>(buffer.size() - kMessageHeaderLength));
+  return buffer;
+}
+
+void RowsResultResponse::SerializeMetadata(faststring* mesg) const {
   SerializeRowsMetadata(
       RowsMetadata(result_->table_name(), result_->column_schemas(),
                    result_->paging_state(), skip_metadata_), mesg);
+}
 
+const std::string& RowsResultResponse::rows_data() const {
   // The <rows_count> (4 bytes) must be in the response in any case, so the 'rows_data()'
   // string in the result must contain it.
   LOG_IF(DFATAL, result_->rows_data().size() < 4)
       << "Absent rows_count for the CQL ROWS Result Response (rows_data: "
       << result_->rows_data().size() << " bytes, expected >= 4)";
-  mesg->append(result_->rows_data());
+  return result_->rows_data();
 }
 
 //----------------------------------------------------------------------------------------
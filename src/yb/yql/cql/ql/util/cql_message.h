@@ -51,6 +51,7 @@
 #include "yb/util/status_fwd.h"
 #include "yb/util/memory/memory_usage.h"
 #include "yb/util/net/sockaddr.h"
+#include "yb/util/ref_cnt_buffer.h"
 #include "yb/util/slice.h"
 
 #include "yb/yql/cql/ql/util/statement_params.h"
@@ -526,6 +527,9 @@ class CQLResponse : public CQLMessage {
   virtual ~CQLResponse();
   virtual void Serialize(CompressionScheme compression_scheme, faststring* mesg) const;
 
+  // Serializes the response to a buffer that is sent to the client.
+  virtual RefCntBuffer SerializeToBuffer(CompressionScheme compression_scheme) const;
+
   Events registered_events() const { return registered_events_; }
   void set_registered_events(Events events) { registered_events_ = events; }
 
@@ -805,10 +809,15 @@ class RowsResultResponse : public ResultResponse {
 
   virtual ~RowsResultResponse() override;
 
+  RefCntBuffer SerializeToBuffer(CompressionScheme compression_scheme) const override;
+
  protected:
   virtual void SerializeResultBody(faststring* mesg) const override;
 
  private:
+  void SerializeMetadata(faststring* mesg) const;
+  const std::string& rows_data() const;
+
   const ql::RowsResult::SharedPtr result_;
   const bool skip_metadata_;
 };
@@ -48,6 +48,7 @@
 #include "yb/util/flag_tags.h"
 #include "yb/util/format.h"
 #include "yb/util/result.h"
+#include "yb/util/scope_exit.h"
 #include "yb/util/shared_mem.h"
 #include "yb/util/status_format.h"
 #include "yb/util/string_util.h"
@@ -467,6 +468,11 @@ void PgSession::InvalidateAllTablesCache() {
 
 Status PgSession::StartOperationsBuffering() {
   SCHECK(!buffering_enabled_, IllegalState, "Buffering has been already started");
+  if (holding_buffered_operations_) {
+    // Transaction continues after the statement whose operations were held.
+    holding_buffered_operations_ = false;
+    RETURN_NOT_OK(buffer_.Flush());
+  }
   if (PREDICT_FALSE(!Empty(buffer_))) {
     LOG(DFATAL) << "Buffering hasn't been started yet but "
                 << buffer_.Size()
@@ -480,6 +486,11 @@ Status PgSession::StartOperationsBuffering() {
 Status PgSession::StopOperationsBuffering() {
   SCHECK(buffering_enabled_, IllegalState, "Buffering hasn't been started");
   buffering_enabled_ = false;
+  if (hold_buffered_operations_requested_) {
+    hold_buffered_operations_requested_ = false;
+    holding_buffered_operations_ = true;
+    return Status::OK();
+  }
   return FlushBufferedOperations();
 }
 
@@ -489,10 +500,25 @@ void PgSession::ResetOperationsBuffering() {
 }
 
 Status PgSession::FlushBufferedOperations() {
+  if (!holding_buffered_operations_) {
+    return buffer_.Flush();
+  }
+  // End of the statement executed as a whole transaction, so held operations are the last ones of
+  // the transaction.
+  holding_buffered_operations_ = false;
+  flushing_last_txn_operations_ = true;
+  auto se = ScopeExit([this] { flushing_last_txn_operations_ = false; });
   return buffer_.Flush();
 }
 
+void PgSession::HoldBufferedOperationsUntilStatementEnd() {
+  hold_buffered_operations_requested_ =
+      FLAGS_ysql_enable_single_tablet_txn_fast_path || FLAGS_ysql_enable_parallel_commit;
+}
+
 void PgSession::DropBufferedOperations() {
+  hold_buffered_operations_requested_ = false;
+  holding_buffered_operations_ = false;
   buffer_.Clear();
 }
 
@@ -523,11 +549,14 @@ Result<PerformFuture> PgSession::FlushOperations(BufferableOperations ops, bool
         false /* read_only */, txn_priority_requirement, &in_txn_limit));
   }
 
-  return Perform(std::move(ops), UseCatalogSession::kFalse);
+  return Perform(
+      std::move(ops), UseCatalogSession::kFalse,
+      LastTxnOperations(transactional && flushing_last_txn_operations_));
 }
 
 Result<PerformFuture> PgSession::Perform(
-    BufferableOperations ops, UseCatalogSession use_catalog_session) {
+    BufferableOperations ops, UseCatalogSession use_catalog_session,
+    LastTxnOperations last_txn_operations) {
   DCHECK(!ops.empty());
   tserver::PgPerformOptionsPB options;
 
@@ -542,6 +571,10 @@ Result<PerformFuture> PgSession::Perform(
     options.set_use_catalog_session(true);
   } else {
     pg_txn_manager_->SetupPerformOptions(&options);
+    if (last_txn_operations) {
+      options.set_single_tablet_fast_path(FLAGS_ysql_enable_single_tablet_txn_fast_path);
+      options.set_parallel_commit(FLAGS_ysql_enable_parallel_commit);
+    }
   }
   bool global_transaction = yb_force_global_transaction;
   for (auto i = ops.operations.begin(); !global_transaction && i != ops.operations.end(); ++i) {
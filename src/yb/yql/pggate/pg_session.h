@@ -51,6 +51,7 @@ namespace pggate {
 YB_STRONGLY_TYPED_BOOL(OpBuffered);
 YB_STRONGLY_TYPED_BOOL(InvalidateOnPgClient);
 YB_STRONGLY_TYPED_BOOL(UseCatalogSession);
+YB_STRONGLY_TYPED_BOOL(LastTxnOperations);
 
 class PgTxnManager;
 class PgSession;
@@ -199,7 +200,14 @@ class PgSession : public RefCountedThreadSafe<PgSession> {
   void ResetOperationsBuffering();
 
   // Flush all pending buffered operations. Buffering mode remain unchanged.
+  // Operations held until the end of the statement are the last writes of the transaction, so
+  // tserver may apply them without distributed transaction in case nothing else was performed in
+  // it and all of them target one tablet, or seal the transaction in parallel with them.
   Status FlushBufferedOperations();
+  // Keep operations buffered by the current statement when buffering is stopped, so they are
+  // flushed together at the end of the statement. Used for a statement executed as a whole
+  // transaction.
+  void HoldBufferedOperationsUntilStatementEnd();
   // Drop all pending buffered operations. Buffering mode remain unchanged.
   void DropBufferedOperations();
 
@@ -326,7 +334,8 @@ class PgSession : public RefCountedThreadSafe<PgSession> {
   class RunHelper;
 
   Result<PerformFuture> Perform(
-      BufferableOperations ops, UseCatalogSession use_catalog_session);
+      BufferableOperations ops, UseCatalogSession use_catalog_session,
+      LastTxnOperations last_txn_operations = LastTxnOperations::kFalse);
 
   PgClient& pg_client_;
 
@@ -354,6 +363,9 @@ class PgSession : public RefCountedThreadSafe<PgSession> {
 
   // Should write operations be buffered?
   bool buffering_enabled_ = false;
+  bool flushing_last_txn_operations_ = false;
+  bool hold_buffered_operations_requested_ = false;
+  bool holding_buffered_operations_ = false;
   BufferingSettings buffering_settings_;
   PgOperationBuffer buffer_;
 
@@ -1207,6 +1207,10 @@ Status PgApiImpl::FlushBufferedOperations() {
   return pg_session_->FlushBufferedOperations();
 }
 
+void PgApiImpl::HoldBufferedOperationsUntilStatementEnd() {
+  pg_session_->HoldBufferedOperationsUntilStatementEnd();
+}
+
 Status PgApiImpl::DmlExecWriteOp(PgStatement *handle, int32_t *rows_affected_count) {
   switch (handle->stmt_op()) {
     case StmtOp::STMT_INSERT:
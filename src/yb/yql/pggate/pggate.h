@@ -438,6 +438,7 @@ class PgApiImpl {
   Status StopOperationsBuffering();
   void ResetOperationsBuffering();
   Status FlushBufferedOperations();
+  void HoldBufferedOperationsUntilStatementEnd();
 
   //------------------------------------------------------------------------------------------------
   // Insert.
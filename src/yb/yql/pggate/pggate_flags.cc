@@ -58,6 +58,20 @@ DEFINE_uint64(ysql_session_max_batch_size, 512,
 DEFINE_bool(ysql_non_txn_copy, false,
             "Execute COPY inserts non-transactionally.");
 
+DEFINE_bool(ysql_enable_single_tablet_txn_fast_path, false,
+            "Flush writes of a statement executed as a whole transaction together at the end of "
+            "the statement. If all of them target the same tablet, they are applied without a "
+            "distributed transaction, directly to the regular DB in a single Raft operation.");
+TAG_FLAG(ysql_enable_single_tablet_txn_fast_path, advanced);
+
+DEFINE_bool(ysql_enable_parallel_commit, false,
+            "Flush writes of a statement executed as a whole transaction together at the end of "
+            "the statement and seal the transaction in parallel with them. Transaction is "
+            "committed as soon as all of its writes are replicated, without waiting for a separate "
+            "commit record. "
+            "Requires enable_transaction_sealing on tablet servers.");
+TAG_FLAG(ysql_enable_parallel_commit, advanced);
+
 DEFINE_int32(ysql_max_read_restart_attempts, 20,
              "How many read restarts can we try transparently before giving up");
 
@@ -44,6 +44,8 @@ DECLARE_bool(ysql_serializable_isolation_for_ddl_txn);
 DECLARE_int32(ysql_max_write_restart_attempts);
 DECLARE_bool(ysql_sleep_before_retry_on_txn_conflict);
 DECLARE_bool(ysql_disable_portal_run_context);
+DECLARE_bool(ysql_enable_single_tablet_txn_fast_path);
+DECLARE_bool(ysql_enable_parallel_commit);
 DECLARE_bool(TEST_yb_lwlock_crash_after_acquire_pg_stat_statements_reset);
 
 #endif  // YB_YQL_PGGATE_PGGATE_FLAGS_H
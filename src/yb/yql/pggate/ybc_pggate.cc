@@ -674,6 +674,10 @@ YBCStatus YBCPgFlushBufferedOperations() {
   return ToYBCStatus(pgapi->FlushBufferedOperations());
 }
 
+void YBCPgHoldBufferedOperationsUntilStatementEnd() {
+  pgapi->HoldBufferedOperationsUntilStatementEnd();
+}
+
 YBCStatus YBCPgDmlExecWriteOp(YBCPgStatement handle, int32_t *rows_affected_count) {
   return ToYBCStatus(pgapi->DmlExecWriteOp(handle, rows_affected_count));
 }
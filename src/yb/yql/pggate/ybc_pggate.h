@@ -388,6 +388,10 @@ YBCStatus YBCPgStartOperationsBuffering();
 YBCStatus YBCPgStopOperationsBuffering();
 void YBCPgResetOperationsBuffering();
 YBCStatus YBCPgFlushBufferedOperations();
+// Keep operations buffered by the current statement until the end of the statement, where they are
+// flushed as the last writes of the transaction. Should be used only for a statement executed as a
+// whole transaction.
+void YBCPgHoldBufferedOperationsUntilStatementEnd();
 
 YBCStatus YBCPgNewSample(const YBCPgOid database_oid,
                          const YBCPgOid table_oid,
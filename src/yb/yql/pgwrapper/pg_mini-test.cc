@@ -56,9 +56,11 @@
 
 using namespace std::literals;
 
+DECLARE_bool(TEST_fail_pg_regular_commit);
 DECLARE_bool(TEST_force_master_leader_resolution);
 DECLARE_bool(TEST_timeout_non_leader_master_rpcs);
 DECLARE_bool(enable_automatic_tablet_splitting);
+DECLARE_bool(enable_transaction_sealing);
 DECLARE_bool(flush_rocksdb_on_shutdown);
 DECLARE_bool(rocksdb_use_logging_iterator);
 
@@ -1858,6 +1860,79 @@ TEST_F(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(DDLWithRestart)) {
   ASSERT_EQ(res, 0);
 }
 
+class PgMiniSingleTabletTxnFastPathTest : public PgMiniTest {
+ protected:
+  void SetUp() override {
+    FLAGS_ysql_enable_single_tablet_txn_fast_path = true;
+    PgMiniTest::SetUp();
+  }
+};
+
+TEST_F_EX(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(SingleTabletTxnFastPath),
+          PgMiniSingleTabletTxnFastPathTest) {
+  // Keep intents of applied transactions, so it is visible whether distributed transaction was
+  // used.
+  SetAtomicFlag(1.0, &FLAGS_TEST_transaction_ignore_applying_probability);
+
+  auto conn = ASSERT_RESULT(Connect());
+  ASSERT_OK(conn.Execute("CREATE TABLE t (key INT PRIMARY KEY, value INT) SPLIT INTO 1 TABLETS"));
+  ASSERT_OK(conn.Execute(
+      "CREATE TABLE t2 (key INT PRIMARY KEY, value INT) SPLIT INTO 2 TABLETS"));
+
+  // Statement applied without distributed transaction does not commit anything.
+  FLAGS_TEST_fail_pg_regular_commit = true;
+  ASSERT_OK(conn.Execute("INSERT INTO t VALUES (1, 1), (2, 2), (3, 3)"));
+  ASSERT_EQ(CountIntents(cluster_.get()), 0);
+
+  // Failed row should prevent other rows of the same statement from being written. The error is
+  // reported by the statement itself, with the SQLSTATE of the failed row.
+  auto status = conn.Execute("INSERT INTO t VALUES (4, 4), (1, 1)");
+  ASSERT_EQ(PgsqlError(status), YBPgErrorCode::YB_PG_UNIQUE_VIOLATION) << status;
+  ASSERT_STR_CONTAINS(
+      status.ToString(), "duplicate key value violates unique constraint \"t_pkey\"");
+  ASSERT_EQ(CountIntents(cluster_.get()), 0);
+  auto sum = ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT SUM(value) FROM t"));
+  ASSERT_EQ(sum, 6);
+
+  // Writes to several tablets still require distributed transaction.
+  FLAGS_TEST_fail_pg_regular_commit = false;
+  ASSERT_OK(conn.Execute("INSERT INTO t2 SELECT i, i FROM generate_series(1, 20) AS i"));
+  ASSERT_GT(CountIntents(cluster_.get()), 0);
+  sum = ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT SUM(value) FROM t2"));
+  ASSERT_EQ(sum, 210);
+}
+
+class PgMiniParallelCommitTest : public PgMiniTest {
+ protected:
+  void SetUp() override {
+    FLAGS_enable_transaction_sealing = true;
+    FLAGS_ysql_enable_parallel_commit = true;
+    PgMiniTest::SetUp();
+  }
+};
+
+TEST_F_EX(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(ParallelCommit), PgMiniParallelCommitTest) {
+  constexpr int kRows = 100;
+
+  auto conn = ASSERT_RESULT(Connect());
+  ASSERT_OK(conn.Execute("CREATE TABLE t (key INT PRIMARY KEY, value INT) SPLIT INTO 3 TABLETS"));
+
+  // Statements should succeed only if their transactions were sealed.
+  FLAGS_TEST_fail_pg_regular_commit = true;
+  ASSERT_OK(conn.ExecuteFormat(
+      "INSERT INTO t SELECT i, i FROM generate_series(1, $0) AS i", kRows));
+  ASSERT_OK(conn.Execute("UPDATE t SET value = value + 1"));
+  auto sum = ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT SUM(value) FROM t"));
+  ASSERT_EQ(sum, kRows * (kRows + 1) / 2 + kRows);
+
+  // Sealed transaction with failed row should not be committed.
+  auto status = conn.ExecuteFormat(
+      "INSERT INTO t SELECT i, i FROM generate_series($0, $1) AS i", kRows, kRows * 2);
+  ASSERT_EQ(PgsqlError(status), YBPgErrorCode::YB_PG_UNIQUE_VIOLATION) << status;
+  auto count = ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT COUNT(*) FROM t"));
+  ASSERT_EQ(count, kRows);
+}
+
 class PgMiniRocksDbIteratorLoggingTest : public PgMiniSingleTServerTest {
  public:
   struct IteratorLoggingTestConfig {
@@ -3660,6 +3660,41 @@ TEST_F(TestRedisService, TestZRevRange) {
   VerifyCallbacks();
 }
 
+TEST_F(TestRedisService, TestZRangeFromEnd) {
+  // Ranks close to the end of the set are read backwards from the last member, check that removed,
+  // updated and overwritten members are handled the same way as when reading from the start.
+  FLAGS_emulate_redis_responses = true;
+  std::vector<std::string> zadd = {"ZADD", "z_key"};
+  for (int i = 0; i < 100; ++i) {
+    zadd.push_back(std::to_string(i));
+    zadd.push_back("m" + std::to_string(i));
+  }
+  DoRedisTestInt(__LINE__, zadd, 100);
+  SyncClient();
+  DoRedisTestInt(__LINE__, {"ZREM", "z_key", "m99", "m97"}, 2);
+  DoRedisTestInt(__LINE__, {"ZADD", "z_key", "1000", "m0"}, 0);
+  SyncClient();
+
+  DoRedisTestArray(__LINE__, {"ZREVRANGE", "z_key", "0", "2"}, {"m0", "m98", "m96"});
+  DoRedisTestScoreValueArray(__LINE__, {"ZREVRANGE", "z_key", "0", "2", "WITHSCORES"},
+                             {1000, 98, 96}, {"m0", "m98", "m96"});
+  DoRedisTestArray(__LINE__, {"ZRANGE", "z_key", "-3", "-1"}, {"m96", "m98", "m0"});
+  DoRedisTestArray(__LINE__, {"ZRANGE", "z_key", "95", "100"}, {"m96", "m98", "m0"});
+  DoRedisTestArray(__LINE__, {"ZREVRANGE", "z_key", "96", "97"}, {"m2", "m1"});
+  DoRedisTestArray(__LINE__, {"ZRANGE", "z_key", "1", "2"}, {"m2", "m3"});
+  SyncClient();
+
+  DoRedisTestInt(__LINE__, {"DEL", "z_key"}, 1);
+  SyncClient();
+  DoRedisTestInt(__LINE__, {"ZADD", "z_key", "1", "a", "2", "b"}, 2);
+  SyncClient();
+  DoRedisTestArray(__LINE__, {"ZREVRANGE", "z_key", "0", "0"}, {"b"});
+  DoRedisTestArray(__LINE__, {"ZRANGE", "z_key", "-2", "-1"}, {"a", "b"});
+
+  SyncClient();
+  VerifyCallbacks();
+}
+
 TEST_F(TestRedisService, TestZRange) {
   // The default value is true, but we explicitly set this here for clarity.
   FLAGS_emulate_redis_responses = true;